@@ -23,6 +23,7 @@
 #define GUICPP_H_
 
 #include "guicpp/guicpp_macros.h"
+#include "guicpp/guicpp_multibinder.h"
 #include "guicpp/guicpp_strings.h"
 
 #endif  // GUICPP_H_
@@ -0,0 +1,228 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// This file defines asynchronous providers.
+//
+// Use Case:
+//  Some providers are slow because they are I/O bound, for example an
+//  EmailSender provider that opens a connection to the mail server or a
+//  provider that loads a file. With AbstractProvider the whole wait happens
+//  inside Get(), one provider after the other, and the total startup latency
+//  is the sum of all of them.
+//
+//  An asynchronous provider splits the work in two phases:
+//    Start() : kicks off the slow work (e.g. sends the connect request) and
+//              returns without waiting for it to complete.
+//    Get()   : waits for the work started by Start() to complete and returns
+//              the instance.
+//
+//  Guic++ calls Start() of all asynchronous providers while the injector is
+//  being created (in guicpp::CreateInjector()), before any Get(). Hence the
+//  slow work of independent providers overlaps and the startup latency is
+//  close to that of the slowest provider.
+//
+//  Only the Start() phase overlaps, and only for independent providers;
+//  Guic++ does not track dependencies between asynchronous providers and
+//  never delays a Start() until the instances it would need are ready. A
+//  provider whose slow work needs another instance must do that work in
+//  Get(), which runs after the Get() of its arguments (and hence after their
+//  Start()) on the thread requesting the instance.
+//
+// Usage:
+//  1. Implement the provider by inheriting from
+//     AbstractAsyncProvider<prototype-of-get>. The prototype is same as that
+//     of AbstractProvider (see provider.h). Arguments of Get() are injected
+//     as usual and hence Get() can depend on other instances; Start() can
+//     not take any arguments and must not get instances from the injector.
+//
+//     Example:
+//      class EmailSenderProvider:
+//            public guicpp::AbstractAsyncProvider<EmailSender* ()> {
+//       public:
+//        void Start() {
+//          connection_ = MailConnection::ConnectAsync(kMailServer);
+//        }
+//
+//        EmailSender* Get() {
+//          return new EmailSender(connection_->WaitForConnect());
+//        }
+//
+//       private:
+//        MailConnection* connection_;
+//      };
+//
+//  2. Bind the type to provider using Binder::BindToAsyncProvider()
+//
+//        binder->BindToAsyncProvider<EmailSender>(
+//            new EmailSenderProvider(), guicpp::DeletePointer());
+//
+//     Note: guicpp::CreateInjector() must be used to create the injector.
+//
+//  3. Optionally, bind an executor with label guicpp::AsyncStartExecutor
+//     (see executor.h). If bound, Start() methods are scheduled on this
+//     executor instead of being called on the thread that creates the
+//     injector. Start() may then do blocking work. Guic++ makes Get() wait
+//     for Start() to complete, or call Start() itself if the executor has not
+//     run it yet; Hence Get() sees everything done by Start().
+//
+//        binder->BindToInstance<
+//            guicpp::At<guicpp::AsyncStartExecutor, guicpp::Executor> >(
+//                executor, guicpp::DoNothing());
+//
+//     The injector may be deleted before the executor runs the scheduled
+//     closures; Such closures do nothing. Deleting the injector waits for a
+//     Start() that is running on the executor. The executor must outlive the
+//     closures scheduled on it.
+//
+// Implementation Detail:
+//   AbstractAsyncProvider is a regular provider that is also added to the
+//   init list of ScopeSetupContext (the same list used by LazySingleton).
+//   ScopeSetupContext::Init() calls Init() of all the entries in the list
+//   in order of binding, and Init() of an asynchronous provider calls
+//   Start() or schedules it on the executor. Start() is guarded by a once
+//   flag, which the binding (AsyncProviderEntry) also goes through before
+//   each Get().
+
+#ifndef GUICPP_ASYNC_PROVIDER_H_
+#define GUICPP_ASYNC_PROVIDER_H_
+
+#include "guicpp/internal/guicpp_port.h"
+#include "guicpp/guicpp_executor.h"
+#include "guicpp/guicpp_provider.h"
+#include "guicpp/guicpp_singleton.h"
+
+namespace guicpp {
+namespace internal {
+template <typename R, typename ProviderType, typename CleanupAction>
+class AsyncProviderEntry;
+}
+
+// Provider whose Start() method is called when injector is created. See
+// AbstractProvider for the meaning of template argument T.
+template <typename T>
+class AbstractAsyncProvider: public AbstractProvider<T>,
+                             public internal::SetupInterface {
+ public:
+  virtual ~AbstractAsyncProvider() {}
+
+  // Starts the work required by Get(). This is called exactly once, either
+  // when the injector is created, on the executor bound with label
+  // AsyncStartExecutor, or by the first Get() that finds it not yet called.
+  // It must not wait for the work to complete unless it runs on the executor.
+  virtual void Start() = 0;
+
+ protected:
+  AbstractAsyncProvider(): start_state_(NULL) {}
+
+ private:
+  // State shared by the provider and the closure scheduled on the executor,
+  // deleted by the last of the two to release it. The provider detaches
+  // itself in Cleanup(), hence a closure run after the injector is deleted
+  // does nothing.
+  struct StartState {
+    explicit StartState(AbstractAsyncProvider* provider)
+        : provider(provider), num_refs(2) {}
+
+    internal::Mutex mu;
+    AbstractAsyncProvider* provider;  // NULL once detached; Guarded by mu.
+    int num_refs;  // Guarded by mu.
+  };
+
+  // Closure that calls provider->Start(), used to run Start() on executor.
+  class StartClosure: public Closure {
+   public:
+    explicit StartClosure(StartState* state): state_(state) {}
+
+    // The reference is released here rather than in Run(), so that it is
+    // released even if the executor deletes the closure without running it.
+    ~StartClosure() {
+      AbstractAsyncProvider::ReleaseStartState(state_);
+    }
+
+    // Holds the lock while Start() runs, hence Cleanup() waits for it.
+    void Run() {
+      internal::MutexLock lock(&state_->mu);
+      if (state_->provider != NULL) {
+        state_->provider->WaitForStart();
+      }
+    }
+
+   private:
+    StartState* const state_;
+  };
+
+  // Calls Start() unless it is already called, or waits for it to complete if
+  // another thread is calling it. Start() happens before the return of this.
+  void WaitForStart() {
+    start_once_.Init(&AbstractAsyncProvider::CallStart, this);
+  }
+
+  static void CallStart(AbstractAsyncProvider* provider) {
+    provider->Start();
+  }
+
+  // Releases a reference of "state" and deletes it if it is the last one.
+  static void ReleaseStartState(StartState* state) {
+    bool is_last;
+    {
+      internal::MutexLock lock(&state->mu);
+      is_last = (--state->num_refs == 0);
+    }
+
+    if (is_last) {
+      delete state;
+    }
+  }
+
+  // Called from ScopeSetupContext::Init().
+  virtual void Init(const Injector* injector) {
+    Executor* executor =
+        internal::FindBoundExecutor<AsyncStartExecutor>(injector);
+
+    if (executor == NULL) {
+      WaitForStart();
+      return;
+    }
+
+    // Cleanup() detaches the closure when the injector is deleted.
+    start_state_ = new StartState(this);
+    injector->Get<internal::ScopeSetupContext*>()->AddToCleanupList(this);
+    executor->Schedule(new StartClosure(start_state_));
+  }
+
+  // Called when the injector is deleted, only if Start() was scheduled on the
+  // executor. Waits for a running Start() to complete. Provider itself is
+  // deleted using cleanup action passed to BindToAsyncProvider().
+  virtual void Cleanup() {
+    {
+      internal::MutexLock lock(&start_state_->mu);
+      start_state_->provider = NULL;
+    }
+
+    ReleaseStartState(start_state_);
+    start_state_ = NULL;
+  }
+
+  // Calls WaitForStart() before each Get().
+  template <typename R, typename ProviderType, typename CleanupAction>
+  friend class internal::AsyncProviderEntry;
+
+  GoogleOnceDynamic start_once_;
+  StartState* start_state_;
+};
+
+}  // namespace guicpp
+
+#endif  // GUICPP_ASYNC_PROVIDER_H_
@@ -129,21 +129,6 @@ class NoArg {
   GUICPP_DISALLOW_IMPLICIT_CONSTRUCTORS_(NoArg);
 };
 
-// Annotation entry baseclass
-template <typename Type>
-class AtEntryBase { };
-
-// Annotation entry
-template <typename Lookup, typename Type, typename Value>
-class AtEntry: public AtEntryBase<Type> { };
-
-// If Lookup type is same as annotation type, define Value
-template <typename Lookup, typename Value>
-class AtEntry<Lookup, Lookup, Value>: public AtEntryBase<Lookup> {
- public:
-  typedef Value type;
-};
-
 // Invalid annotation, used when less than max annotations are specified.
 // Templated with int to make unique types.
 template <int I>
@@ -155,16 +140,30 @@ class InvalidAt {
 template <typename A1 = InvalidAt<1>, typename A2 = InvalidAt<2> >
 class Annotations {
  public:
-  // Entries is a class inherited from AtEntry corresponding to each specified
-  // annotation. If user has specified an annotation of type B and if Lookup is
-  // B, corresponding base class defines a typedef called "type" which is an
-  // alias of specfied annotation and that can be referred as Entries<B>::type.
-  // However, we need to ensure an annotation of a type B is specified by user
-  // before trying to refer "Entries<B>::type".
-  template <typename Lookup>
-  class Entries:
-    public AtEntry<Lookup, typename A1::AnnotationType, A1>,
-    public AtEntry<Lookup, typename A2::AnnotationType, A2> {};
+  // Select<Lookup, Default>::type is the specified annotation whose
+  // annotation-base-class is Lookup, or Default if no such annotation is
+  // specified. The annotation is picked by partial specialization on the
+  // annotation-base-classes (T1, T2) of the annotations, hence a lookup
+  // instantiates a single class whatever the number of annotations.
+  template <typename Lookup, typename Default,
+            typename T1 = typename A1::AnnotationType,
+            typename T2 = typename A2::AnnotationType>
+  class Select {
+   public:
+    typedef Default type;
+  };
+
+  template <typename Lookup, typename Default, typename T2>
+  class Select<Lookup, Default, Lookup, T2> {
+   public:
+    typedef A1 type;
+  };
+
+  template <typename Lookup, typename Default, typename T1>
+  class Select<Lookup, Default, T1, Lookup> {
+   public:
+    typedef A2 type;
+  };
 };
 
 }  // namespace internal
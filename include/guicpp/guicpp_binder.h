@@ -31,11 +31,12 @@
 #include "guicpp/internal/guicpp_util.h"
 
 namespace guicpp {
-class LazySingleton;
+class DeferredModule;
 class Module;
 
 namespace internal {
-class GuicppTestScope;  // This scope is used only for testing.
+class ScopeProviderBase;
+class SetupInterface;
 }  // namespace internal
 
 // Binder class provides the APIs to populate bind_table.
@@ -90,6 +91,24 @@ class Binder {
   void BindToInstance(typename internal::AtUtil::GetTypes<T>::ArgType* ptr,
                       CleanupAction cleanup_action);
 
+  // Similar to BindToInstance(), but the bound instance can be replaced
+  // after the injector is created, using the returned handle (see
+  // swappable_instance.h). The handle is owned by the injector. Binds
+  // SwappableRef<T>, not T*, so that users keep the instance alive.
+  //
+  // Usage:
+  //   SwappableInstance<T>* handle =
+  //       binder->BindToSwappableInstance<T>(ptr, cleanup_action);
+  //
+  // @param cleanup_action is the action taken on "ptr", and on the instances
+  //        passed to SwappableInstance::Swap(), once they are replaced (or
+  //        the injector is deleted) and the last SwappableRef is dropped.
+  template <typename T, typename CleanupAction>
+  SwappableInstance<typename internal::AtUtil::GetTypes<T>::ArgType>*
+      BindToSwappableInstance(
+          typename internal::AtUtil::GetTypes<T>::ArgType* ptr,
+          CleanupAction cleanup_action);
+
   // Binds T to value.
   // Usage:
   //   binder->BindToValue<Type>(value);
@@ -144,11 +163,98 @@ class Binder {
   void BindValueToProvider(ProviderType* provider,
                            CleanupAction cleanup_action);
 
+  // Similar to BindToProvider, used with asynchronous providers. Start()
+  // method of the provider is called when the injector is created, so that
+  // the slow work of all asynchronous providers overlaps. See
+  // async_provider.h for details.
+  //
+  // Usage:
+  //   binder->BindToAsyncProvider<T>(pointer-to-provider, cleanup_action);
+  //
+  // @param provider: is a pointer to the provider implemented by user by
+  //        inheriting from guicpp::AbstractAsyncProvider<prototype-of-get>
+  //
+  // @param cleanup_action same as BindToProvider.
+  //
+  // Note: guicpp::CreateInjector() must be used to create the injector.
+  template <typename T, typename ProviderType, typename CleanupAction>
+  void BindToAsyncProvider(ProviderType* provider,
+                           CleanupAction cleanup_action);
+
+  // Adds "Implementation" to the set of "T". Unlike Bind(), this can be
+  // called any number of times for the same "T" to register several
+  // implementations (e.g. plugins) under one type. Both "T" and
+  // "Implementation" may be annotated.
+  //
+  // The set is injected as a vector of pointers (include multibinder.h):
+  //   GUICPP_INJECT_CTOR(NotifierRegistry, (
+  //       const std::vector<Notifier*>& notifiers));
+  //
+  // Usage:
+  //   binder->AddToSet<Notifier, SmsNotifier>();
+  //   binder->AddToSet<Notifier, EmailNotifier>();
+  //
+  // The instances are created once, on the first request of the set, in the
+  // order they are added, and are stored contiguously. If "Implementation"
+  // has a binding of its own, the instance is obtained through that binding.
+  // If that binding is to an instance, or to a scope whose instances are
+  // stable (see Decorate()), possibly through Bind(), the binding keeps the
+  // ownership. Otherwise (e.g. "Implementation" is not bound, or is bound to
+  // a type or a provider creating new instances) the instance is owned by
+  // the injector.
+  template <typename T, typename Implementation>
+  void AddToSet();
+
+  // Similar to AddToSet(), but associates "Implementation" with "key". The
+  // map is injected as a std::map<K, T*>. It is an error to add two
+  // implementations with the same key.
+  //
+  // Usage:
+  //   binder->AddToMap<string, Notifier, SmsNotifier>("sms");
+  //   binder->AddToMap<string, Notifier, EmailNotifier>("email");
+  template <typename K, typename T, typename Implementation>
+  void AddToMap(const K& key);
+
+  // Wraps the instances of "Interface" in a new instance of "Decorator"
+  // (e.g. a caching or metering layer), without changing the binding of
+  // "Interface". "Interface" may be annotated and must be bound explicitly
+  // (the binding can be in any module). "Decorator" must be convertible to
+  // "Interface" and receives the decorated instance as the constructor
+  // argument of type At<Assisted, Interface*>:
+  //
+  //   GUICPP_INJECT_CTOR(MeteredNotifier,
+  //                      (At<Assisted, Notifier*> notifier, Meter* meter));
+  //
+  // Usage:
+  //   binder->Decorate<Notifier, MeteredNotifier>();
+  //
+  // Decorators stack in order of Decorate() calls: The first decorator wraps
+  // the bound instance, the next one wraps the first decorator and so on.
+  // The chain is resolved once, when the injector is created; Requesting a
+  // decorated type looks up the outermost decorator directly.
+  //
+  // If "Interface" is bound to an instance, or to a scope whose instances
+  // are owned by the scope and never replaced (LazySingleton and the scopes
+  // built on it, PerNumaNodeSingleton), directly or through Bind(), the
+  // decorator is created once per decorated instance and owned by the
+  // injector. Otherwise a new decorator is created on every request of
+  // "Interface", owned by the caller; It owns the decorated instance only if
+  // the binding of "Interface" gives the ownership to the caller (e.g. it is
+  // not scoped). In any case, the decorator must not delete an instance
+  // that is not owned by the caller, even in its destructor.
+  template <typename Interface, typename Decorator>
+  void Decorate();
+
   // Binds a scope to type T.
   // Usage:
   //   binder->BindToScope<T, ScopeName>();
   //
-  // Currently only LazySingleton is supported and hence the usage is:
+  // Guic++ provides LazySingleton, ProcessLifetimeSingleton (see
+  // singleton.h), RefreshingSingleton (see refreshing_singleton.h),
+  // Prototype (see prototype.h), PerNumaNodeSingleton (see
+  // per_numa_node_singleton.h) and WarmUpSingleton (see
+  // warm_up_singleton.h); Custom scopes can be implemented as described in
+  // scope.h. For example:
   //   binder->BindToScope<T, guicpp::LazySingleton>();
   //
   // T may be annotated with labels.
@@ -159,6 +265,36 @@ class Binder {
   template <typename T, typename Scope>
   void BindToScope();
 
+  // Binds "T" to the provider of a custom scope. This is meant to be called
+  // from ConfigureScope() of the scope; See scope.h for details.
+  //
+  // Usage:
+  //   binder->BindToScopeProvider<T>(pointer-to-provider);
+  //
+  // @param provider: is a pointer to the provider implemented by inheriting
+  //        from guicpp::AbstractScopeProvider<T>. The provider is owned by
+  //        the injector.
+  //
+  // Note: guicpp::CreateInjector() must be used to create the injector.
+  template <typename T, typename ProviderType>
+  void BindToScopeProvider(ProviderType* provider);
+
+  // Same as BindToScopeProvider(), for the providers inheriting from
+  // guicpp::AbstractScopeProvider<T, R> whose Get() returns a value R
+  // (e.g. a ref-counted handle) instead of T*. Binds R.
+  //
+  // Usage:
+  //   binder->BindValueToScopeProvider<R>(pointer-to-provider);
+  template <typename T, typename ProviderType>
+  void BindValueToScopeProvider(ProviderType* provider);
+
+  // Returns true if "T" (which may be annotated) is already bound, by this
+  // module or by a module installed earlier. Meant for the bindings that are
+  // shared by all the types bound to a scope, such as SingletonRefresher of
+  // RefreshingSingleton (see refreshing_singleton.h).
+  template <typename T>
+  bool IsBound() const;
+
   // Registers a function/functor to be called at the time of cleanup.
   // function/functor should take no arguments.
   // Cleanup actions are called in reverse order of binding.
@@ -174,7 +310,31 @@ class Binder {
   // The ownership of the other module lies with the caller.
   void Install(const Module* module);
 
+  // Install a module whose Configure() is called only when one of the types
+  // declared by its DeclareKeys() is first requested. See deferred_module.h.
+  //
+  // Usage:
+  //   binder->InstallDeferred(pointer_to_deferredmodule);
+  //
+  // The ownership of the module lies with the caller, it must outlive the
+  // injector.
+  void InstallDeferred(const DeferredModule* module);
+
+  // Counts the number of times each binding is looked up, so that
+  // Injector::UsageReport() can list the bindings that are never used and
+  // the ones used most, along with the bytes of their entries. Counting
+  // costs one relaxed atomic increment per lookup and can be enabled in
+  // production, for example only in a canary module. Call this before the
+  // bindings; The bytes of the entries bound earlier are not known.
+  //
+  // Usage:
+  //   binder->EnableUsageCounters();
+  void EnableUsageCounters();
+
  private:
+  // Calls Configure() of the deferred module, defined in binder.cc.
+  class DeferredModuleInstaller;
+
   // Binder is never created directly.
   // Binder does not own bind_table.
   explicit Binder(internal::BindTable* bind_table);
@@ -187,10 +347,10 @@ class Binder {
   // users (a public method). But this is not in its final version hence keeping
   // it private to avoid abuses.
   //
-  // LazySingleton singleton needs to use it and hence making it a friend.
+  // Scopes do not use it; They bind to their providers using
+  // BindToScopeProvider(), see scope.h.
   template <typename T>
   typename internal::AtUtil::GetTypes<T>::ArgType* GetBoundInstance() const;
-  friend class LazySingleton;  // Uses GetBoundInstance()
 
   // Number of errors encountered so far. Used only in Injector::Create method.
   int num_errors() const { return num_errors_; }
@@ -208,6 +368,28 @@ class Binder {
   void AddBindEntry(internal::TypeId tid,
                     const internal::TableEntryBase* entry);
 
+  // Returns the entry bound to tid that is used by AddToSet()/AddToMap(),
+  // creating it on first call. Returns NULL (and logs an error) if tid is
+  // bound in some other way.
+  template <typename EntryType>
+  EntryType* GetMultibindingEntry(internal::TypeId tid);
+
+  // Creates the entry of an element added by AddToSet()/AddToMap(). The
+  // entry is allocated in and owned by the bind table.
+  template <typename ElementType, typename Annotations,
+            typename Implementation>
+  const internal::TableEntry<ElementType>* NewMultibindingElementEntry();
+
+  // Adds "setup" to the init list of ScopeSetupContext. Init() of "setup" is
+  // called when the injector is created. This fails fatally if the injector
+  // is not created using guicpp::CreateInjector().
+  void AddToScopeInitList(internal::SetupInterface* setup);
+
+  // Allocates the slot of "provider" and adds it to the init list of
+  // ScopeSetupContext. This fails fatally if the injector is not created
+  // using guicpp::CreateInjector().
+  void AttachScopeProvider(internal::ScopeProviderBase* provider);
+
   internal::BindTable* bind_table_;  // pointer not owned by Binder
 
   // Number of errors encountered so far. num_errors_ will be 0 to start with,
@@ -252,8 +434,8 @@ inline void Binder::Bind() {
   typedef typename AtUtil::GetTypes<Interface>::Annotations LhsAnnotations;
   typedef typename AtUtil::GetTypes<Implementation>::Annotations RhsAnnotations;
 
-  const TableEntryBase* entry =
-      new BindToTypeEntry<LhsType, RhsAnnotations, RhsType>();
+  const TableEntryBase* entry = bind_table_->NewEntry<
+      BindToTypeEntry<LhsType, RhsAnnotations, RhsType> >();
 
   TypeId tid = InjectorUtil::GetBindId<LhsAnnotations, LhsType>();
   AddBindEntry(tid, entry);
@@ -274,8 +456,8 @@ inline void Binder::BindValueType() {
   typedef typename AtUtil::GetTypes<T>::Annotations LhsAnnotations;
   typedef typename AtUtil::GetTypes<D>::Annotations RhsAnnotations;
 
-  const TableEntryBase* entry =
-      new BindToTypeEntry<LhsType, RhsAnnotations, RhsType>();
+  const TableEntryBase* entry = bind_table_->NewEntry<
+      BindToTypeEntry<LhsType, RhsAnnotations, RhsType> >();
 
   TypeId tid = InjectorUtil::GetBindId<LhsAnnotations, LhsType>();
   AddBindEntry(tid, entry);
@@ -295,13 +477,59 @@ inline void Binder::BindToInstance(
   typedef typename AtUtil::GetTypes<T>::Annotations LhsAnnotations;
   typedef typename AtUtil::GetTypes<T>::ArgType* LhsType;
 
-  const TableEntryBase* entry =
-      new PointerTableEntry<LhsType, CleanupAction>(ptr, cleanup_action);
+  const TableEntryBase* entry = bind_table_->NewEntry<
+      PointerTableEntry<LhsType, CleanupAction> >(ptr, cleanup_action);
 
   TypeId tid = InjectorUtil::GetBindId<LhsAnnotations, LhsType>();
   AddBindEntry(tid, entry);
 }
 
+// Wraps the instances of "Interface" in "Decorator".
+template <typename Interface, typename Decorator>
+inline void Binder::Decorate() {
+  using internal::AtUtil;
+  using internal::DecoratorEntry;
+  using internal::InjectorUtil;
+  using internal::TypeId;
+
+  typedef typename AtUtil::GetTypes<Interface>::Annotations LhsAnnotations;
+  typedef typename AtUtil::GetTypes<Interface>::ArgType ArgType;
+
+  GUICPP_COMPILE_ASSERT_(
+      (internal::is_convertible<Decorator*, ArgType*>::value),
+      decorator_must_be_convertible_to_decorated_type);
+
+  typedef DecoratorEntry<ArgType, Decorator> EntryType;
+  EntryType* entry = bind_table_->NewEntry<EntryType>();
+
+  TypeId tid = InjectorUtil::GetBindId<LhsAnnotations, ArgType*>();
+  bind_table_->AddDecorator(tid, entry, entry);
+}
+
+// Binds "T" to an instance that can be replaced using the returned handle.
+template <typename T, typename CleanupAction>
+inline SwappableInstance<typename internal::AtUtil::GetTypes<T>::ArgType>*
+Binder::BindToSwappableInstance(
+    typename internal::AtUtil::GetTypes<T>::ArgType* ptr,
+    CleanupAction cleanup_action) {
+  using internal::AtUtil;
+  using internal::SwappableInstanceEntry;
+  using internal::InjectorUtil;
+  using internal::TypeId;
+
+  typedef typename AtUtil::GetTypes<T>::Annotations LhsAnnotations;
+  typedef typename AtUtil::GetTypes<T>::ArgType ArgType;
+
+  typedef SwappableInstanceEntry<ArgType, CleanupAction> EntryType;
+
+  EntryType* entry = bind_table_->NewEntry<EntryType>(ptr, cleanup_action);
+
+  TypeId tid =
+      InjectorUtil::GetBindId<LhsAnnotations, SwappableRef<ArgType> >();
+  AddBindEntry(tid, entry);
+  return entry;
+}
+
 // Binds T to the value.
 template <typename T>
 inline void Binder::BindToValue(
@@ -315,7 +543,8 @@ inline void Binder::BindToValue(
   typedef typename AtUtil::GetTypes<T>::Annotations LhsAnnotations;
   typedef typename AtUtil::GetTypes<T>::ActualType LhsType;
 
-  const TableEntryBase* entry = new ValueTableEntry<LhsType>(value);
+  const TableEntryBase* entry =
+      bind_table_->NewEntry<ValueTableEntry<LhsType> >(value);
 
   TypeId tid = InjectorUtil::GetBindId<LhsAnnotations, LhsType>();
   AddBindEntry(tid, entry);
@@ -335,8 +564,8 @@ inline void Binder::BindRefToPointed(
   typedef typename AtUtil::GetTypes<T>::Annotations LhsAnnotations;
   typedef typename AtUtil::GetTypes<T>::ArgType& LhsType;
 
-  const TableEntryBase* entry =
-      new ReferenceTableEntry<LhsType, CleanupAction>(ptr, cleanup_action);
+  const TableEntryBase* entry = bind_table_->NewEntry<
+      ReferenceTableEntry<LhsType, CleanupAction> >(ptr, cleanup_action);
 
   TypeId tid = InjectorUtil::GetBindId<LhsAnnotations, LhsType>();
   AddBindEntry(tid, entry);
@@ -356,8 +585,8 @@ void Binder::BindToProvider(ProviderType* provider,
   typedef typename AtUtil::GetTypes<T>::ArgType* LhsType;
 
   // BindToProviderEntry assumes the ownership of provider.
-  const TableEntryBase* entry = new BindToProviderEntry<
-      LhsType, ProviderType, CleanupAction>(provider, cleanup_action);
+  const TableEntryBase* entry = bind_table_->NewEntry<BindToProviderEntry<
+      LhsType, ProviderType, CleanupAction> >(provider, cleanup_action);
 
   TypeId tid = InjectorUtil::GetBindId<LhsAnnotations, LhsType>();
   AddBindEntry(tid, entry);
@@ -378,13 +607,131 @@ void Binder::BindValueToProvider(ProviderType* provider,
   typedef typename AtUtil::GetTypes<T>::ActualType LhsType;
 
   // BindToProviderEntry assumes the ownership of provider.
-  const TableEntryBase* entry = new BindToProviderEntry<
-      LhsType, ProviderType, CleanupAction>(provider, cleanup_action);
+  const TableEntryBase* entry = bind_table_->NewEntry<BindToProviderEntry<
+      LhsType, ProviderType, CleanupAction> >(provider, cleanup_action);
 
   TypeId tid = InjectorUtil::GetBindId<LhsAnnotations, LhsType>();
   AddBindEntry(tid, entry);
 }
 
+// Binds "T" to an asynchronous provider.
+template <typename T, typename ProviderType, typename CleanupAction>
+void Binder::BindToAsyncProvider(ProviderType* provider,
+                                 CleanupAction cleanup_action) {
+  using internal::AsyncProviderEntry;
+  using internal::AtUtil;
+  using internal::InjectorUtil;
+  using internal::TableEntryBase;
+  using internal::TypeId;
+
+  typedef typename AtUtil::GetTypes<T>::Annotations LhsAnnotations;
+  typedef typename AtUtil::GetTypes<T>::ArgType* LhsType;
+
+  // Start() is called from ScopeSetupContext::Init() which happens after
+  // all the bindings are done.
+  AddToScopeInitList(provider);
+
+  // AsyncProviderEntry assumes the ownership of provider.
+  const TableEntryBase* entry = bind_table_->NewEntry<AsyncProviderEntry<
+      LhsType, ProviderType, CleanupAction> >(provider, cleanup_action);
+
+  TypeId tid = InjectorUtil::GetBindId<LhsAnnotations, LhsType>();
+  AddBindEntry(tid, entry);
+}
+
+// Adds "Implementation" to the set of "T".
+template <typename T, typename Implementation>
+void Binder::AddToSet() {
+  using internal::AtUtil;
+  using internal::InjectorUtil;
+  using internal::SetTableEntry;
+  using internal::TypeId;
+
+  typedef typename AtUtil::GetTypes<T>::ArgType* ElementType;
+  typedef typename AtUtil::GetTypes<Implementation>::ArgType* RhsType;
+  typedef typename AtUtil::GetTypes<T>::Annotations LhsAnnotations;
+  typedef typename AtUtil::GetTypes<Implementation>::Annotations RhsAnnotations;
+
+  TypeId tid =
+      InjectorUtil::GetBindId<LhsAnnotations, ::std::vector<ElementType> >();
+  SetTableEntry<ElementType>* set_entry =
+      GetMultibindingEntry<SetTableEntry<ElementType> >(tid);
+
+  if (set_entry != NULL) {
+    set_entry->AddElement(
+        NewMultibindingElementEntry<ElementType, RhsAnnotations, RhsType>());
+  }
+}
+
+// Adds "Implementation" to the map of "T" for "key".
+template <typename K, typename T, typename Implementation>
+void Binder::AddToMap(const K& key) {
+  using internal::AtUtil;
+  using internal::BindToTypeEntry;
+  using internal::InjectorUtil;
+  using internal::MapTableEntry;
+  using internal::TypeId;
+
+  typedef typename AtUtil::GetTypes<T>::ArgType* ElementType;
+  typedef typename AtUtil::GetTypes<Implementation>::ArgType* RhsType;
+  typedef typename AtUtil::GetTypes<T>::Annotations LhsAnnotations;
+  typedef typename AtUtil::GetTypes<Implementation>::Annotations RhsAnnotations;
+
+  TypeId tid =
+      InjectorUtil::GetBindId<LhsAnnotations, ::std::map<K, ElementType> >();
+  MapTableEntry<K, ElementType>* map_entry =
+      GetMultibindingEntry<MapTableEntry<K, ElementType> >(tid);
+
+  if (map_entry == NULL) {
+    return;
+  }
+
+  const internal::TableEntry<ElementType>* element_entry =
+      NewMultibindingElementEntry<ElementType, RhsAnnotations, RhsType>();
+  if (!map_entry->AddElement(key, element_entry)) {
+    GUICPP_LOG_(ERROR) << "Duplicate Binding: Key is already added to map.";
+    ++num_errors_;
+  }
+}
+
+// Returns the entry used by AddToSet()/AddToMap(), creating it if required.
+template <typename EntryType>
+EntryType* Binder::GetMultibindingEntry(internal::TypeId tid) {
+  using internal::TableEntryBase;
+
+  // Only the entries added so far are looked up; FindEntry() would merge
+  // them, call deferred installers and count the lookup.
+  const TableEntryBase* base_entry = bind_table_->FindAddedEntry(tid);
+  if (base_entry == NULL) {
+    EntryType* entry = bind_table_->NewEntry<EntryType>();
+    AddBindEntry(tid, entry);
+    return entry;
+  }
+
+  // The entry for tid has same TypeId, category and constness as EntryType;
+  // Hence it is sufficient to check the bind type.
+  if (base_entry->GetBindType() != EntryType::StaticBindType()) {
+    GUICPP_LOG_(ERROR) << "Duplicate Binding: Type is already bound, "
+                          "but not using AddToSet()/AddToMap().";
+    ++num_errors_;
+    return NULL;
+  }
+
+  // Entries are mutable while binding, bind table holds them as const only
+  // because they are never modified once the injector is created.
+  return const_cast<EntryType*>(
+      down_cast<const EntryType*>(base_entry));
+}
+
+// Creates the entry that gets an element added by AddToSet()/AddToMap().
+template <typename ElementType, typename Annotations, typename Implementation>
+const internal::TableEntry<ElementType>* Binder::NewMultibindingElementEntry() {
+  const internal::TableEntry<ElementType>* entry = bind_table_->NewEntry<
+      internal::BindToTypeEntry<ElementType, Annotations, Implementation> >();
+  bind_table_->AddToCleanupList(entry);
+  return entry;
+}
+
 // Binds a scope to type T.
 //
 // Implementation Note:
@@ -395,21 +742,10 @@ void Binder::BindValueToProvider(ProviderType* provider,
 //   This provider creates an instance of T on first call to its Get() and
 //   returns the same instance on successive calls.
 //
-//   This implementation is subject to change. Currently this option is chosen
-//   because it requires very little built-in support from Guic++.
+//   This option is chosen because it requires very little built-in support
+//   from Guic++. Custom scopes bind T using BindToScopeProvider().
 template <typename T, typename Scope>
 void Binder::BindToScope() {
-  // Scope implementation is subject to change in future releases. This
-  // GUICPP_COMPILE_ASSERT_ stops users from using "custom scope". We don't
-  // expect users to write "custom scopes" till the time we finalize the
-  // implementation of Scope.
-  //
-  // GuicppTestScope is used only for Guic++ testing.
-  GUICPP_COMPILE_ASSERT_(
-      (guicpp::internal::is_same<LazySingleton, Scope>::value) ||
-      (guicpp::internal::is_same<internal::GuicppTestScope, Scope>::value),
-      this_version_does_not_allow_anything_otherthan_LazySingleton);
-
   typedef typename internal::AtUtil::GetTypes<T>::ArgType LhsType;
   typedef typename internal::AtUtil::GetTypes<T>::Annotations LhsAnnotations;
 
@@ -418,11 +754,51 @@ void Binder::BindToScope() {
       LhsType>(this);
 }
 
+// Binds "T" to the provider of a custom scope.
+template <typename T, typename ProviderType>
+void Binder::BindToScopeProvider(ProviderType* provider) {
+  using internal::AtUtil;
+  using internal::TableEntryBase;
+  using internal::ScopeProviderEntry;
+  using internal::InjectorUtil;
+  using internal::TypeId;
+
+  typedef typename AtUtil::GetTypes<T>::Annotations LhsAnnotations;
+  typedef typename AtUtil::GetTypes<T>::ArgType* LhsType;
+
+  AttachScopeProvider(provider);
+
+  // Same as BindToProvider(), but the entry asks the provider whether its
+  // instances are stable.
+  const TableEntryBase* entry = bind_table_->NewEntry<ScopeProviderEntry<
+      LhsType, ProviderType, DeletePointer> >(provider, DeletePointer());
+
+  TypeId tid = InjectorUtil::GetBindId<LhsAnnotations, LhsType>();
+  AddBindEntry(tid, entry);
+}
+
+// Binds the value type "T" to the provider of a custom scope.
+template <typename T, typename ProviderType>
+void Binder::BindValueToScopeProvider(ProviderType* provider) {
+  AttachScopeProvider(provider);
+  BindValueToProvider<T>(provider, DeletePointer());
+}
+
+// Returns true if "T" is already bound.
+template <typename T>
+bool Binder::IsBound() const {
+  typedef typename internal::AtUtil::GetTypes<T>::Annotations Annotations;
+  typedef typename internal::AtUtil::GetTypes<T>::ArgType* ArgType;
+
+  return bind_table_->FindEntry(
+      internal::InjectorUtil::GetBindId<Annotations, ArgType>()) != NULL;
+}
+
 // Registers a function/functor to be called at the time of cleanup.
 template <typename CleanupAction>
 void Binder::AddCleanupAction(CleanupAction cleanup_action) {
-  bind_table_->AddToCleanupList(
-      new internal::CleanupEntry<CleanupAction>(cleanup_action));
+  bind_table_->AddToCleanupList(bind_table_->NewEntry<
+      internal::CleanupEntry<CleanupAction> >(cleanup_action));
 }
 
 // Returns the instance bound to "T" using BindToInstance().
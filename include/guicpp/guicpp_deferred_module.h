@@ -0,0 +1,116 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// This file defines modules whose installation is deferred until one of the
+// types they bind is requested.
+//
+// Use Case:
+//  A binary that supports many modes links in modules for all of them, but a
+//  run uses only a few of the bindings. Configure() of every installed module
+//  is called when the injector is created, which may be costly when it loads
+//  resources (e.g. a module that loads the contact list in Configure()).
+//
+// Usage:
+//  1. Inherit the module from guicpp::DeferredModule and declare the types
+//     it binds in DeclareKeys(). Types are declared as they are requested
+//     from the injector and can be annotated.
+//
+//     Example:
+//      class ContactListModule: public guicpp::DeferredModule {
+//       public:
+//        void DeclareKeys(guicpp::DeferredKeys* keys) const {
+//          keys->Add<ContactList*>();
+//          keys->Add<guicpp::At<AdminLabel, string> >();
+//        }
+//
+//        void Configure(guicpp::Binder* binder) const {
+//          binder->BindToInstance<ContactList>(
+//              ContactList::Load(kContactsFile), guicpp::DeletePointer());
+//          binder->BindToValue<guicpp::At<AdminLabel, string> >("root");
+//        }
+//      };
+//
+//  2. Install the module using Binder::InstallDeferred().
+//
+//        binder->InstallDeferred(&contact_list_module);
+//
+//  Configure() is called when one of the declared types is first looked up
+//  (and never, if none of them are). It is an error for Configure() to have
+//  errors, such as duplicate bindings; Guic++ fails fatally as it does when
+//  the injector is created.
+//
+//  Note: Types bound by Configure() but not declared do not trigger the
+//  installation.
+//
+//  Note: Installations are serialized by a lock of the injector, which is
+//  taken only by lookups of the declared types that are not installed yet.
+//  Other lookups do not wait for a running installation; They see its
+//  bindings once it publishes them.
+
+#ifndef GUICPP_DEFERRED_MODULE_H_
+#define GUICPP_DEFERRED_MODULE_H_
+
+#include <vector>
+
+#include "guicpp/internal/guicpp_port.h"
+#include "guicpp/guicpp_at.h"
+#include "guicpp/guicpp_module.h"
+#include "guicpp/internal/guicpp_inject_util.h"
+#include "guicpp/internal/guicpp_types.h"
+
+namespace guicpp {
+// The types bound by a DeferredModule.
+class DeferredKeys {
+ public:
+  DeferredKeys() {}
+  ~DeferredKeys() {}
+
+  // Declares the type T, which can be annotated.
+  template <typename T>
+  void Add() {
+    typedef typename internal::AtUtil::GetTypes<T>::ActualType ActualType;
+    typedef typename internal::AtUtil::GetTypes<T>::Annotations Annotations;
+
+    bind_ids_.push_back(
+        internal::InjectorUtil::GetBindId<Annotations, ActualType>());
+  }
+
+  const ::std::vector<internal::TypeId>& bind_ids() const {
+    return bind_ids_;
+  }
+
+ private:
+  ::std::vector<internal::TypeId> bind_ids_;
+
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(DeferredKeys);
+};
+
+// Module that is configured when one of the declared types is requested.
+class DeferredModule: public Module {
+ public:
+  virtual ~DeferredModule() {}
+
+  // User shall declare the types bound in Configure() by adding them to
+  // keys.
+  virtual void DeclareKeys(DeferredKeys* keys) const = 0;
+
+ protected:
+  DeferredModule() {}
+};
+
+}  // namespace guicpp
+
+#endif  // GUICPP_DEFERRED_MODULE_H_
@@ -0,0 +1,126 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// This file defines emplace factories.
+//
+// Use Case:
+//  A factory (see factory.h) creates each object using new. For short lived
+//  objects created at a high rate, for example a handler created for each
+//  request and deleted once the request is handled, the heap allocation can
+//  be avoided by constructing the object on the stack of the caller or in a
+//  buffer that is reused.
+//
+//  An emplace factory constructs the object in the storage passed by the
+//  caller. The size and alignment of the storage required are known at
+//  compile time.
+//
+// Usage:
+//  1. Make the type injectable using GUICPP_INJECT_CTOR, annotating the
+//     arguments taken from the factory with guicpp::Assisted (same as
+//     guicpp::Factory).
+//
+//  2. Define the factory interface by inheriting from
+//     guicpp::EmplaceFactory<type (arguments-of-emplace)>. Note that the
+//     type is not a pointer.
+//
+//     Example:
+//      class NotifyRequestHandlerFactory: public guicpp::EmplaceFactory<
+//            NotifyRequestHandler (HttpRequest* request)> {
+//        // This is an empty class. Do not define any methods here.
+//      };
+//
+//     This is equivalent to:
+//      class NotifyRequestHandlerFactoryEquivalent {
+//       public:
+//        static const size_t kObjectSize = sizeof(NotifyRequestHandler);
+//        static const size_t kObjectAlignment = ...;
+//
+//        virtual NotifyRequestHandler* Emplace(
+//            void* storage, HttpRequest* request) const;
+//      };
+//
+//  3. Inject the factory as usual and construct the objects in storage of
+//     kObjectSize bytes aligned to kObjectAlignment. EmplaceStorage (below)
+//     is such storage, which may be on the stack. The object must be
+//     destroyed by calling its destructor; It must not be deleted.
+//
+//     Example:
+//      guicpp::EmplaceStorage<NotifyRequestHandlerFactory> storage;
+//      NotifyRequestHandler* handler =
+//          handler_factory_->Emplace(storage.get(), request);
+//      handler->Handle();
+//      handler->~NotifyRequestHandler();
+//
+// Note:
+//  The object is always constructed using the constructor of the type; It
+//  is not possible to construct a sub-class (of unknown size). Hence the
+//  bindings of the type are not used; Its dependencies are injected as
+//  usual.
+
+#ifndef GUICPP_EMPLACE_FACTORY_H_
+#define GUICPP_EMPLACE_FACTORY_H_
+
+#include "guicpp/guicpp_annotations.h"
+#include "guicpp/guicpp_at.h"
+#include "guicpp/internal/guicpp_factory_types.h"
+#include "guicpp/internal/guicpp_port.h"
+#include "guicpp/internal/guicpp_types.h"
+
+#include "guicpp/internal/guicpp_emplace_factory_helpers.h"
+
+namespace guicpp {
+// This is the emplace factory interface. See the comments above and
+// guicpp::Factory in factory.h.
+template <typename GetSignature>
+class EmplaceFactory: public internal::EmplaceFactoryInterface<GetSignature> {
+ public:
+  typedef GetSignature GuicppGetSignature;
+  typedef internal::EmplaceFactoryTag GuicppFactoryTag;
+
+  virtual ~EmplaceFactory() {}
+
+ protected:
+  EmplaceFactory() {}
+
+ private:
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(EmplaceFactory);
+};
+
+// Storage for an object constructed by an emplace factory of type
+// FactoryType. It does not construct or destroy the object.
+template <typename FactoryType>
+class EmplaceStorage {
+ public:
+  EmplaceStorage() {}
+
+  void* get() { return storage_.bytes; }
+
+ private:
+  GUICPP_COMPILE_ASSERT_(
+      FactoryType::kObjectAlignment <=
+          internal::AlignOf<internal::MaxAlignType>::value,
+      type_is_over_aligned_for_emplace_storage);
+
+  union {
+    char bytes[FactoryType::kObjectSize];
+    internal::MaxAlignType align;
+  } storage_;
+
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(EmplaceStorage);
+};
+
+}  // namespace guicpp
+
+#endif  // GUICPP_EMPLACE_FACTORY_H_
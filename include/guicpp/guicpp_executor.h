@@ -0,0 +1,116 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// This file declares the Executor interface. Guic++ does not create threads
+// of its own; Instead, work that may run in the background is handed over to
+// an Executor implemented by the user (typically a wrapper of the thread pool
+// used by the application).
+//
+// Usage:
+//   Implement Executor and bind it with the label of the Guic++ feature that
+//   should use it.
+//
+//   Example: Start() of asynchronous providers (see async_provider.h) are run
+//   on the executor bound with label AsyncStartExecutor.
+//
+//     class ThreadPoolExecutor: public guicpp::Executor {
+//      public:
+//       explicit ThreadPoolExecutor(ThreadPool* pool): pool_(pool) {}
+//
+//       void Schedule(guicpp::Closure* closure) {
+//         pool_->Add(NewCallback(&RunAndDelete, closure));
+//       }
+//       ...
+//     };
+//
+//     binder->BindToInstance<
+//         guicpp::At<guicpp::AsyncStartExecutor, guicpp::Executor> >(
+//             new ThreadPoolExecutor(pool), guicpp::DeletePointer());
+
+#ifndef GUICPP_EXECUTOR_H_
+#define GUICPP_EXECUTOR_H_
+
+#include "guicpp/internal/guicpp_port.h"
+#include "guicpp/guicpp_annotations.h"
+#include "guicpp/guicpp_at.h"
+#include "guicpp/guicpp_macros.h"
+#include "guicpp/internal/guicpp_inject_util.h"
+#include "guicpp/internal/guicpp_types.h"
+
+namespace guicpp {
+class Injector;
+
+// A unit of work scheduled on an Executor.
+class Closure {
+ public:
+  virtual ~Closure() {}
+  virtual void Run() = 0;
+
+ protected:
+  Closure() {}
+
+ private:
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(Closure);
+};
+
+// Interface of executor implemented by user.
+class Executor {
+ public:
+  virtual ~Executor() {}
+
+  // Runs closure->Run() exactly once, possibly on another thread, and deletes
+  // the closure after Run() returns. Executor takes the ownership of closure.
+  virtual void Schedule(Closure* closure) = 0;
+
+ protected:
+  Executor() {}
+
+ private:
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(Executor);
+};
+
+GUICPP_INJECTABLE(Executor);
+
+// Label used to bind the executor on which Start() methods of asynchronous
+// providers are run. All of them are scheduled when the injector is created,
+// in order of binding and without regard to dependencies between providers.
+// If no executor is bound with this label, Start() is called on the thread
+// creating the injector.
+class AsyncStartExecutor: public Label {};
+
+namespace internal {
+// Returns the executor bound with label "L" or NULL if there is no such
+// binding.
+template <typename L>
+Executor* FindBoundExecutor(const Injector* injector);
+
+// Non-template part of FindBoundExecutor.
+Executor* FindBoundExecutor(const Injector* injector, TypeId bind_id);
+
+}  // namespace internal
+
+// -- Implementation --
+
+namespace internal {
+template <typename L>
+Executor* FindBoundExecutor(const Injector* injector) {
+  return FindBoundExecutor(
+      injector, InjectorUtil::GetBindId<Annotations<L>, Executor*>());
+}
+
+}  // namespace internal
+}  // namespace guicpp
+
+#endif  // GUICPP_EXECUTOR_H_
@@ -117,6 +117,24 @@
 //     Note: Factory ownership is transferred to class through the constructor
 //     (in the above example, NotifyRequestDispatcher will own the factory).
 //
+//     Alternatively, take the factory as a const reference. Such factories
+//     are created once per injector, shared by all the classes taking them
+//     by const reference and are owned by the injector. This avoids creating
+//     (and deleting) a factory for each instance of the class taking it,
+//     which helps when those instances are themselves created frequently.
+//
+//      class NotifyRequestDispatcher: public Dispatcher {
+//       public:
+//        NotifyRequestDispatcher(const NotifyRequestHandlerFactory& factory)
+//          : req_handler_factory_(factory) {
+//        }
+//        ...
+//       private:
+//        const NotifyRequestHandlerFactory& req_handler_factory_;
+//      };
+//
+//     The class must not outlive the injector.
+//
 //  4. Use it to create objects at runtime
 //     Example:
 //      void RequestDispatcher::Dispatch(
@@ -230,6 +248,7 @@ template <typename GetSignature>
 class Factory: public internal::FactoryInterface<GetSignature> {
  public:
   typedef GetSignature GuicppGetSignature;
+  typedef internal::NewInstanceFactoryTag GuicppFactoryTag;
 
   virtual ~Factory() {}
 
@@ -48,6 +48,29 @@ class Injector: public internal::InternalType {
   template <typename T>
   typename internal::AtUtil::GetTypes<T>::ActualType Get() const;
 
+  // Returns the number of bindings and the bytes used by them for each kind
+  // of binding (BindType). This can be used to find out the memory used by
+  // the bindings of a large binary.
+  //
+  // Usage:
+  //   internal::BindTableMemoryStats stats = injector->MemoryStats();
+  //   size_t instance_bytes =
+  //       stats.entry_bytes[internal::TableEntryBase::BIND_TO_INSTANCE];
+  internal::BindTableMemoryStats MemoryStats() const;
+
+  // Returns the bindings that are never looked up and at most
+  // "max_hot_bindings" bindings that are looked up most. Unused bindings are
+  // candidates for removal from the modules, which saves their startup work
+  // and memory. The report is empty unless Binder::EnableUsageCounters() is
+  // called while configuring.
+  //
+  // Usage:
+  //   internal::BindTableUsageReport report = injector->UsageReport(10);
+  //   for (size_t i = 0; i < report.unused_bindings.size(); ++i) {
+  //     ... report.unused_bindings[i].bind_id ...
+  //   }
+  internal::BindTableUsageReport UsageReport(size_t max_hot_bindings) const;
+
   // WARNING: DO NOT USE THIS DIRECTLY.
   // Use guicpp::CreateInjector() declared in tools.h.
   //
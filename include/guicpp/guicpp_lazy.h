@@ -0,0 +1,125 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// This file defines guicpp::Lazy, a handle that defers creation of an
+// instance until it is first used.
+//
+// Use Case:
+//  A class often takes dependencies that it touches only on rare code paths.
+//  Injecting them directly creates them (and all their dependencies) every
+//  time the class is created, even if they are never used.
+//
+// Usage:
+//  Take a pointer to guicpp::Lazy<T> instead of T as constructor argument.
+//  T can be annotated as usual. The instance is created by the first call
+//  to Get(); Later calls return the same instance.
+//
+//   Example:
+//    class RequestHandler {
+//     public:
+//      explicit RequestHandler(guicpp::Lazy<AuditLog*>* audit_log)
+//          : audit_log_(audit_log) {}
+//
+//      void Handle(Request* request) {
+//        if (request->IsSuspicious()) {
+//          audit_log_->Get()->Record(request);
+//        }
+//      }
+//
+//     private:
+//      scoped_ptr<guicpp::Lazy<AuditLog*> > audit_log_;
+//    };
+//
+//    GUICPP_INJECT_CTOR(RequestHandler, (
+//        guicpp::Lazy<AuditLog*>* audit_log));
+//
+//  Note: Ownership of the Lazy object is transferred to the class through the
+//  constructor (same as factories). Lazy does not own the created instance;
+//  It is owned as if it was injected directly. In the above example,
+//  AuditLog is deleted by RequestHandler unless it is a singleton.
+//
+//  Note: The instance is created using the injector, outside of any factory
+//  call. Hence the instance (and its dependencies) can not take Assisted
+//  arguments; Get() fails fatally if they do.
+
+#ifndef GUICPP_LAZY_H_
+#define GUICPP_LAZY_H_
+
+#include "guicpp/internal/guicpp_port.h"
+#include "guicpp/guicpp_at.h"
+#include "guicpp/internal/guicpp_inject_util.h"
+#include "guicpp/internal/guicpp_local_context.h"
+#include "guicpp/internal/guicpp_table.h"
+#include "guicpp/internal/guicpp_types.h"
+
+namespace guicpp {
+// Handle to an instance of T that is created on first call to Get().
+// T is the injected type, optionally annotated using guicpp::At.
+template <typename T>
+class Lazy: public internal::LazyBase {
+ public:
+  typedef typename internal::AtUtil::GetTypes<T>::ActualType ActualType;
+
+  ~Lazy() {}
+
+  // Creates the instance on first call and returns the same instance on
+  // every call.
+  ActualType Get() const {
+    once_.Init(&Create, this);
+    return instance_;
+  }
+
+ private:
+  typedef typename internal::AtUtil::GetTypes<T>::Annotations Annotations;
+
+  template <typename A, typename I>
+  friend class internal::InternalTypeInjectHandler;
+
+  // The bind table entry is looked up now, when Lazy is injected, to keep
+  // the lookup out of the first Get(). It is NULL if T is not bound
+  // explicitly.
+  explicit Lazy(const Injector* injector)
+      : injector_(injector),
+        entry_(internal::InjectorUtil(injector).FindEntry(
+            internal::InjectorUtil::GetBindId<Annotations, ActualType>())),
+        instance_() {}
+
+  // Called exactly once, by the first call to Get(). The instance is created
+  // outside of any factory call, hence with an empty local context.
+  static void Create(const Lazy* lazy) {
+    internal::LocalContext local_context;
+    if (lazy->entry_ != NULL) {
+      lazy->instance_ = internal::TableEntryReader<ActualType>::Get(
+          lazy->entry_, lazy->injector_, &local_context);
+      return;
+    }
+
+    lazy->instance_ = internal::InjectorUtil(lazy->injector_)
+        .GetActualType<Annotations, ActualType>(&local_context);
+  }
+
+  const Injector* const injector_;
+  const internal::TableEntryBase* const entry_;
+
+  mutable GoogleOnceDynamic once_;
+  mutable ActualType instance_;
+
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(Lazy);
+};
+
+}  // namespace guicpp
+
+#endif  // GUICPP_LAZY_H_
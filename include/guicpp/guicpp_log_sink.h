@@ -0,0 +1,140 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// This file defines AsyncLogSink, a log sink that takes the writing of
+// Guic++ log messages off the logging thread.
+//
+// Use Case:
+//  By default, every message logged with GUICPP_LOG_ is written to stderr by
+//  the thread that logs it. A server that logs heavily from many threads
+//  (such as the notifier example, which logs every request) then waits on
+//  stderr for each message.
+//
+// Usage:
+//  Create the sink with the stream to write to and an executor (see
+//  executor.h), and install it using guicpp::SetLogSink().
+//
+//    guicpp::AsyncLogSink log_sink(&std::cerr, executor);
+//    guicpp::SetLogSink(&log_sink);
+//
+//  Logging a message only appends it to a buffer. The buffer is sharded, each
+//  thread appends to the shard picked for it on its first message, hence
+//  threads logging concurrently rarely contend on the same lock. A closure
+//  that writes out the shard is scheduled on the executor when the shard
+//  becomes non-empty; Messages logged before it runs are written by the same
+//  closure. Messages logged by a thread are written in order, but messages of
+//  different threads may be written in a different order than logged.
+//  FATAL messages are written synchronously before the program is aborted.
+//
+//  Each shard buffers at most "max_shard_bytes" (passed to the constructor).
+//  If the executor falls behind and a message does not fit, the message is
+//  dropped rather than blocking the logging thread or growing the buffer;
+//  The number of messages dropped is written after the buffered messages,
+//  and is returned by num_dropped(). FATAL messages are never dropped.
+//
+//  Note: The sink must outlive the closures scheduled on the executor, and
+//  SetLogSink(NULL) must be called before the sink is deleted.
+//
+// Messages below a severity can also be removed at compile time, see
+// GUICPP_MIN_LOG_LEVEL in port.h.
+
+#ifndef GUICPP_LOG_SINK_H_
+#define GUICPP_LOG_SINK_H_
+
+#include <iostream>
+#include <string>
+
+#include "guicpp/internal/guicpp_port.h"
+#include "guicpp/guicpp_executor.h"
+
+namespace guicpp {
+// LogSink receives the log messages of Guic++ and SetLogSink() installs a
+// sink, see port.h.
+using internal::LogSink;
+using internal::SetLogSink;
+
+// Log sink that buffers the messages and writes them on an executor.
+class AsyncLogSink: public LogSink {
+ public:
+  // Default of "max_shard_bytes".
+  static const size_t kDefaultMaxShardBytes = 64 * 1024;
+
+  // Neither "stream" nor "executor" are owned by the sink.
+  AsyncLogSink(::std::ostream* stream, Executor* executor,
+               size_t max_shard_bytes = kDefaultMaxShardBytes);
+
+  // Writes out the buffered messages.
+  virtual ~AsyncLogSink();
+
+  // Appends the message to the calling thread's shard and schedules a write
+  // of the shard if none is scheduled already. Drops the message if the
+  // shard is full, unless its severity is FATAL.
+  virtual void Send(internal::GuicppLogSeverity severity,
+                    const ::std::string& message);
+
+  // Writes out the messages buffered in all shards on the calling thread.
+  virtual void Flush();
+
+  // Returns the number of messages dropped so far.
+  uint64 num_dropped() const { return LoadCounter(&num_dropped_); }
+
+ private:
+  // Closure that calls sink->FlushShard(shard).
+  class FlushClosure;
+
+  // Number of buffer shards.
+  static const int kNumShards = 16;
+
+  // Buffer of messages logged by the threads that are mapped to a shard.
+  struct Shard {
+    Shard(): num_dropped(0), is_flush_scheduled(false) {}
+
+    // Protects buffer, num_dropped and is_flush_scheduled. Not held while
+    // writing to stream_, hence logging threads never wait for the stream.
+    internal::Mutex mu;
+    ::std::string buffer;
+
+    // Messages dropped since the buffer was last written out.
+    uint64 num_dropped;
+    bool is_flush_scheduled;
+
+    // Keeps the shards on different cache lines.
+    char padding[internal::kCacheLineSize];
+  };
+
+  // Returns the shard of the calling thread.
+  Shard* GetShard();
+
+  // Writes out the messages buffered in "shard".
+  void FlushShard(Shard* shard);
+
+  ::std::ostream* const stream_;
+  Executor* const executor_;
+  const size_t max_shard_bytes_;
+  Shard shards_[kNumShards];
+
+  // Incremented using IncrementCounter().
+  uint64 num_dropped_;
+
+  // Serializes writes to stream_.
+  internal::Mutex stream_mu_;
+
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(AsyncLogSink);
+};
+
+}  // namespace guicpp
+
+#endif  // GUICPP_LOG_SINK_H_
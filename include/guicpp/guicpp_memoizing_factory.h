@@ -0,0 +1,175 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// This file defines memoizing factories.
+//
+// Use Case:
+//  A factory (see factory.h) creates a new object graph on every call to
+//  Get(). When Get() is called repeatedly with the same arguments, for
+//  example to get the handler of a tenant, the same graph is built again on
+//  every call.
+//
+//  A memoizing factory keeps the objects it created in a cache, keyed by the
+//  factory arguments, and returns the cached object when called again with
+//  the same arguments.
+//
+// Usage:
+//  Same as guicpp::Factory, except that the factory interface is inherited
+//  from guicpp::MemoizingFactory<prototype-of-get, capacity>.
+//
+//    capacity     : Maximum number of objects kept in the cache. When full,
+//                   the least recently used object is evicted.
+//
+//  Example:
+//   class TenantHandlerFactory: public guicpp::MemoizingFactory<
+//         guicpp::MemoizedPtr<TenantHandler> (
+//             guicpp::At<TenantLabel, string> tenant), 100> {
+//     // This is an empty class. Do not define any methods here.
+//   };
+//
+//  A caller may still use an object after it is evicted, hence the return
+//  type decides the ownership:
+//
+//    * MemoizedPtr<T>: The factory injects T* and returns a ref-counted
+//      pointer to it. The cache holds one reference, which is dropped on
+//      eviction and when the factory is deleted; The object is deleted
+//      along with its last MemoizedPtr.
+//    * A value (not a pointer): The factory injects and caches a copy of the
+//      value, e.g. a string or a ref-counted handle.
+//
+//  Raw pointers are not accepted as return type, as the factory cannot tell
+//  whether it owns the injected object; An unscoped object would leak when
+//  it is evicted. Use MemoizedPtr<T>, or inject the object directly if it is
+//  a singleton.
+//
+//  If two threads miss the same key at the same time, both create an
+//  object; The one cached first is returned to both, and the other one is
+//  dropped like an evicted value. Caches of 128 or more objects are split
+//  into shards by the hash of the arguments, see LruCache in lru_cache.h.
+//
+//  Arguments of Get() are kept in the cache key. They must be copyable and
+//  comparable using operator<; References are kept as values. Pointer
+//  arguments are compared by address.
+//
+//  stats() returns the number of cache hits, misses and evictions.
+
+#ifndef GUICPP_MEMOIZING_FACTORY_H_
+#define GUICPP_MEMOIZING_FACTORY_H_
+
+#include <stddef.h>
+
+#include <algorithm>
+
+#include "guicpp/guicpp_binder.h"
+#include "guicpp/guicpp_factory.h"
+#include "guicpp/internal/guicpp_factory_types.h"
+#include "guicpp/internal/guicpp_lru_cache.h"
+#include "guicpp/internal/guicpp_types.h"
+
+#include "guicpp/internal/guicpp_memoizing_factory_helpers.h"
+
+namespace guicpp {
+// Ref-counted pointer to an object created by a memoizing factory, see the
+// comments above. Copies share the object, which is deleted along with the
+// last copy. Copies may be made and deleted by different threads.
+template <typename T>
+class MemoizedPtr {
+ public:
+  MemoizedPtr(): ptr_(NULL), num_refs_(NULL) {}
+
+  // Takes the ownership of "ptr".
+  explicit MemoizedPtr(T* ptr): ptr_(ptr), num_refs_(new int32(1)) {}
+
+  MemoizedPtr(const MemoizedPtr& other)
+      : ptr_(other.ptr_), num_refs_(other.num_refs_) {
+    if (num_refs_ != NULL) {
+      AtomicIncrement(num_refs_, 1);
+    }
+  }
+
+  ~MemoizedPtr() {
+    if (num_refs_ != NULL && AtomicIncrement(num_refs_, -1) == 0) {
+      delete ptr_;
+      delete num_refs_;
+    }
+  }
+
+  MemoizedPtr& operator=(const MemoizedPtr& other) {
+    MemoizedPtr copy(other);
+    std::swap(ptr_, copy.ptr_);
+    std::swap(num_refs_, copy.num_refs_);
+    return *this;
+  }
+
+  T* get() const { return ptr_; }
+  T* operator->() const { return ptr_; }
+  T& operator*() const { return *ptr_; }
+
+ private:
+  T* ptr_;
+  int32* num_refs_;
+};
+
+namespace internal {
+// R is returned as injected, except for MemoizedPtr<T> which wraps T*.
+template <typename R>
+struct MemoizedValue {
+  typedef R InjectedType;
+
+  static R Wrap(R value) { return value; }
+};
+
+// Raw pointers are rejected, see the comments above.
+template <typename T>
+struct MemoizedValue<T*> {
+  GUICPP_COMPILE_ASSERT_((is_same<T*, T>::value),
+                         memoizing_factory_must_return_memoized_ptr);
+};
+
+template <typename T>
+struct MemoizedValue<MemoizedPtr<T> > {
+  typedef T* InjectedType;
+
+  static MemoizedPtr<T> Wrap(T* ptr) { return MemoizedPtr<T>(ptr); }
+};
+
+}  // namespace internal
+
+// This is the memoizing factory interface. See the comments above and
+// guicpp::Factory in factory.h.
+template <typename GetSignature, size_t kCapacity>
+class MemoizingFactory: public internal::FactoryInterface<GetSignature> {
+ public:
+  typedef GetSignature GuicppGetSignature;
+  typedef internal::MemoizingFactoryTag GuicppFactoryTag;
+  static const size_t kGuicppCapacity = kCapacity;
+
+  virtual ~MemoizingFactory() {}
+
+  // Returns the counters of the cache.
+  virtual internal::LruCacheStats stats() const = 0;
+
+ protected:
+  MemoizingFactory() {}
+
+ private:
+  GUICPP_COMPILE_ASSERT_(kCapacity > 0, memoizing_factory_capacity_is_zero);
+
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(MemoizingFactory);
+};
+
+}  // namespace guicpp
+
+#endif  // GUICPP_MEMOIZING_FACTORY_H_
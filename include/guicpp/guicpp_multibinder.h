@@ -0,0 +1,49 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// Makes the collections bound by Binder::AddToSet() and Binder::AddToMap()
+// injectable.
+//
+// Usage:
+//   Module:
+//     binder->AddToSet<Notifier, SmsNotifier>();
+//     binder->AddToSet<Notifier, EmailNotifier>();
+//
+//     binder->AddToMap<string, Codec, GzipCodec>("gzip");
+//     binder->AddToMap<string, Codec, ZlibCodec>("zlib");
+//
+//   Injection:
+//     GUICPP_INJECT_CTOR(NotifierRegistry, (
+//         const std::vector<Notifier*>& notifiers,
+//         const std::map<string, Codec*>& codecs));
+//
+// The collections are created when they are requested first and are owned
+// by the injector; Hence they must be requested only as const references.
+
+#ifndef GUICPP_MULTIBINDER_H_
+#define GUICPP_MULTIBINDER_H_
+
+#include <map>
+#include <vector>
+#include "guicpp/guicpp_macros.h"
+
+template <typename T>
+GUICPP_TEMPLATE_INJECTABLE((::std::vector<T>));
+
+template <typename K, typename T>
+GUICPP_TEMPLATE_INJECTABLE((::std::map<K, T>));
+
+#endif  // GUICPP_MULTIBINDER_H_
@@ -0,0 +1,308 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// This file defines the PerNumaNodeSingleton scope.
+//
+// Use Case:
+//  On machines with several NUMA nodes, a read-mostly singleton (e.g. a
+//  ContactList or a routing table) lives in the memory of the node that
+//  created it, and the threads running on the other nodes pay the remote
+//  access latency on every access. PerNumaNodeSingleton keeps one instance
+//  (replica) per NUMA node, and returns the replica of the node on which the
+//  calling thread runs.
+//
+// Usage:
+//  1. Bind the type to PerNumaNodeSingleton scope.
+//
+//       binder->BindToScope<ContactList, guicpp::PerNumaNodeSingleton>();
+//
+//     Note: guicpp::CreateInjector() must be used to create the injector.
+//     As with EmplaceFactory (see emplace_factory.h), the type must be a
+//     complete type made injectable using GUICPP_INJECT_CTOR where it is
+//     bound, and it is always constructed using its constructor.
+//
+//  2. Implement NumaTopology and bind it. Guic++ does not depend on a NUMA
+//     library; For example, on Linux with libnuma:
+//
+//       class LibNumaTopology: public guicpp::NumaTopology {
+//        public:
+//         int GetNumNodes() const { return numa_num_configured_nodes(); }
+//         int GetCurrentNode() const {
+//           return numa_node_of_cpu(sched_getcpu());
+//         }
+//         void* AllocateOnNode(size_t size, int node) const {
+//           return numa_alloc_onnode(size, node);
+//         }
+//         void FreeOnNode(void* memory, size_t size, int node) const {
+//           numa_free(memory, size);
+//         }
+//       };
+//
+//       binder->BindToInstance<guicpp::NumaTopology>(
+//           new LibNumaTopology(), guicpp::DeletePointer());
+//
+//     If NumaTopology is not bound, or it reports a single node, the scope
+//     is same as LazySingleton.
+//
+// Life time of instances:
+//  On the first request of the type, the memory of one replica is allocated
+//  on each node using NumaTopology::AllocateOnNode(). It holds the replica
+//  record (the pointer to the instance and its creation state, read on every
+//  request) followed by the storage of the instance; Each is aligned and
+//  padded to a cache line. The instance of a node is constructed in that
+//  storage (using placement new) on the first request from a thread running
+//  on that node, so the instance itself is in the memory of the node. Memory
+//  the instance allocates later (e.g. a member std::vector) is placed by the
+//  heap allocator as usual. Instances of the nodes that never request the
+//  type are not created. All the replicas are owned by the injector and
+//  destroyed with it.
+//
+//  The replicas are independent instances; A type that is written after
+//  creation must not be bound to this scope.
+
+#ifndef GUICPP_PER_NUMA_NODE_SINGLETON_H_
+#define GUICPP_PER_NUMA_NODE_SINGLETON_H_
+
+#include <new>
+
+#include "guicpp/internal/guicpp_port.h"
+#include "guicpp/internal/guicpp_create_helpers.h"
+#include "guicpp/internal/guicpp_local_context.h"
+#include "guicpp/guicpp_binder.h"
+#include "guicpp/guicpp_injector.h"
+#include "guicpp/guicpp_macros.h"
+#include "guicpp/guicpp_scope.h"
+
+namespace guicpp {
+// Interface implemented by user to describe the NUMA nodes of the machine.
+class NumaTopology {
+ public:
+  virtual ~NumaTopology() {}
+
+  // Returns the number of NUMA nodes. This is called once per binding, on
+  // the first request of the type.
+  virtual int GetNumNodes() const = 0;
+
+  // Returns the node on which the calling thread runs, between 0 and
+  // GetNumNodes() - 1. This is called on every request and must be fast.
+  virtual int GetCurrentNode() const = 0;
+
+  // Allocates "size" bytes in the memory of "node". The default allocates
+  // from the heap, which places the memory on the node of the calling
+  // thread.
+  virtual void* AllocateOnNode(size_t size, int node) const;
+
+  // Frees "memory" returned by AllocateOnNode() for the same "size" and
+  // "node".
+  virtual void FreeOnNode(void* memory, size_t size, int node) const;
+
+ protected:
+  NumaTopology() {}
+
+ private:
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(NumaTopology);
+};
+
+GUICPP_INJECTABLE(NumaTopology);
+
+// Scope of the types that are instantiated once per NUMA node.
+class PerNumaNodeSingleton {
+ public:
+  template<typename L, typename T>
+  static void ConfigureScope(Binder* binder);
+
+ private:
+  GUICPP_DISALLOW_IMPLICIT_CONSTRUCTORS_(PerNumaNodeSingleton);
+};
+
+
+// Implementation
+
+namespace internal {
+// Returns the bound NumaTopology or NULL if there is no such binding.
+NumaTopology* FindBoundNumaTopology(const Injector* injector);
+
+// Allocates and frees the memory of the replicas, using "topology" unless
+// it is NULL.
+void* AllocateReplica(const NumaTopology* topology, size_t size, int node);
+void FreeReplica(const NumaTopology* topology, void* memory, size_t size,
+                 int node);
+
+// Logs the invalid node returned by NumaTopology::GetCurrentNode().
+void LogInvalidNumaNode(const int* node);
+
+// This class implements per NUMA node singleton scope. On first call to
+// Get(), it looks up NumaTopology and allocates one replica per node on
+// that node; The table of the replicas is kept in the slot of the binding.
+// Each instance is constructed in the memory of its replica, on first call
+// to Get() from its node.
+template <typename T>
+class PerNumaNodeSingletonProvider: public AbstractScopeProvider<T> {
+ public:
+  PerNumaNodeSingletonProvider(): topology_(NULL), num_replicas_(0) {}
+
+  ~PerNumaNodeSingletonProvider() {
+    // Cleanup must be called before deleting PerNumaNodeSingletonProvider.
+    GUICPP_DCHECK_(num_replicas_ == 0 || replicas() == NULL);
+  }
+
+  // One instance per node, created once.
+  virtual bool HasStableInstances() const { return true; }
+
+  T* Get() {
+    once_.Init(&Setup, this);  // Allocates the replicas the first time.
+
+    Replica* replica = replicas()[GetCurrentNode()];
+    replica->once.Init(&CreateReplica, replica);
+    return replica->object;
+  }
+
+  // Destroys the instances in reverse order of nodes, then the replicas.
+  // The replicas are allocated before the first instance is created, and
+  // hence before this provider is added to the cleanup list.
+  void Cleanup() {
+    Replica** replicas = this->replicas();
+    if (replicas == NULL) {
+      return;
+    }
+
+    for (int i = num_replicas_ - 1; i >= 0; --i) {
+      if (replicas[i]->object != NULL) {
+        replicas[i]->object->~T();
+        replicas[i]->object = NULL;
+      }
+    }
+
+    for (int i = 0; i < num_replicas_; ++i) {
+      void* memory = replicas[i]->memory;
+      replicas[i]->~Replica();
+      FreeReplica(topology_, memory, kReplicaBytes, i);
+    }
+
+    delete[] replicas;
+    this->slot()->set_value(NULL);
+  }
+
+ private:
+  // Replica of one node, allocated on that node.
+  struct Replica {
+    Replica(PerNumaNodeSingletonProvider* provider, void* memory)
+        : provider(provider), memory(memory), object(NULL) {}
+
+    PerNumaNodeSingletonProvider* const provider;
+    void* const memory;  // Returned by AllocateReplica(), holds this.
+    T* object;
+    GoogleOnceDynamic once;
+  };
+
+  // Offset of the storage of the instance from the replica record: Replica
+  // rounded up to a cache line.
+  static const size_t kObjectOffset =
+      (sizeof(Replica) / kCacheLineSize + 1) * kCacheLineSize;
+
+  // Bytes allocated per replica: The record and the instance, each rounded
+  // up to a cache line, plus a cache line to align the record. Hence no
+  // other data shares their cache lines.
+  static const size_t kReplicaBytes =
+      kObjectOffset + (sizeof(T) / kCacheLineSize + 2) * kCacheLineSize;
+
+  // The instance is aligned to a cache line.
+  GUICPP_COMPILE_ASSERT_(AlignOf<T>::value <= kCacheLineSize,
+                         type_is_over_aligned_for_per_numa_node_singleton);
+
+  Replica** replicas() const {
+    return static_cast<Replica**>(this->slot()->value());
+  }
+
+  int GetCurrentNode() {
+    if (num_replicas_ == 1) {
+      return 0;  // Single node or no NumaTopology: same as LazySingleton.
+    }
+
+    int node = topology_->GetCurrentNode();
+    if (node < 0 || node >= num_replicas_) {
+      invalid_node_once_.Init(&LogInvalidNumaNode,
+                              static_cast<const int*>(&node));
+      return 0;
+    }
+
+    return node;
+  }
+
+  // This is supposed to be called only once.
+  static void Setup(PerNumaNodeSingletonProvider* provider) {
+    provider->topology_ = FindBoundNumaTopology(provider->injector());
+
+    int num_nodes = 1;
+    if (provider->topology_ != NULL) {
+      num_nodes = provider->topology_->GetNumNodes();
+      GUICPP_DCHECK_(num_nodes > 0) << "Invalid number of NUMA nodes";
+      if (num_nodes < 1) {
+        num_nodes = 1;
+      }
+    }
+
+    Replica** replicas = new Replica*[num_nodes];
+    for (int i = 0; i < num_nodes; ++i) {
+      void* memory = AllocateReplica(provider->topology_, kReplicaBytes, i);
+      size_t misalignment = reinterpret_cast<size_t>(memory) % kCacheLineSize;
+      replicas[i] = new(static_cast<char*>(memory) + kCacheLineSize -
+                        misalignment) Replica(provider, memory);
+    }
+
+    provider->slot()->set_value(replicas);
+    provider->num_replicas_ = num_nodes;
+  }
+
+  // Called once per replica, on the node of the replica. Constructs the
+  // instance in the memory of the replica, see EmplaceFactory.
+  static void CreateReplica(Replica* replica) {
+    PerNumaNodeSingletonProvider* provider = replica->provider;
+    LocalContext local_context;
+    replica->object = CreateHelpers::Emplace(
+        reinterpret_cast<char*>(replica) + kObjectOffset,
+        provider->injector(), &local_context,
+        GuicppCtorSignature(TypeKey<T>()));
+
+    // Same as LazySingletonProvider, the provider is added to the cleanup
+    // list after its first instance (and hence its dependencies) is created.
+    provider->cleanup_once_.Init(&AddToCleanupList, provider);
+  }
+
+  static void AddToCleanupList(PerNumaNodeSingletonProvider* provider) {
+    provider->AbstractScopeProvider<T>::AddToCleanupList();
+  }
+
+  GoogleOnceDynamic once_;
+  GoogleOnceDynamic cleanup_once_;
+  GoogleOnceDynamic invalid_node_once_;
+  const NumaTopology* topology_;
+  int num_replicas_;
+
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(PerNumaNodeSingletonProvider);
+};
+
+}  // namespace internal
+
+
+template<typename L, typename T>
+inline void PerNumaNodeSingleton::ConfigureScope(Binder* binder) {
+  binder->BindToScopeProvider<guicpp::At<L, T> >(
+      new internal::PerNumaNodeSingletonProvider<T>());
+}
+
+}  // namespace guicpp
+
+#endif  // GUICPP_PER_NUMA_NODE_SINGLETON_H_
@@ -0,0 +1,158 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// This file defines the Prototype scope.
+//
+// Use Case:
+//  Some objects are expensive to create through their constructor and its
+//  chain of dependencies, but are cheap to copy; For example a parser that
+//  compiles its tables in the constructor. When such a type is bound to
+//  Prototype scope, the object graph is created only once, for the first
+//  request. This object (the prototype) is kept by the injector and every
+//  request returns a new copy of it.
+//
+// Usage:
+//   binder->BindToScope<Parser, guicpp::Prototype>();
+//
+//  Each request of Parser* returns a new instance, created using the copy
+//  constructor of Parser, and is owned by the caller (as if the type is
+//  not scoped). Parser must be copy constructible and the copy must not
+//  share mutable state with the prototype.
+//
+//  Prototype creates and copies the scoped type itself. To inject an
+//  interface, either scope the implementation and bind the interface to it
+//  as usual, or name the implementation using PrototypeOf, in place of
+//  Bind<ParserInterface, Parser>():
+//
+//   binder->BindToScope<ParserInterface, guicpp::PrototypeOf<Parser> >();
+//
+//  Each request of ParserInterface* then returns a new copy of a Parser.
+//
+//  Note: guicpp::CreateInjector() must be used to create the injector.
+
+#ifndef GUICPP_PROTOTYPE_H_
+#define GUICPP_PROTOTYPE_H_
+
+#include "guicpp/internal/guicpp_port.h"
+#include "guicpp/guicpp_annotations.h"
+#include "guicpp/guicpp_at.h"
+#include "guicpp/guicpp_binder.h"
+#include "guicpp/guicpp_injector.h"
+#include "guicpp/guicpp_macros.h"
+#include "guicpp/guicpp_provider.h"
+#include "guicpp/guicpp_scope.h"
+
+namespace guicpp {
+// The types that are bound to Prototype are instantiated on the first
+// request, and are copied from this instance on every request.
+//
+// Implementation:
+//  Same as LazySingleton, Prototype::ConfigureScope() binds T annotated
+//  with L to PrototypeProvider<T>.
+class Prototype {
+ public:
+  template<typename L, typename T>
+  static void ConfigureScope(Binder* binder);
+
+ private:
+  GUICPP_DISALLOW_IMPLICIT_CONSTRUCTORS_(Prototype);
+};
+
+// Same as Prototype, but the prototype is an Impl and the requests of the
+// scoped type T return copies of it. Impl must derive from T (or be T).
+template <typename Impl>
+class PrototypeOf {
+ public:
+  template<typename L, typename T>
+  static void ConfigureScope(Binder* binder);
+
+ private:
+  GUICPP_DISALLOW_IMPLICIT_CONSTRUCTORS_(PrototypeOf);
+};
+
+
+// Implementation
+
+namespace internal {
+// This class implements prototype scope. It creates the prototype on first
+// call to Get() the same way LazySingletonProvider creates the singleton,
+// keeps it in the slot of the binding, and returns a copy of the prototype,
+// made as Impl, on every call.
+template <typename T, typename Impl>
+class PrototypeProvider: public AbstractScopeProvider<T> {
+ public:
+  PrototypeProvider() {}
+
+  ~PrototypeProvider() {
+    // Cleanup must be called before deleting PrototypeProvider.
+    GUICPP_DCHECK_(this->slot() == NULL || this->slot()->value() == NULL);
+  }
+
+  T* Get() {
+    void* prototype = this->slot()->AcquireValue();
+    if (prototype == NULL) {
+      once_.Init(&Create, this);  // Creates prototype the first time.
+      prototype = this->slot()->AcquireValue();
+    }
+
+    return new Impl(*static_cast<const Impl*>(prototype));
+  }
+
+  void Cleanup() {
+    delete static_cast<const Impl*>(this->slot()->value());
+    this->slot()->set_value(NULL);
+  }
+
+ private:
+  // This is supposed to be called only once.
+  static void Create(PrototypeProvider* provider) {
+    // See AbstractScopeProvider::CreateUnscoped() for the use of UnScoped.
+    Impl* prototype =
+        provider->injector()->template Get<At<UnScoped, Impl*> >();
+
+    // The prototype may depend on singletons created while creating it;
+    // Adding it to the cleanup list after them ensures that it is deleted
+    // before them.
+    provider->AddToCleanupList();
+    provider->slot()->ReleaseValue(
+        const_cast<void*>(static_cast<const void*>(prototype)));
+  }
+
+  GoogleOnceDynamic once_;
+
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(PrototypeProvider);
+};
+
+}  // namespace internal
+
+
+template<typename L, typename T>
+inline void Prototype::ConfigureScope(Binder* binder) {
+  PrototypeOf<T>::template ConfigureScope<L, T>(binder);
+}
+
+template <typename Impl>
+template<typename L, typename T>
+inline void PrototypeOf<Impl>::ConfigureScope(Binder* binder) {
+  GUICPP_COMPILE_ASSERT_((internal::is_convertible<Impl*, T*>::value),
+                         Prototype_implementation_must_derive_from_type);
+
+  binder->BindToScopeProvider<guicpp::At<L, T> >(
+      new internal::PrototypeProvider<T, Impl>());
+}
+
+}  // namespace guicpp
+
+#endif  // GUICPP_PROTOTYPE_H_
@@ -130,7 +130,7 @@ class AbstractProvider : public internal::ProviderGet<T> {
  private:
   typename AbstractProvider::ReturnType InvokeGet(
       const Injector* injector, const internal::LocalContext* local_context) {
-    get_invoker_fp_(injector, local_context, this);
+    return get_invoker_fp_(injector, local_context, this);
   }
 
   // The following classes uses InvokeGet() method.
@@ -0,0 +1,381 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// This file defines the RefreshingSingleton scope.
+//
+// Use Case:
+//  Some singletons hold data that goes stale, for example a ContactList
+//  loaded from a file or a routing table. With LazySingleton the instance is
+//  kept until the injector is deleted. RefreshingSingleton behaves like
+//  LazySingleton, but the instance can be rebuilt while the injector is in
+//  use, without blocking the readers during the rebuild.
+//
+// Usage:
+//  1. Bind the type to RefreshingSingleton scope.
+//
+//       binder->BindToScope<ContactList, guicpp::RefreshingSingleton>();
+//
+//     Note: guicpp::CreateInjector() must be used to create the injector.
+//
+//  2. Inject SwappableRef<ContactList> (see swappable_instance.h), not
+//     ContactList*. Get it from injector (or from a provider) whenever it is
+//     needed, instead of keeping it for the life time of the user.
+//
+//       guicpp::SwappableRef<ContactList> contacts =
+//           injector->Get<guicpp::SwappableRef<ContactList> >();
+//
+//  3. Call SingletonRefresher::Refresh() to rebuild the instances, typically
+//     from a periodic timer of the application. Guic++ does not have timers
+//     of its own.
+//
+//       injector->Get<guicpp::SingletonRefresher*>()->Refresh();
+//
+//     SingletonRefresher is bound by the injector when at least one type is
+//     bound to RefreshingSingleton; It is owned by the injector.
+//
+//     To rebuild a type less often than Refresh() is called, bind it to
+//     RefreshingSingletonWithPeriod<kPeriodSeconds> instead; Refresh() then
+//     rebuilds it only if kPeriodSeconds have passed since it was last
+//     created or rebuilt. The application can then call Refresh() at one
+//     short interval for all the types.
+//
+//       binder->BindToScope<RoutingTable,
+//                           guicpp::RefreshingSingletonWithPeriod<300> >();
+//
+//  4. Optionally, bind an executor with label guicpp::RefreshExecutor (see
+//     executor.h). If bound, the instances are rebuilt on this executor,
+//     otherwise they are rebuilt in Refresh().
+//
+// Life time of instances:
+//  The new instance is created without holding any lock, and then published
+//  by swapping a pointer; Get() holds a shared lock only to add a reference
+//  to the current instance. The previous instance is deleted when the last
+//  SwappableRef to it is dropped, hence a reader may use an instance for as
+//  long as it holds the SwappableRef, however many rebuilds happen meanwhile.
+//  The current instance is released when the injector is deleted; The
+//  SwappableRefs should be dropped before it, as an instance deleted later
+//  may not use its dependencies in its destructor.
+//
+//  A rebuild scheduled on the executor does nothing if it runs after the
+//  injector is deleted, and deleting the injector waits for a running one.
+//
+//  Instances that are never requested are not created by Refresh().
+
+#ifndef GUICPP_REFRESHING_SINGLETON_H_
+#define GUICPP_REFRESHING_SINGLETON_H_
+
+#include <vector>
+
+#include "guicpp/internal/guicpp_port.h"
+#include "guicpp/guicpp_annotations.h"
+#include "guicpp/guicpp_at.h"
+#include "guicpp/guicpp_binder.h"
+#include "guicpp/guicpp_executor.h"
+#include "guicpp/guicpp_injector.h"
+#include "guicpp/guicpp_macros.h"
+#include "guicpp/guicpp_provider.h"
+#include "guicpp/guicpp_scope.h"
+#include "guicpp/guicpp_swappable_instance.h"
+
+namespace guicpp {
+// Label used to bind the executor on which refreshing singletons are
+// rebuilt. If no executor is bound with this label, the instances are
+// rebuilt in SingletonRefresher::Refresh().
+class RefreshExecutor: public Label {};
+
+// Scope of the types that are rebuilt on SingletonRefresher::Refresh().
+// Between two refreshes, it is same as LazySingleton.
+class RefreshingSingleton {
+ public:
+  template<typename L, typename T>
+  static void ConfigureScope(Binder* binder);
+
+ private:
+  GUICPP_DISALLOW_IMPLICIT_CONSTRUCTORS_(RefreshingSingleton);
+};
+
+// Same as RefreshingSingleton, but SingletonRefresher::Refresh() rebuilds
+// the instance only if kPeriodSeconds have passed since it was created or
+// last rebuilt.
+template <int kPeriodSeconds>
+class RefreshingSingletonWithPeriod {
+ public:
+  template<typename L, typename T>
+  static void ConfigureScope(Binder* binder);
+
+ private:
+  GUICPP_COMPILE_ASSERT_(kPeriodSeconds >= 0, refresh_period_is_negative);
+
+  GUICPP_DISALLOW_IMPLICIT_CONSTRUCTORS_(RefreshingSingletonWithPeriod);
+};
+
+namespace internal {
+class RefreshInterface {
+ public:
+  virtual ~RefreshInterface() {}
+
+  // Rebuilds the instance, if it is already created.
+  virtual void Refresh() = 0;
+
+ protected:
+  RefreshInterface() {}
+};
+
+template <typename T> class RefreshingSingletonProvider;
+
+}  // namespace internal
+
+// Rebuilds all the instances bound to RefreshingSingleton scope.
+class SingletonRefresher {
+ public:
+  SingletonRefresher() {}
+  ~SingletonRefresher() {}
+
+  // Rebuilds the instances that are already created, in order of binding.
+  // This must not be called after the injector is deleted.
+  void Refresh();
+
+ private:
+  template <typename T>
+  friend class internal::RefreshingSingletonProvider;  // AddToRefreshList()
+
+  // Called from Init() of the providers, which is called after binding or,
+  // for the bindings of a deferred module, when the module is installed.
+  void AddToRefreshList(internal::RefreshInterface* refresh) {
+    internal::MutexLock lock(&mu_);
+    refresh_list_.push_back(refresh);
+  }
+
+  // Returns a copy of refresh_list_, hence a refresh that installs a
+  // deferred module does not add to the list being iterated.
+  std::vector<internal::RefreshInterface*> GetRefreshList();
+
+  internal::Mutex mu_;
+  std::vector<internal::RefreshInterface*> refresh_list_;  // Guarded by mu_
+
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(SingletonRefresher);
+};
+
+GUICPP_INJECTABLE(SingletonRefresher);
+
+
+// Implementation
+
+namespace internal {
+// This class implements refreshing singleton scope. Like
+// LazySingletonProvider, it creates the instance on first call to Get(). On
+// Refresh(), it creates a new instance and swaps it with the current one.
+//
+// Get() returns a SwappableRef, and a replaced instance is deleted along
+// with the last SwappableRef to it (see SwappablePointer).
+template <typename T>
+class RefreshingSingletonProvider
+    : public AbstractScopeProvider<T, SwappableRef<T> >,
+      public RefreshInterface {
+ public:
+  // Refresh() rebuilds the instance only if "period_nanos" have passed since
+  // it was created or last rebuilt.
+  explicit RefreshingSingletonProvider(uint64 period_nanos)
+      : period_nanos_(period_nanos),
+        last_rebuild_nanos_(0),
+        object_(NULL, DeletePointer()),
+        refresh_state_(new RefreshState(this)) {}
+
+  ~RefreshingSingletonProvider() {
+    // Cleanup must be called before deleting RefreshingSingletonProvider.
+    GUICPP_DCHECK_(object_.Get().get() == NULL);
+
+    // Rebuilds scheduled after Cleanup(), if any, do nothing.
+    DetachRefreshState();
+    ReleaseRefreshState(refresh_state_);
+  }
+
+  SwappableRef<T> Get() {
+    SwappableRef<T> object = object_.Get();
+    if (object.get() == NULL) {
+      once_.Init(&Create, this);  // Creates object the first time.
+      object = object_.Get();
+    }
+
+    return object;
+  }
+
+  // Waits for a running rebuild, and drops the reference to the current
+  // instance; It is deleted unless a reader still holds it.
+  void Cleanup() {
+    DetachRefreshState();
+    object_.Replace(NULL);
+  }
+
+  // Rebuilds the instance on the executor bound with RefreshExecutor label,
+  // or here if there is no such executor.
+  void Refresh() {
+    if (object_.Get().get() == NULL) {
+      return;  // The first Get() creates it.
+    }
+
+    {
+      MutexLock lock(&period_mu_);
+      const uint64 now_nanos = GetMonotonicNanos();
+      if (now_nanos - last_rebuild_nanos_ < period_nanos_) {
+        return;
+      }
+
+      // Set when the rebuild starts, hence a slow rebuild is not scheduled
+      // again by the refreshes that come meanwhile.
+      last_rebuild_nanos_ = now_nanos;
+    }
+
+    Executor* executor =
+        internal::FindBoundExecutor<RefreshExecutor>(this->injector());
+
+    if (executor == NULL) {
+      Rebuild();
+      return;
+    }
+
+    {
+      MutexLock lock(&refresh_state_->mu);
+      ++refresh_state_->num_refs;
+    }
+
+    executor->Schedule(new RebuildClosure(refresh_state_));
+  }
+
+ private:
+  // Shared by the provider and the rebuilds scheduled on the executor,
+  // which may run after the injector (and this provider) is deleted. The
+  // last one to release it deletes it.
+  struct RefreshState {
+    explicit RefreshState(RefreshingSingletonProvider* provider)
+        : provider(provider), num_refs(1) {}
+
+    Mutex mu;
+
+    // NULL once detached; Guarded by mu.
+    RefreshingSingletonProvider* provider;
+    int num_refs;  // Guarded by mu.
+  };
+
+  // Closure that calls provider->Rebuild(), used to rebuild on executor.
+  class RebuildClosure: public Closure {
+   public:
+    explicit RebuildClosure(RefreshState* state): state_(state) {}
+
+    // Released here rather than in Run(), so that it is released even if the
+    // executor deletes the closure without running it.
+    ~RebuildClosure() {
+      RefreshingSingletonProvider::ReleaseRefreshState(state_);
+    }
+
+    // Holds the lock while rebuilding, hence Cleanup() waits for it.
+    void Run() {
+      MutexLock lock(&state_->mu);
+      if (state_->provider != NULL) {
+        state_->provider->Rebuild();
+      }
+    }
+
+   private:
+    RefreshState* const state_;
+  };
+
+  static void ReleaseRefreshState(RefreshState* state) {
+    bool is_last;
+    {
+      MutexLock lock(&state->mu);
+      is_last = (--state->num_refs == 0);
+    }
+
+    if (is_last) {
+      delete state;
+    }
+  }
+
+  void DetachRefreshState() {
+    MutexLock lock(&refresh_state_->mu);
+    refresh_state_->provider = NULL;
+  }
+
+  // Registers this provider with the SingletonRefresher of the injector,
+  // bound along with the first refreshing singleton.
+  void Init(const Injector* injector) {
+    injector->Get<SingletonRefresher*>()->AddToRefreshList(this);
+  }
+
+  // This is supposed to be called only once.
+  static void Create(RefreshingSingletonProvider* provider) {
+    {
+      MutexLock lock(&provider->period_mu_);
+      provider->last_rebuild_nanos_ = GetMonotonicNanos();
+    }
+
+    provider->object_.Replace(provider->CreateUnscoped());
+    provider->AddToCleanupList();
+  }
+
+  // Creates a new instance and publishes it, dropping the reference to the
+  // current one.
+  void Rebuild() {
+    // The new instance is created without holding the lock, readers
+    // continue to get the current instance meanwhile.
+    object_.Replace(this->CreateUnscoped());
+  }
+
+  const uint64 period_nanos_;
+
+  Mutex period_mu_;
+  uint64 last_rebuild_nanos_;  // Guarded by period_mu_
+
+  GoogleOnceDynamic once_;
+
+  SwappablePointer<T, DeletePointer> object_;
+  RefreshState* const refresh_state_;
+
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(RefreshingSingletonProvider);
+};
+
+// Binds SwappableRef<T> annotated with L to a RefreshingSingletonProvider,
+// and binds SingletonRefresher along with the first refreshing singleton.
+template<typename L, typename T>
+inline void BindToRefreshingSingleton(Binder* binder, uint64 period_nanos) {
+  if (!binder->IsBound<SingletonRefresher>()) {
+    binder->BindToInstance<SingletonRefresher>(new SingletonRefresher(),
+                                               DeletePointer());
+  }
+
+  binder->BindValueToScopeProvider<guicpp::At<L, SwappableRef<T> > >(
+      new RefreshingSingletonProvider<T>(period_nanos));
+}
+
+}  // namespace internal
+
+
+template<typename L, typename T>
+inline void RefreshingSingleton::ConfigureScope(Binder* binder) {
+  internal::BindToRefreshingSingleton<L, T>(binder, 0);
+}
+
+template <int kPeriodSeconds>
+template<typename L, typename T>
+inline void RefreshingSingletonWithPeriod<kPeriodSeconds>::ConfigureScope(
+    Binder* binder) {
+  internal::BindToRefreshingSingleton<L, T>(
+      binder, static_cast<uint64>(kPeriodSeconds) * 1000000000ULL);
+}
+
+}  // namespace guicpp
+
+#endif  // GUICPP_REFRESHING_SINGLETON_H_
@@ -0,0 +1,341 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// This file defines the interface used to implement custom scopes.
+//
+// Use Case:
+//  LazySingleton keeps one instance per injector. Some applications need
+//  instances with a different life time, for example one instance per
+//  connection, per session or per shard. Such scopes can be implemented
+//  outside Guic++ using AbstractScopeProvider; The scopes of Guic++ (see
+//  singleton.h and prototype.h) are implemented the same way.
+//
+// Usage:
+//  1. Implement the provider of the scope by inheriting from
+//     AbstractScopeProvider<T>. Get() must return the instance of the current
+//     scope, creating it with CreateUnscoped() when there is none.
+//
+//     Each binding to a scope gets a slot index, unique within the injector
+//     and dense (the indices are 0, 1, 2... in order of binding), so a scope
+//     can keep its instances in an array instead of a map. For scopes whose
+//     instances live as long as the injector, the injector also owns one
+//     cache line aligned slot per binding (see slot()).
+//
+//     Example:
+//      // Session holds one pointer per scoped binding, indexed by slot.
+//      template <typename T>
+//      class PerSessionProvider: public guicpp::AbstractScopeProvider<T> {
+//       public:
+//        T* Get() {
+//          void*& instance = Session::Current()->Slot(this->slot_index());
+//          if (instance == NULL) {
+//            instance = this->CreateUnscoped();
+//          }
+//          return static_cast<T*>(instance);
+//        }
+//      };
+//
+//  2. Implement the scope, a class with a template static method called
+//     ConfigureScope() that binds T (annotated with L) to the provider using
+//     Binder::BindToScopeProvider().
+//
+//      class PerSession {
+//       public:
+//        template <typename L, typename T>
+//        static void ConfigureScope(guicpp::Binder* binder) {
+//          binder->BindToScopeProvider<guicpp::At<L, T> >(
+//              new PerSessionProvider<T>());
+//        }
+//      };
+//
+//  3. Bind types to the scope.
+//
+//      binder->BindToScope<ShoppingCart, PerSession>();
+//
+//     Note: guicpp::CreateInjector() must be used to create the injector.
+
+#ifndef GUICPP_SCOPE_H_
+#define GUICPP_SCOPE_H_
+
+#include <vector>
+
+#include "guicpp/internal/guicpp_port.h"
+#include "guicpp/guicpp_annotations.h"
+#include "guicpp/guicpp_at.h"
+#include "guicpp/guicpp_injector.h"
+#include "guicpp/guicpp_macros.h"
+#include "guicpp/guicpp_provider.h"
+#include "guicpp/guicpp_tools.h"
+
+namespace guicpp {
+struct SingletonCreationStats;  // Defined in singleton.h
+
+// Storage of one scoped binding, owned by the injector (see slot() below). A
+// slot holds one pointer and is aligned and padded to a cache line, so that
+// the slots of different bindings never share a cache line.
+class ScopeSlot {
+ public:
+  ScopeSlot(): value_(NULL) {}
+
+  void* value() const { return value_; }
+  void set_value(void* value) { value_ = value; }
+
+  // Same as above, but the value is loaded with acquire semantics and
+  // stored with release semantics (see AcquireLoad() in port.h), hence a
+  // value published by one thread can be read by others without a lock.
+  void* AcquireValue() const { return AcquireLoad(&value_); }
+  void ReleaseValue(void* value) { ReleaseStore(&value_, value); }
+
+ private:
+  void* value_;
+  char padding_[internal::kCacheLineSize - sizeof(void*)];
+
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(ScopeSlot);
+};
+
+namespace internal {
+class UnScoped: public Label {};
+
+class SetupInterface {
+ public:
+  virtual ~SetupInterface() {}
+
+  virtual void Init(const Injector* injector) = 0;
+  virtual void Cleanup() = 0;
+
+  // Singleton providers fill "stats" and return true, see
+  // GetSingletonCreationStats().
+  virtual bool GetCreationStats(SingletonCreationStats* /* stats */) const {
+    return false;
+  }
+
+ protected:
+  SetupInterface() {}
+};
+
+
+// This context implements Init() and Cleanup() methods that are
+// called from guicpp::CreateInjector().
+class ScopeSetupContext {
+ public:
+  explicit ScopeSetupContext(TeardownPolicy teardown_policy = FULL_TEARDOWN)
+      : injector_(NULL),
+        teardown_policy_(teardown_policy),
+        cleanup_list_size_(0) {}
+  ~ScopeSetupContext();
+
+  TeardownPolicy teardown_policy() const { return teardown_policy_; }
+
+  // Returns the injector passed to Init(), or NULL if Init() is not called.
+  const Injector* injector() const { return injector_; }
+
+  // Calls Init() methods of all providers in init_list_ in order.
+  void Init(const Injector* injector);
+
+  // Calls Cleanup() methods of all providers in cleanup_list_
+  // in reverse order.
+  void Cleanup();
+
+  // AddToInitList() is called while binding, which includes installing a
+  // deferred module concurrently with injection; Hence, it is protected with
+  // lock.
+  //
+  // Init() are called in order of their addition to init_list_. If Init()
+  // of this context is already called (when a deferred module is installed),
+  // Init() of "init" is called immediately.
+  void AddToInitList(SetupInterface* init);
+
+  // Not protected with locks. The caller holds lock when necessary.
+  void InvokeInitNow(SetupInterface* init) {
+    GUICPP_DCHECK_(injector_) << "Injector cant be null at this time";
+    init->Init(injector_);
+  }
+
+  // AddToCleanupList() is called when objects are instantiated which can
+  // happen from different threads. Hence, it is protected with lock.
+  //
+  // It is an error to add a provider to cleanup list if the same provider is
+  // not there in init_list_. This is because we assume size of cleanup_list_
+  // can not exceed size of init_list_. This lets us implement cleanup_list_
+  // using an array.
+  //
+  // Cleanup() are called in reverse order of their addition to list.
+  void AddToCleanupList(SetupInterface* cleanup);
+
+  // Allocates a slot for a scoped binding and returns its index. Indices are
+  // dense; The n-th call returns n - 1. This is called only while binding
+  // (deferred modules are installed one at a time) and the slots are reached
+  // through the pointers kept by their providers; Hence, it is not protected
+  // by locks.
+  int AllocateSlot();
+
+  // Returns the slot at "index". The slot never moves, so the caller may
+  // keep the returned pointer for the life time of the context.
+  ScopeSlot* GetSlot(int index) const {
+    return slots_[index];
+  }
+
+  // Returns the number of slots allocated so far.
+  int num_slots() const {
+    return static_cast<int>(slots_.size());
+  }
+
+  // Appends the creation stats of the singleton providers in init_list_.
+  void GetCreationStats(vector<SingletonCreationStats>* stats) const;
+
+ private:
+  // Slots are allocated in blocks of kSlotsPerBlock contiguous slots. A
+  // block is never reallocated, so slots allocated after Init() (when a
+  // deferred module is installed) do not move the existing slots.
+  static const int kSlotsPerBlock = 16;
+
+  const Injector* injector_;
+  const TeardownPolicy teardown_policy_;
+
+  // init_list is implemented using vector because it is simple and
+  // populated only while binding. Guarded by mu_, as deferred modules add
+  // to it while it is read by GetCreationStats().
+  vector<SetupInterface*> init_list_;
+
+  // Cleanup list is implemented using an array. We can do so because
+  // the max size of list is known at initialization time. This gives
+  // performance benefit. The memory for the array is allocated in
+  // Init() method.
+  //
+  // TODO(bnmouli): if we change cleanup_list_size_ to atomic_int
+  // we don't need mutex.
+  mutable Mutex mu_;
+  scoped_array<SetupInterface*> cleanup_list_;
+  int cleanup_list_size_;
+
+  // Raw memory of the slot blocks, and the slots in order of their index.
+  vector<char*> slot_blocks_;
+  vector<ScopeSlot*> slots_;
+
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(ScopeSetupContext);
+};
+
+GUICPP_INJECTABLE(ScopeSetupContext);
+
+// Non-template part of AbstractScopeProvider.
+class ScopeProviderBase: public SetupInterface {
+ public:
+  virtual ~ScopeProviderBase() {}
+
+  // Allocates the slot of this provider and adds it to the init list of
+  // "context". Called from Binder::BindToScopeProvider().
+  void AttachToContext(ScopeSetupContext* context) {
+    GUICPP_DCHECK_(context_ == NULL) << "Provider is bound more than once";
+    context_ = context;
+    slot_index_ = context->AllocateSlot();
+    slot_ = context->GetSlot(slot_index_);
+    context->AddToInitList(this);
+  }
+
+  // Returns true if the instances returned by Get() are owned by the scope,
+  // live as long as the injector and are one of a fixed set (e.g. the
+  // instance of a singleton). Binder::Decorate() then creates the decorator
+  // once per instance, instead of once per request, and Binder::AddToSet()
+  // and Binder::AddToMap() do not delete the instances.
+  virtual bool HasStableInstances() const { return false; }
+
+ protected:
+  ScopeProviderBase(): context_(NULL), slot_index_(-1), slot_(NULL) {}
+
+  ScopeSetupContext* context_;
+  int slot_index_;
+  ScopeSlot* slot_;
+
+ private:
+  // The injector is taken from context_ when it is needed.
+  virtual void Init(const Injector* /* injector */) {}
+
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(ScopeProviderBase);
+};
+
+}  // namespace internal
+
+// Base class of the providers of custom scopes. T is the type provided. R
+// is the type returned by Get(), T* unless the scope hands out handles that
+// track the users of its instances (e.g. SwappableRef<T>, see
+// refreshing_singleton.h); Such a provider is bound to R using
+// Binder::BindValueToScopeProvider().
+template <typename T, typename R = T*>
+class AbstractScopeProvider: public AbstractProvider<R ()>,
+                             public internal::ScopeProviderBase {
+ public:
+  virtual ~AbstractScopeProvider() {}
+
+  // Returns the instance of the current scope. Called for every request of
+  // T, possibly from different threads.
+  virtual R Get() = 0;
+
+  // Deletes the instances owned by the scope. Called when the injector is
+  // deleted, only if AddToCleanupList() is called.
+  virtual void Cleanup() {}
+
+ protected:
+  AbstractScopeProvider() {}
+
+  // Index of this binding among the scoped bindings of the injector.
+  int slot_index() const {
+    return slot_index_;
+  }
+
+  // Number of scoped bindings in the injector, i.e. the bound of
+  // slot_index(). This may grow when a deferred module is installed.
+  int num_slots() const {
+    return context_->num_slots();
+  }
+
+  // Slot owned by the injector for this binding. Its value is NULL at first
+  // and is not touched by Guic++; The scope must synchronize its accesses.
+  ScopeSlot* slot() const {
+    return slot_;
+  }
+
+  // Returns the injector, or NULL if guicpp::CreateInjector() has not
+  // returned yet.
+  const Injector* injector() const {
+    return context_->injector();
+  }
+
+  // Returns the teardown policy the injector is created with, see tools.h.
+  TeardownPolicy teardown_policy() const {
+    return context_->teardown_policy();
+  }
+
+  // Creates a new instance of T, ignoring the scope. The caller owns it.
+  T* CreateUnscoped() const {
+    // If a type "T" is bound to a scope, a call to injector->Get<T*>() in
+    // its provider would lead to infinite recursion. To avoid it, the
+    // provider calls injector->Get<At<UnScoped, T*> >();
+    return injector()->template Get<At<internal::UnScoped, T*> >();
+  }
+
+  // Registers this provider for Cleanup(). Must be called at most once,
+  // typically after creating the first instance; Cleanup() of the providers
+  // is called in reverse order of registration.
+  void AddToCleanupList() {
+    context_->AddToCleanupList(this);
+  }
+
+ private:
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(AbstractScopeProvider);
+};
+
+}  // namespace guicpp
+
+#endif  // GUICPP_SCOPE_H_
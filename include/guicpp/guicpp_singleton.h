@@ -18,6 +18,29 @@
 // as follows:
 //   binder->BindToScope<Type, LazySingleton>();
 //
+// ProcessLifetimeSingleton is a variant of LazySingleton for instances that
+// are needed until the process exits, such as large in-memory indexes. With
+// FAST_TEARDOWN policy (see tools.h), these are not deleted when the injector
+// is deleted, which saves the time spent in destructors at exit:
+//   binder->BindToScope<Type, ProcessLifetimeSingleton>();
+//   ...
+//   injector = guicpp::CreateInjector(&module, guicpp::FAST_TEARDOWN);
+//
+// The destructor of such types must not do any work required at exit (e.g.
+// flushing a file); Register a cleanup action for such work using
+// Binder::AddCleanupAction(), cleanup actions are always called.
+//
+// Creation telemetry:
+//  The first request of a singleton creates the instance while concurrent
+//  requests wait for it. A slow instance (or one that creates other
+//  singletons) may hold up many threads. GetSingletonCreationStats() returns
+//  the time taken to create each instance and the time threads spent
+//  waiting for it:
+//    std::vector<guicpp::SingletonCreationStats> stats =
+//        guicpp::GetSingletonCreationStats(injector);
+//
+//  See warm_up_singleton.h to create such instances in the background.
+//
 // Implementation:
 //  This is completely independent of rest of Guic++ code and can
 //  be made a separate build target.
@@ -34,6 +57,8 @@
 #include "guicpp/guicpp_injector.h"
 #include "guicpp/guicpp_macros.h"
 #include "guicpp/guicpp_provider.h"
+#include "guicpp/guicpp_scope.h"
+#include "guicpp/guicpp_tools.h"
 
 namespace guicpp {
 // The types that are bound to LazySingleton are instantiated on the first
@@ -53,160 +78,192 @@ class LazySingleton {
   GUICPP_DISALLOW_IMPLICIT_CONSTRUCTORS_(LazySingleton);
 };
 
+// Same as LazySingleton, but the instances are not deleted with the injector
+// if the injector is created with FAST_TEARDOWN policy.
+class ProcessLifetimeSingleton {
+ public:
+  template<typename L, typename T>
+  static void ConfigureScope(Binder* binder);
 
-// Implementation
+ private:
+  GUICPP_DISALLOW_IMPLICIT_CONSTRUCTORS_(ProcessLifetimeSingleton);
+};
 
-namespace internal {
-class UnScoped: public Label {};
+// Telemetry of the creation of a singleton instance.
+struct SingletonCreationStats {
+  SingletonCreationStats();
 
-class SetupInterface {
- public:
-  virtual ~SetupInterface() {}
+  // bindId of the singleton, compare with InjectorUtil::GetBindId() to
+  // identify the bound type.
+  internal::TypeId bind_id;
 
-  virtual void Init(const Injector* injector) = 0;
-  virtual void Cleanup() = 0;
+  // True once the instance is created.
+  bool is_created;
 
- protected:
-  SetupInterface() {}
-};
+  // Time taken to create the instance, including the time taken to create
+  // its dependencies.
+  uint64 creation_nanos;
 
+  // Number of requests that waited for the instance being created by
+  // another thread, and the total time they waited.
+  int num_waiters;
+  uint64 wait_nanos;
 
-// This context implements Init() and Cleanup() methods that are
-// called from guicpp::CreateInjector().
-class ScopeSetupContext {
- public:
-  ScopeSetupContext(): injector_(NULL), cleanup_list_size_(0) {}
-  ~ScopeSetupContext() {}
-
-  // Calls Init() methods of all providers in init_list_ in order.
-  void Init(const Injector* injector);
-
-  // Calls Cleanup() methods of all providers in cleanup_list_
-  // in reverse order.
-  void Cleanup();
-
-  // AddToInitList() is called only while binding and hence it is not
-  // protected by locks.
-  //
-  // Init() are called in order of their addition to init_list_.
-  void AddToInitList(SetupInterface* init);
-
-  // Not protected with locks. The caller holds lock when necessary.
-  void InvokeInitNow(SetupInterface* init) {
-    GUICPP_DCHECK_(injector_) << "Injector cant be null at this time";
-    init->Init(injector_);
-  }
+  // Number of requests that did not wait and took a fallback path as the
+  // instance was not created yet, see WarmUpHandle::TryGet().
+  int num_fallbacks;
+};
 
-  // AddToCleanupList() is called when objects are instantiated which can
-  // happen from different threads. Hence, it is protected with lock.
-  //
-  // It is an error to add a provider to cleanup list if the same provider is
-  // not there in init_list_. This is because we assume size of cleanup_list_
-  // can not exceed size of init_list_. This lets us implement cleanup_list_
-  // using an array.
-  //
-  // Cleanup() are called in reverse order of their addition to list.
-  void AddToCleanupList(SetupInterface* cleanup);
+// Returns the creation stats of the instances bound to LazySingleton and
+// its variants, in order of binding. The injector must be created using
+// guicpp::CreateInjector().
+std::vector<SingletonCreationStats> GetSingletonCreationStats(
+    const Injector* injector);
 
- private:
-  const Injector* injector_;
-
-  // init_list is implemented using vector because it is simple and
-  // populated only during initialization.
-  vector<SetupInterface*> init_list_;
-
-  // Cleanup list is implemented using an array. We can do so because
-  // the max size of list is known at initialization time. This gives
-  // performance benefit. The memory for the array is allocated in
-  // Init() method.
-  //
-  // TODO(bnmouli): if we change cleanup_list_size_ to atomic_int
-  // we don't need mutex.
-  Mutex mu_;
-  scoped_array<SetupInterface*> cleanup_list_;
-  int cleanup_list_size_;
-
-  GUICPP_DISALLOW_COPY_AND_ASSIGN_(ScopeSetupContext);
-};
 
-GUICPP_INJECTABLE(ScopeSetupContext);
+// Implementation
 
+namespace internal {
 // This class implements lazy singleton scope. It creates a new instance of
 // type T on first call to Get(), and successive calls Get() will return the
-// same instance.
+// same instance. The instance is kept in the slot of the binding.
 //
 // For thread safety, this uses GoogleOnceDynamic to instantiate exactly once.
+// Once the instance is published in the slot, Get() does not touch the once;
+// Only the requests that find the instance missing are timed for telemetry.
 template <typename T>
-class LazySingletonProvider: public guicpp::AbstractProvider<T* ()>,
-                             public SetupInterface {
+class LazySingletonProvider: public AbstractScopeProvider<T> {
  public:
-  explicit LazySingletonProvider(ScopeSetupContext* context)
-      : context_(context), injector_(NULL), object_(NULL) {
-    context->AddToInitList(this);
-  }
+  // "bind_id" identifies the singleton in its creation stats. If
+  // "process_lifetime" is true, the object is not deleted on Cleanup() when
+  // the teardown policy of the injector is FAST_TEARDOWN.
+  explicit LazySingletonProvider(TypeId bind_id = NULL,
+                                 bool process_lifetime = false)
+      : bind_id_(bind_id), process_lifetime_(process_lifetime) {}
 
   ~LazySingletonProvider() {
     // Cleanup must be called before deleting LazySingletonProvider.
-    GUICPP_DCHECK_(object_ == NULL);
+    GUICPP_DCHECK_(this->slot() == NULL || this->slot()->value() == NULL);
   }
 
+  virtual bool HasStableInstances() const { return true; }
+
   T* Get() {
-    once_.Init(&Create, this);  // Creates object the first time it's called.
-    return object_;
+    void* object = this->slot()->AcquireValue();
+    if (object == NULL) {
+      WaitForCreation();  // Creates object the first time it's called.
+      object = this->slot()->AcquireValue();
+    }
+
+    return static_cast<T*>(object);
   }
 
-  void Init(const Injector* injector) {
-    // It is safe to invoke Init() as long as injector remains the same.
-    GUICPP_DCHECK_(injector_ == NULL || injector_ == injector);
-    injector_ = injector;
+  // Returns the instance if it is created, otherwise returns NULL without
+  // waiting and counts a fallback.
+  T* GetIfCreated() {
+    void* object = this->slot()->AcquireValue();
+    if (object != NULL) {
+      return static_cast<T*>(object);
+    }
+
+    MutexLock lock(&stats_mu_);
+    ++stats_.num_fallbacks;
+    return NULL;
   }
 
   void Cleanup() {
-    delete object_;
-    object_ = NULL;
+    T* object = static_cast<T*>(this->slot()->value());
+    this->slot()->set_value(NULL);
+
+    if (process_lifetime_ && this->teardown_policy() == FAST_TEARDOWN) {
+      return;  // Intentionally leaked, the process is exiting.
+    }
+
+    delete object;
+  }
+
+  bool GetCreationStats(SingletonCreationStats* stats) const {
+    MutexLock lock(&stats_mu_);
+    *stats = stats_;
+    stats->bind_id = bind_id_;
+    stats->is_created = (this->slot()->AcquireValue() != NULL);
+    return true;
   }
 
  private:
+  // Argument of Create(). "is_creator" is set if the calling thread runs
+  // Create(), and is left unset for the threads that wait for it.
+  struct CreateRequest {
+    LazySingletonProvider* provider;
+    bool is_creator;
+  };
+
+  // Creates the instance, or waits for the thread creating it.
+  void WaitForCreation() {
+    const uint64 start_nanos = GetMonotonicNanos();
+    CreateRequest request = { this, false };
+    once_.Init(&Create, &request);
+
+    if (!request.is_creator) {
+      const uint64 wait_nanos = GetMonotonicNanos() - start_nanos;
+      MutexLock lock(&stats_mu_);
+      ++stats_.num_waiters;
+      stats_.wait_nanos += wait_nanos;
+    }
+  }
+
   // This is supposed to be called only once.
-  static void Create(LazySingletonProvider* provider) {
-    // Ensure provider is initialized before proceeding with object creation.
-    provider->context_->InvokeInitNow(provider);
+  static void Create(CreateRequest* request) {
+    LazySingletonProvider* provider = request->provider;
+    request->is_creator = true;
+    const uint64 start_nanos = GetMonotonicNanos();
 
-    // If a type "T" is bound to LazySingleton, a call to injector->Get<T*>()
-    // in this provider, would lead to infinite recursion. To avoid it, the
-    // provider calls injector->Get<At<UnScoped, T*> >();
-    provider->object_ = provider->injector_->template Get<At<UnScoped, T*> >();
+    T* object = provider->CreateUnscoped();
 
     // Immediately after object is instantiated add self to cleanup list
     // in ScopeSetupContext which ensures that the singleton objects are
     // deleted in reverse order of creation.
-    provider->context_->AddToCleanupList(provider);
+    provider->AddToCleanupList();
+
+    {
+      MutexLock lock(&provider->stats_mu_);
+      provider->stats_.creation_nanos = GetMonotonicNanos() - start_nanos;
+    }
+
+    // T may be const, the slot holds a plain void*.
+    provider->slot()->ReleaseValue(
+        const_cast<void*>(static_cast<const void*>(object)));
   }
 
-  ScopeSetupContext* const context_;
+  const TypeId bind_id_;
+  const bool process_lifetime_;
 
   GoogleOnceDynamic once_;
-  const Injector* injector_;
-  T* object_;
+
+  mutable Mutex stats_mu_;
+  SingletonCreationStats stats_;  // Guarded by stats_mu_
 };
 
+// Binds T annotated with L to a LazySingletonProvider. Shared by
+// LazySingleton and ProcessLifetimeSingleton.
+template<typename L, typename T>
+inline void BindToLazySingleton(Binder* binder, bool process_lifetime) {
+  binder->BindToScopeProvider<guicpp::At<L, T> >(
+      new LazySingletonProvider<T>(
+          InjectorUtil::GetBindId<Annotations<L>, T*>(), process_lifetime));
+}
+
 }  // namespace internal
 
 
 template<typename L, typename T>
 inline void LazySingleton::ConfigureScope(Binder* binder) {
-  internal::ScopeSetupContext* context =
-      binder->GetBoundInstance<internal::ScopeSetupContext>();
-
-  if (context == NULL) {
-    GUICPP_LOG_(FATAL) << "Looks like you are using Injector::Create() to "
-        "create the injector. You must use use guicpp::CreateInjector() "
-        "for singleton scopes to work";
-    return;  // Unreachable
-  }
+  internal::BindToLazySingleton<L, T>(binder, false);
+}
 
-  binder->BindToProvider<guicpp::At<L, T> >(
-      new internal::LazySingletonProvider<T>(context), DeletePointer());
+template<typename L, typename T>
+inline void ProcessLifetimeSingleton::ConfigureScope(Binder* binder) {
+  internal::BindToLazySingleton<L, T>(binder, true);
 }
 
 }  // namespace guicpp
@@ -0,0 +1,300 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// This file defines StaticInjector, an injector whose bindings are resolved
+// at compile time.
+//
+// Use Case:
+//  Injector looks up the bind table and calls a virtual Get() method of the
+//  table entry for every object it creates. For latency critical components
+//  even that is too much. StaticInjector takes the bindings as template
+//  arguments and resolves them while compiling; StaticInjector<...>::Get()
+//  compiles to direct constructor calls, which can be inlined end to end.
+//  Missing bindings are compile errors instead of failures at runtime.
+//
+// Usage:
+//  1. Make the classes injectable using GUICPP_INJECT_CTOR as usual. Only the
+//     signature given to the macro is used; GUICPP_DEFINE is not required
+//     unless the class is also injected by the runtime injector.
+//
+//  2. Describe the bindings using StaticModule. The following are supported:
+//       StaticBind<Interface, Implementation>: same as Binder::Bind().
+//       StaticScope<T, LazySingleton>: same as Binder::BindToScope().
+//       StaticModule<...>: includes all the bindings of another module,
+//                          same as Binder::Install().
+//     Interface, Implementation and T may be annotated using At.
+//
+//       typedef guicpp::StaticModule<
+//           guicpp::StaticBind<SmsSender, RealSmsSender>,
+//           guicpp::StaticScope<RealSmsSender, guicpp::LazySingleton>
+//       > SmsModule;
+//
+//  3. Get instances using StaticInjector<Module>::Get(). Only pointers can be
+//     requested, either directly or as constructor arguments.
+//
+//       SmsSender* sender =
+//           guicpp::StaticInjector<SmsModule>::Get<SmsSender*>();
+//
+// Limitations:
+//   * Values, references, providers, factories and assisted arguments are
+//     not supported; Use Injector for these.
+//   * A StaticModule takes at most 8 bindings. Use nested modules for more.
+//   * Singletons are per StaticModule type (not per injector instance) and
+//     are deleted at program exit. Like LazySingleton, they are not created
+//     in a thread safe way unless the compiler guards function local statics.
+
+#ifndef GUICPP_STATIC_INJECTOR_H_
+#define GUICPP_STATIC_INJECTOR_H_
+
+#include "guicpp/internal/guicpp_port.h"
+#include "guicpp/guicpp_at.h"
+#include "guicpp/internal/guicpp_static_create_helpers.h"
+#include "guicpp/internal/guicpp_types.h"
+#include "guicpp/internal/guicpp_util.h"
+
+namespace guicpp {
+class LazySingleton;
+
+namespace internal {
+// Default value of StaticModule template arguments.
+class NoStaticBinding {};
+
+}  // namespace internal
+
+// Binds "Interface" to "Implementation" in a StaticModule.
+template <typename Interface, typename Implementation>
+class StaticBind {};
+
+// Binds "T" to "Scope" in a StaticModule. Only LazySingleton is supported.
+template <typename T, typename Scope>
+class StaticScope {};
+
+// Set of bindings used by StaticInjector. See the top of this file.
+template <typename B1 = internal::NoStaticBinding,
+          typename B2 = internal::NoStaticBinding,
+          typename B3 = internal::NoStaticBinding,
+          typename B4 = internal::NoStaticBinding,
+          typename B5 = internal::NoStaticBinding,
+          typename B6 = internal::NoStaticBinding,
+          typename B7 = internal::NoStaticBinding,
+          typename B8 = internal::NoStaticBinding>
+class StaticModule {};
+
+// Injector for the bindings in "Module" (a StaticModule), resolved at
+// compile time.
+template <typename Module>
+class StaticInjector {
+ public:
+  // Returns an instance of T according to the bindings in Module. T must be
+  // a pointer and may be annotated. Like Injector::Get(), the caller owns the
+  // returned instance unless it is bound to a scope.
+  template <typename T>
+  static typename internal::AtUtil::GetTypes<T>::ActualType Get();
+
+ private:
+  GUICPP_DISALLOW_IMPLICIT_CONSTRUCTORS_(StaticInjector);
+};
+
+namespace internal {
+// Identifies a binding. T is the pointed type without cv qualifiers.
+template <typename Annotations, typename T>
+class StaticKey {};
+
+// Gets the StaticKey of "T" used in StaticBind or StaticScope.
+template <typename T>
+struct StaticKeyOf {
+  typedef StaticKey<typename AtUtil::GetTypes<T>::Annotations,
+                    typename remove_cv<
+                        typename AtUtil::GetTypes<T>::ArgType>::type> Type;
+};
+
+// Looks up "Key" in binding B. Defines:
+//   Target: key bound to "Key", NoStaticBinding if B does not bind Key.
+//   num_bindings: number of bindings for Key in B.
+//   is_singleton: true if Key is bound to LazySingleton.
+//
+// This is not defined for unsupported bindings, which results in compile
+// error.
+template <typename B, typename Key>
+struct StaticBindingLookup;
+
+template <typename Key>
+struct StaticBindingLookup<NoStaticBinding, Key> {
+  typedef NoStaticBinding Target;
+  static const int num_bindings = 0;
+  static const bool is_singleton = false;
+};
+
+template <typename Interface, typename Implementation, typename Key>
+struct StaticBindingLookup<StaticBind<Interface, Implementation>, Key> {
+  static const bool kMatches =
+      is_same<typename StaticKeyOf<Interface>::Type, Key>::value;
+
+  typedef typename if_<kMatches,
+                       typename StaticKeyOf<Implementation>::Type,
+                       NoStaticBinding>::type Target;
+  static const int num_bindings = kMatches ? 1 : 0;
+  static const bool is_singleton = false;
+};
+
+template <typename T, typename Key>
+struct StaticBindingLookup<StaticScope<T, LazySingleton>, Key> {
+  typedef NoStaticBinding Target;
+  static const bool is_singleton =
+      is_same<typename StaticKeyOf<T>::Type, Key>::value;
+  static const int num_bindings = is_singleton ? 1 : 0;
+};
+
+// Returns Target1 if it is a binding, Target2 otherwise.
+template <typename Target1, typename Target2>
+struct StaticFirstTarget {
+  typedef typename if_<is_same<Target1, NoStaticBinding>::value,
+                       Target2, Target1>::type Type;
+};
+
+template <typename B1, typename B2, typename B3, typename B4,
+          typename B5, typename B6, typename B7, typename B8, typename Key>
+struct StaticBindingLookup<StaticModule<B1, B2, B3, B4, B5, B6, B7, B8>,
+                           Key> {
+  typedef StaticBindingLookup<B1, Key> L1;
+  typedef StaticBindingLookup<B2, Key> L2;
+  typedef StaticBindingLookup<B3, Key> L3;
+  typedef StaticBindingLookup<B4, Key> L4;
+  typedef StaticBindingLookup<B5, Key> L5;
+  typedef StaticBindingLookup<B6, Key> L6;
+  typedef StaticBindingLookup<B7, Key> L7;
+  typedef StaticBindingLookup<B8, Key> L8;
+
+  typedef typename StaticFirstTarget<typename L1::Target,
+          typename StaticFirstTarget<typename L2::Target,
+          typename StaticFirstTarget<typename L3::Target,
+          typename StaticFirstTarget<typename L4::Target,
+          typename StaticFirstTarget<typename L5::Target,
+          typename StaticFirstTarget<typename L6::Target,
+          typename StaticFirstTarget<typename L7::Target,
+          typename L8::Target>::Type>::Type>::Type>::Type>::Type>::Type>::Type
+      Target;
+
+  static const int num_bindings =
+      L1::num_bindings + L2::num_bindings + L3::num_bindings +
+      L4::num_bindings + L5::num_bindings + L6::num_bindings +
+      L7::num_bindings + L8::num_bindings;
+
+  static const bool is_singleton =
+      L1::is_singleton || L2::is_singleton || L3::is_singleton ||
+      L4::is_singleton || L5::is_singleton || L6::is_singleton ||
+      L7::is_singleton || L8::is_singleton;
+};
+
+// Returned by GuicppCtorSignature() for types that are not made injectable
+// using GUICPP_INJECT_CTOR. The signatures defined by inject macros are
+// always a better match than this.
+template <typename T>
+class StaticMissingCtor {};
+
+template <typename T>
+StaticMissingCtor<T> GuicppCtorSignature(TypeKey<T>);
+
+// Creates T using constructor, used for unbound types.
+template <typename StaticInjectorType, typename T>
+T* StaticCreate(StaticMissingCtor<T>) {
+  GUICPP_COMPILE_ASSERT_((is_same<T, StaticMissingCtor<T> >::value),
+                         type_is_neither_bound_nor_has_GUICPP_INJECT_CTOR);
+  return NULL;
+}
+
+template <typename StaticInjectorType, typename T, typename CtorFp>
+T* StaticCreate(TypeKey<CtorFp> fp) {
+  return StaticCreateHelpers<StaticInjectorType>::Create(fp);
+}
+
+// Provides instance for Key according to bindings in Module.
+template <typename Module, typename Key,
+          typename Target =
+              typename StaticBindingLookup<Module, Key>::Target,
+          bool is_singleton = StaticBindingLookup<Module, Key>::is_singleton>
+class StaticProvider;
+
+// Key is bound to Target.
+template <typename Module, typename Annotations, typename T, typename Target,
+          bool is_singleton>
+class StaticProvider<Module, StaticKey<Annotations, T>, Target, is_singleton> {
+ public:
+  static T* Get() {
+    GUICPP_COMPILE_ASSERT_((StaticBindingLookup<
+                               Module, StaticKey<Annotations, T> >::
+                               num_bindings == 1),
+                           duplicate_static_binding);
+    return StaticProvider<Module, Target>::Get();
+  }
+};
+
+// Key is not bound, creates a new instance using constructor.
+template <typename Module, typename Annotations, typename T>
+class StaticProvider<Module, StaticKey<Annotations, T>, NoStaticBinding,
+                     false> {
+ public:
+  static T* Get() {
+    return StaticCreate<StaticInjector<Module>, T>(
+        GuicppCtorSignature(TypeKey<T>()));
+  }
+};
+
+// Key is bound to LazySingleton, the instance is created on first call
+// and deleted at program exit.
+template <typename Module, typename Annotations, typename T>
+class StaticProvider<Module, StaticKey<Annotations, T>, NoStaticBinding,
+                     true> {
+ public:
+  static T* Get() {
+    GUICPP_COMPILE_ASSERT_((StaticBindingLookup<
+                               Module, StaticKey<Annotations, T> >::
+                               num_bindings == 1),
+                           duplicate_static_binding);
+    static scoped_ptr<T> instance(StaticCreate<StaticInjector<Module>, T>(
+        GuicppCtorSignature(TypeKey<T>())));
+    return instance.get();
+  }
+};
+
+// Gets an instance of requested pointer type "P".
+template <typename Module, typename Annotations, typename P>
+struct StaticPointerGetter {
+  static P Get() {
+    GUICPP_COMPILE_ASSERT_(is_pointer<P>::value,
+                           static_injector_can_inject_only_pointers);
+    typedef typename remove_cv<typename remove_pointer<P>::type>::type T;
+    return StaticProvider<Module, StaticKey<Annotations, T> >::Get();
+  }
+};
+
+}  // namespace internal
+
+// -- Implementation --
+
+template <typename Module>
+template <typename T>
+typename internal::AtUtil::GetTypes<T>::ActualType
+StaticInjector<Module>::Get() {
+  typedef typename internal::AtUtil::GetTypes<T>::Annotations Annotations;
+  typedef typename internal::AtUtil::GetTypes<T>::ActualType ActualType;
+
+  return internal::StaticPointerGetter<Module, Annotations, ActualType>::Get();
+}
+
+}  // namespace guicpp
+
+#endif  // GUICPP_STATIC_INJECTOR_H_
@@ -0,0 +1,255 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// This file declares SwappableInstance, the handle returned by
+// Binder::BindToSwappableInstance(), and SwappableRef, the ref-counted
+// pointer injected for the bound type.
+//
+// Use Case:
+//  An instance bound using BindToInstance() can not be replaced once the
+//  injector is created. Some instances need to be replaced while the
+//  application is running, for example a ContactDatabase that is reloaded
+//  when the file changes.
+//
+// Usage:
+//  Bind the type using BindToSwappableInstance() and keep the handle it
+//  returns. The handle is owned by the injector.
+//
+//    class ContactModule: public guicpp::Module {
+//     public:
+//      void Configure(guicpp::Binder* binder) const {
+//        *handle_ = binder->BindToSwappableInstance<ContactDatabase>(
+//            ContactDatabase::Load(kPath), guicpp::DeletePointer());
+//      }
+//      ...
+//    };
+//
+//    // Users inject SwappableRef<ContactDatabase>, not ContactDatabase*.
+//    class ContactLookup {
+//     public:
+//      GUICPP_INJECT(ContactLookup,
+//                    guicpp::Provider<
+//                        guicpp::SwappableRef<ContactDatabase> >* provider);
+//      ...
+//    };
+//
+//    // Later, after reloading the file.
+//    contact_database_handle->Swap(ContactDatabase::Load(kPath));
+//
+//  Requests to the injector after Swap() get the new instance, including the
+//  instances injected to the constructors. Instances already injected are
+//  not updated; Users that need the latest instance must get it from the
+//  injector (or a provider) when it is needed.
+//
+// Life time of instances:
+//  Every SwappableRef holds a reference to the instance it points to. The
+//  cleanup action is taken on a replaced instance when its last reference
+//  is dropped, i.e. when the injector no longer returns it and no user holds
+//  a SwappableRef to it. Requests to the injector take a shared lock only
+//  to add a reference; Swap() takes it only to exchange the instance.
+
+#ifndef GUICPP_SWAPPABLE_INSTANCE_H_
+#define GUICPP_SWAPPABLE_INSTANCE_H_
+
+#include <stddef.h>
+
+#include <algorithm>
+
+#include "guicpp/guicpp_macros.h"
+#include "guicpp/internal/guicpp_port.h"
+
+namespace guicpp {
+namespace internal {
+// Reference count of an instance bound using BindToSwappableInstance().
+// The instance is cleaned up, and the count deleted, with the last
+// reference. References may be added and released by different threads.
+class SwappableRefCount {
+ public:
+  void AddRef() {
+    AtomicIncrement(&num_refs_, 1);
+  }
+
+  void Release() {
+    if (AtomicIncrement(&num_refs_, -1) == 0) {
+      CleanupInstance();
+      delete this;
+    }
+  }
+
+ protected:
+  // Starts with one reference, owned by the creator.
+  SwappableRefCount(): num_refs_(1) {}
+  virtual ~SwappableRefCount() {}
+
+ private:
+  // Takes the cleanup action on the instance.
+  virtual void CleanupInstance() = 0;
+
+  int32 num_refs_;
+
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(SwappableRefCount);
+};
+
+}  // namespace internal
+
+// Ref-counted pointer to an instance bound using BindToSwappableInstance(),
+// see the comments above. The instance stays valid as long as a copy is
+// held, even after it is swapped out. Copies may be made and deleted by
+// different threads.
+template <typename T>
+class SwappableRef {
+ public:
+  SwappableRef(): ptr_(NULL), ref_count_(NULL) {}
+
+  // Adds a reference to "ref_count", which counts the references to "ptr".
+  SwappableRef(T* ptr, internal::SwappableRefCount* ref_count)
+      : ptr_(ptr), ref_count_(ref_count) {
+    if (ref_count_ != NULL) {
+      ref_count_->AddRef();
+    }
+  }
+
+  SwappableRef(const SwappableRef& other)
+      : ptr_(other.ptr_), ref_count_(other.ref_count_) {
+    if (ref_count_ != NULL) {
+      ref_count_->AddRef();
+    }
+  }
+
+  ~SwappableRef() {
+    if (ref_count_ != NULL) {
+      ref_count_->Release();
+    }
+  }
+
+  SwappableRef& operator=(const SwappableRef& other) {
+    SwappableRef copy(other);
+    std::swap(ptr_, copy.ptr_);
+    std::swap(ref_count_, copy.ref_count_);
+    return *this;
+  }
+
+  T* get() const { return ptr_; }
+  T* operator->() const { return ptr_; }
+  T& operator*() const { return *ptr_; }
+
+ private:
+  T* ptr_;
+  internal::SwappableRefCount* ref_count_;
+};
+
+template <typename T>
+GUICPP_TEMPLATE_INJECTABLE((SwappableRef<T>));
+
+namespace internal {
+// Reference count of a pointer held by SwappablePointer. Takes the cleanup
+// action on the pointer along with the last reference.
+template <typename T, typename CleanupAction>
+class SwappablePointerRefCount: public SwappableRefCount {
+ public:
+  SwappablePointerRefCount(T* ptr, CleanupAction cleanup_action)
+      : ptr_(ptr), cleanup_action_(cleanup_action) {}
+
+  T* ptr() const { return ptr_; }
+
+ private:
+  virtual ~SwappablePointerRefCount() {}
+
+  virtual void CleanupInstance() {
+    cleanup_action_(ptr_);
+  }
+
+  T* const ptr_;
+  CleanupAction cleanup_action_;
+
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(SwappablePointerRefCount);
+};
+
+// Holds a pointer that is replaced while readers use it, such as a
+// swappable instance or the instance of a refreshing singleton, and hands
+// out SwappableRefs to it. This holds one reference to the current pointer;
+// Cleanup action is taken on a replaced pointer once the SwappableRefs
+// returned for it are dropped too. The lock is held only to add a reference
+// or to exchange the pointer.
+template <typename T, typename CleanupAction>
+class SwappablePointer {
+ public:
+  // "ptr" may be NULL, in which case Get() returns a NULL SwappableRef.
+  SwappablePointer(T* ptr, CleanupAction cleanup_action)
+      : cleanup_action_(cleanup_action), current_(NewRefCount(ptr)) {}
+
+  ~SwappablePointer() {
+    Replace(NULL);
+  }
+
+  SwappableRef<T> Get() const {
+    ReaderMutexLock lock(&mu_);
+    if (current_ == NULL) {
+      return SwappableRef<T>();
+    }
+
+    return SwappableRef<T>(current_->ptr(), current_);
+  }
+
+  // Publishes "ptr" (or NULL) and drops the reference to the replaced one.
+  void Replace(T* ptr) {
+    RefCountType* replaced = NewRefCount(ptr);
+    {
+      WriterMutexLock lock(&mu_);
+      std::swap(current_, replaced);
+    }
+
+    // Outside the lock, as it may take the cleanup action.
+    if (replaced != NULL) {
+      replaced->Release();
+    }
+  }
+
+ private:
+  typedef SwappablePointerRefCount<T, CleanupAction> RefCountType;
+
+  RefCountType* NewRefCount(T* ptr) const {
+    return ptr == NULL ? NULL : new RefCountType(ptr, cleanup_action_);
+  }
+
+  const CleanupAction cleanup_action_;
+  mutable Mutex mu_;  // Guards current_.
+  RefCountType* current_;
+
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(SwappablePointer);
+};
+
+}  // namespace internal
+
+// Handle to replace an instance bound using BindToSwappableInstance().
+template <typename T>
+class SwappableInstance {
+ public:
+  // Replaces the bound instance with "ptr". The cleanup action passed to
+  // BindToSwappableInstance() is taken on the replaced instance once the
+  // last SwappableRef to it is dropped, which may be during this call.
+  virtual void Swap(T* ptr) = 0;
+
+ protected:
+  SwappableInstance() {}
+  virtual ~SwappableInstance() {}
+
+ private:
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(SwappableInstance);
+};
+
+}  // namespace guicpp
+
+#endif  // GUICPP_SWAPPABLE_INSTANCE_H_
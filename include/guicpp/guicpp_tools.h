@@ -24,8 +24,24 @@
 namespace guicpp {
 class Module;
 
+// Decides which instances are deleted when the injector is deleted.
+enum TeardownPolicy {
+  // All the instances owned by the injector are deleted. This is the default
+  // and must be used when the injector is deleted before the process exits,
+  // and under leak checkers.
+  FULL_TEARDOWN,
+
+  // Instances bound to ProcessLifetimeSingleton (see singleton.h) are not
+  // deleted; Use this when the injector is deleted only at exit. Cleanup
+  // actions and all the other instances are deleted as in FULL_TEARDOWN.
+  FAST_TEARDOWN
+};
+
 Injector* CreateInjector(const Module* module);
 
+// Same as above, with the given teardown policy.
+Injector* CreateInjector(const Module* module, TeardownPolicy policy);
+
 }  // namespace guicpp
 
 #endif  // GUICPP_TOOLS_H_
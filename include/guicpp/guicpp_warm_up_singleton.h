@@ -0,0 +1,183 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// This file defines the WarmUpSingleton scope.
+//
+// Use Case:
+//  The first request of a LazySingleton creates the instance, and all the
+//  requests that arrive meanwhile wait for it. If the instance is slow to
+//  create (e.g. it loads a model), a burst of requests on a cold server
+//  stalls behind it; Worse, if it creates other singletons, the requests
+//  for those wait too. GetSingletonCreationStats() (see singleton.h) shows
+//  how long the requests wait.
+//
+//  WarmUpSingleton creates the instance on a dedicated warm-up executor as
+//  soon as the injector is created. Requests that can not wait use
+//  WarmUpHandle::TryGet(), which returns NULL instead of waiting while the
+//  instance is being created, and take a fallback path (e.g. serve a
+//  degraded response).
+//
+// Usage:
+//  1. Bind the type to WarmUpSingleton scope.
+//
+//       binder->BindToScope<SpellModel, guicpp::WarmUpSingleton>();
+//
+//     Note: guicpp::CreateInjector() must be used to create the injector.
+//
+//  2. Bind an executor with label guicpp::WarmUpExecutor (see executor.h).
+//     The instances are created on this executor, in order of binding.
+//
+//       binder->BindToInstance<
+//           guicpp::At<guicpp::WarmUpExecutor, guicpp::Executor> >(
+//               executor, guicpp::DoNothing());
+//
+//     Without this executor, WarmUpSingleton is same as LazySingleton and
+//     TryGet() is same as Get().
+//
+//  3. Inject the type as usual to wait for the instance, or inject
+//     WarmUpHandle<T> (with the same labels as T) to opt into the fallback.
+//
+//       GUICPP_INJECT_CTOR(SpellChecker, (
+//           guicpp::WarmUpHandle<SpellModel>* model));
+//       ...
+//       SpellModel* model = model_->TryGet();
+//       if (model == NULL) {
+//         return CheckWithDictionaryOnly(text);
+//       }
+//
+//     The handle is owned by the injector.
+//
+//  The executor must run all the scheduled closures before the injector is
+//  deleted.
+
+#ifndef GUICPP_WARM_UP_SINGLETON_H_
+#define GUICPP_WARM_UP_SINGLETON_H_
+
+#include "guicpp/internal/guicpp_port.h"
+#include "guicpp/guicpp_annotations.h"
+#include "guicpp/guicpp_at.h"
+#include "guicpp/guicpp_binder.h"
+#include "guicpp/guicpp_executor.h"
+#include "guicpp/guicpp_injector.h"
+#include "guicpp/guicpp_macros.h"
+#include "guicpp/guicpp_provider.h"
+#include "guicpp/guicpp_singleton.h"
+
+namespace guicpp {
+// Label used to bind the executor on which the instances of WarmUpSingleton
+// scope are created.
+class WarmUpExecutor: public Label {};
+
+// Scope of the types that are created on the warm-up executor when the
+// injector is created. Otherwise, it is same as LazySingleton.
+class WarmUpSingleton {
+ public:
+  template<typename L, typename T>
+  static void ConfigureScope(Binder* binder);
+
+ private:
+  GUICPP_DISALLOW_IMPLICIT_CONSTRUCTORS_(WarmUpSingleton);
+};
+
+// Non-blocking access to an instance of WarmUpSingleton scope.
+template <typename T>
+class WarmUpHandle {
+ public:
+  virtual ~WarmUpHandle() {}
+
+  // Returns the instance, or NULL if it is not created yet. Never waits for
+  // the warm-up executor; Each NULL is counted as a fallback in the creation
+  // stats of the singleton.
+  virtual T* TryGet() = 0;
+
+ protected:
+  WarmUpHandle() {}
+
+ private:
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(WarmUpHandle);
+};
+
+template <typename T>
+GUICPP_TEMPLATE_INJECTABLE((WarmUpHandle<T>));
+
+
+// Implementation
+
+namespace internal {
+// This class implements warm-up singleton scope. The instance is held the
+// same way as LazySingletonProvider holds it; On Init() this schedules a
+// closure that calls Get() on the warm-up executor. A request that comes
+// before the closure runs creates the instance itself (or waits for the
+// executor, if it is already creating it), same as with LazySingleton.
+template <typename T>
+class WarmUpSingletonProvider: public LazySingletonProvider<T>,
+                               public WarmUpHandle<T> {
+ public:
+  explicit WarmUpSingletonProvider(TypeId bind_id)
+      : LazySingletonProvider<T>(bind_id), executor_(NULL) {}
+
+  T* TryGet() {
+    if (executor_ == NULL) {
+      return this->Get();
+    }
+
+    return this->GetIfCreated();
+  }
+
+ private:
+  // Closure that creates the instance on the warm-up executor.
+  class WarmUpClosure: public Closure {
+   public:
+    explicit WarmUpClosure(WarmUpSingletonProvider* provider)
+        : provider_(provider) {}
+
+    void Run() {
+      provider_->Get();
+    }
+
+   private:
+    WarmUpSingletonProvider* const provider_;
+  };
+
+  void Init(const Injector* injector) {
+    executor_ = internal::FindBoundExecutor<WarmUpExecutor>(injector);
+    if (executor_ != NULL) {
+      executor_->Schedule(new WarmUpClosure(this));
+    }
+  }
+
+  Executor* executor_;
+
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(WarmUpSingletonProvider);
+};
+
+}  // namespace internal
+
+
+template<typename L, typename T>
+inline void WarmUpSingleton::ConfigureScope(Binder* binder) {
+  internal::WarmUpSingletonProvider<T>* provider =
+      new internal::WarmUpSingletonProvider<T>(
+          internal::InjectorUtil::GetBindId<internal::Annotations<L>, T*>());
+
+  // The handle is the provider itself, which is owned by the first binding.
+  binder->BindToScopeProvider<guicpp::At<L, T> >(provider);
+  binder->BindToInstance<guicpp::At<L, WarmUpHandle<T> > >(
+      provider, DoNothing());
+}
+
+}  // namespace guicpp
+
+#endif  // GUICPP_WARM_UP_SINGLETON_H_
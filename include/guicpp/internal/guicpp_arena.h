@@ -0,0 +1,79 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// This file declares the arena used to allocate bind table entries.
+
+#ifndef GUICPP_ARENA_H_
+#define GUICPP_ARENA_H_
+
+#include <stddef.h>
+
+#include <map>
+
+#include "guicpp/internal/guicpp_port.h"
+
+namespace guicpp {
+namespace internal {
+// Allocates memory from large blocks that are freed together when the arena
+// is deleted. Objects created in the arena must be destroyed explicitly
+// (by calling the destructor) before the arena is deleted.
+//
+// Arena is used by BindTable, which allocates many small entries while the
+// module is configured and frees all of them only when the injector is
+// deleted. Allocating them together avoids a separate heap allocation (and
+// the allocator overhead) per entry.
+class Arena {
+ public:
+  Arena();
+  ~Arena();  // No class should inherit from Arena.
+
+  // Returns "size" bytes of memory aligned for any type.
+  void* Allocate(size_t size);
+
+  // Returns true if ptr points to memory returned by Allocate().
+  bool Contains(const void* ptr) const;
+
+  // Returns the total size of the blocks allocated by the arena.
+  size_t bytes_reserved() const {
+    return bytes_reserved_;
+  }
+
+ private:
+  // Size of a block. Allocations larger than this get a block of their own.
+  static const size_t kBlockSize = 8192;
+
+  // Alignment of the memory returned by Allocate().
+  static const size_t kAlignment = 16;
+
+  // Allocates a new block of "size" bytes.
+  char* NewBlock(size_t size);
+
+  // Maps start of each block to its size.
+  map<const char*, size_t> blocks_;
+
+  // Unused part of the last block.
+  char* next_;
+  size_t available_;
+
+  size_t bytes_reserved_;
+
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(Arena);
+};
+
+}  // namespace internal
+}  // namespace guicpp
+
+#endif  // GUICPP_ARENA_H_
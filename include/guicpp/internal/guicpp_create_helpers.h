@@ -22,6 +22,8 @@
 #ifndef GUICPP_CREATE_HELPERS_H_
 #define GUICPP_CREATE_HELPERS_H_
 
+#include <new>
+
 #include "guicpp/internal/guicpp_port.h"
 #include "guicpp/internal/guicpp_inject_util.h"
 #include "guicpp/internal/guicpp_types.h"
@@ -184,6 +186,169 @@ class CreateHelpers {
       inject_util.GetWithContext<A10>(local_context));
   }
 
+  // Same as Create(), but constructs the object in "storage" using placement
+  // new. "storage" must be large enough and suitably aligned for T.
+  template <typename T>
+  static T* Emplace(void* storage,
+                    const Injector* injector,
+                    const LocalContext* local_context,
+                    TypeKey<T* (*)()> fp) {
+    return new (storage) T();
+  }
+
+  template <typename T, typename A1>
+  static T* Emplace(void* storage,
+                    const Injector* injector,
+                    const LocalContext* local_context,
+                    TypeKey<T* (*)(A1)> fp) {
+    InjectorUtil inject_util(injector);
+    return new (storage) T(
+      inject_util.GetWithContext<A1>(local_context));
+  }
+
+  template <typename T, typename A1, typename A2>
+  static T* Emplace(void* storage,
+                    const Injector* injector,
+                    const LocalContext* local_context,
+                    TypeKey<T* (*)(A1, A2)> fp) {
+    InjectorUtil inject_util(injector);
+    return new (storage) T(
+      inject_util.GetWithContext<A1>(local_context),
+      inject_util.GetWithContext<A2>(local_context));
+  }
+
+  template <typename T, typename A1, typename A2, typename A3>
+  static T* Emplace(void* storage,
+                    const Injector* injector,
+                    const LocalContext* local_context,
+                    TypeKey<T* (*)(A1, A2, A3)> fp) {
+    InjectorUtil inject_util(injector);
+    return new (storage) T(
+      inject_util.GetWithContext<A1>(local_context),
+      inject_util.GetWithContext<A2>(local_context),
+      inject_util.GetWithContext<A3>(local_context));
+  }
+
+  template <typename T, typename A1, typename A2, typename A3, typename A4>
+  static T* Emplace(void* storage,
+                    const Injector* injector,
+                    const LocalContext* local_context,
+                    TypeKey<T* (*)(A1, A2, A3, A4)> fp) {
+    InjectorUtil inject_util(injector);
+    return new (storage) T(
+      inject_util.GetWithContext<A1>(local_context),
+      inject_util.GetWithContext<A2>(local_context),
+      inject_util.GetWithContext<A3>(local_context),
+      inject_util.GetWithContext<A4>(local_context));
+  }
+
+  template <typename T, typename A1, typename A2, typename A3, typename A4,
+      typename A5>
+  static T* Emplace(void* storage,
+                    const Injector* injector,
+                    const LocalContext* local_context,
+                    TypeKey<T* (*)(A1, A2, A3, A4, A5)> fp) {
+    InjectorUtil inject_util(injector);
+    return new (storage) T(
+      inject_util.GetWithContext<A1>(local_context),
+      inject_util.GetWithContext<A2>(local_context),
+      inject_util.GetWithContext<A3>(local_context),
+      inject_util.GetWithContext<A4>(local_context),
+      inject_util.GetWithContext<A5>(local_context));
+  }
+
+  template <typename T, typename A1, typename A2, typename A3, typename A4,
+      typename A5, typename A6>
+  static T* Emplace(void* storage,
+                    const Injector* injector,
+                    const LocalContext* local_context,
+                    TypeKey<T* (*)(A1, A2, A3, A4, A5, A6)> fp) {
+    InjectorUtil inject_util(injector);
+    return new (storage) T(
+      inject_util.GetWithContext<A1>(local_context),
+      inject_util.GetWithContext<A2>(local_context),
+      inject_util.GetWithContext<A3>(local_context),
+      inject_util.GetWithContext<A4>(local_context),
+      inject_util.GetWithContext<A5>(local_context),
+      inject_util.GetWithContext<A6>(local_context));
+  }
+
+  template <typename T, typename A1, typename A2, typename A3, typename A4,
+      typename A5, typename A6, typename A7>
+  static T* Emplace(void* storage,
+                    const Injector* injector,
+                    const LocalContext* local_context,
+                    TypeKey<T* (*)(A1, A2, A3, A4, A5, A6, A7)> fp) {
+    InjectorUtil inject_util(injector);
+    return new (storage) T(
+      inject_util.GetWithContext<A1>(local_context),
+      inject_util.GetWithContext<A2>(local_context),
+      inject_util.GetWithContext<A3>(local_context),
+      inject_util.GetWithContext<A4>(local_context),
+      inject_util.GetWithContext<A5>(local_context),
+      inject_util.GetWithContext<A6>(local_context),
+      inject_util.GetWithContext<A7>(local_context));
+  }
+
+  template <typename T, typename A1, typename A2, typename A3, typename A4,
+      typename A5, typename A6, typename A7, typename A8>
+  static T* Emplace(void* storage,
+                    const Injector* injector,
+                    const LocalContext* local_context,
+                    TypeKey<T* (*)(A1, A2, A3, A4, A5, A6, A7, A8)> fp) {
+    InjectorUtil inject_util(injector);
+    return new (storage) T(
+      inject_util.GetWithContext<A1>(local_context),
+      inject_util.GetWithContext<A2>(local_context),
+      inject_util.GetWithContext<A3>(local_context),
+      inject_util.GetWithContext<A4>(local_context),
+      inject_util.GetWithContext<A5>(local_context),
+      inject_util.GetWithContext<A6>(local_context),
+      inject_util.GetWithContext<A7>(local_context),
+      inject_util.GetWithContext<A8>(local_context));
+  }
+
+  template <typename T, typename A1, typename A2, typename A3, typename A4,
+      typename A5, typename A6, typename A7, typename A8, typename A9>
+  static T* Emplace(void* storage,
+                    const Injector* injector,
+                    const LocalContext* local_context,
+                    TypeKey<T* (*)(A1, A2, A3, A4, A5, A6, A7, A8, A9)> fp) {
+    InjectorUtil inject_util(injector);
+    return new (storage) T(
+      inject_util.GetWithContext<A1>(local_context),
+      inject_util.GetWithContext<A2>(local_context),
+      inject_util.GetWithContext<A3>(local_context),
+      inject_util.GetWithContext<A4>(local_context),
+      inject_util.GetWithContext<A5>(local_context),
+      inject_util.GetWithContext<A6>(local_context),
+      inject_util.GetWithContext<A7>(local_context),
+      inject_util.GetWithContext<A8>(local_context),
+      inject_util.GetWithContext<A9>(local_context));
+  }
+
+  template <typename T, typename A1, typename A2, typename A3, typename A4,
+      typename A5, typename A6, typename A7, typename A8, typename A9,
+      typename A10>
+  static T* Emplace(void* storage,
+                    const Injector* injector,
+                    const LocalContext* local_context,
+                    TypeKey<T* (*)(A1, A2, A3, A4, A5, A6, A7, A8, A9,
+                        A10)> fp) {
+    InjectorUtil inject_util(injector);
+    return new (storage) T(
+      inject_util.GetWithContext<A1>(local_context),
+      inject_util.GetWithContext<A2>(local_context),
+      inject_util.GetWithContext<A3>(local_context),
+      inject_util.GetWithContext<A4>(local_context),
+      inject_util.GetWithContext<A5>(local_context),
+      inject_util.GetWithContext<A6>(local_context),
+      inject_util.GetWithContext<A7>(local_context),
+      inject_util.GetWithContext<A8>(local_context),
+      inject_util.GetWithContext<A9>(local_context),
+      inject_util.GetWithContext<A10>(local_context));
+  }
+
  private:
   GUICPP_DISALLOW_IMPLICIT_CONSTRUCTORS_(CreateHelpers);
 };
@@ -18,7 +18,11 @@
 #ifndef GUICPP_ENTRIES_H_
 #define GUICPP_ENTRIES_H_
 
+#include <map>
+#include <vector>
+
 #include "guicpp/internal/guicpp_port.h"
+#include "guicpp/guicpp_swappable_instance.h"
 #include "guicpp/internal/guicpp_inject_util.h"
 #include "guicpp/internal/guicpp_table.h"
 #include "guicpp/internal/guicpp_util.h"
@@ -49,6 +53,14 @@ class BindToTypeEntry: public TableEntry<SourceType> {
     return TableEntryBase::BIND_TO_TYPE;
   }
 
+  // Same as the binding of the destination type; False if it is not bound.
+  virtual bool HasStableInstances(const Injector* injector) const {
+    InjectorUtil inject_util(injector);
+    const TableEntryBase* entry = inject_util.FindEntry(
+        InjectorUtil::GetBindId<DestinationAnnotations, DestinationType>());
+    return entry != NULL && entry->HasStableInstances(injector);
+  }
+
  private:
   GUICPP_DISALLOW_COPY_AND_ASSIGN_(BindToTypeEntry);
 };
@@ -79,6 +91,10 @@ class PointerTableEntry: public TableEntry<T> {
     return TableEntryBase::BIND_TO_INSTANCE;
   }
 
+  virtual bool HasStableInstances(const Injector* injector) const {
+    return true;
+  }
+
  private:
   T ptr_;
   CleanupAction cleanup_action_;
@@ -86,6 +102,37 @@ class PointerTableEntry: public TableEntry<T> {
   GUICPP_DISALLOW_COPY_AND_ASSIGN_(PointerTableEntry);
 };
 
+// Supports Binder::BindToSwappableInstance(). Returns a SwappableRef to the
+// pointer passed to the last Swap(), or to the constructor, see
+// SwappablePointer.
+template <typename T, typename CleanupAction>
+class SwappableInstanceEntry: public TableEntry<SwappableRef<T> >,
+                              public SwappableInstance<T> {
+ public:
+  SwappableInstanceEntry(T* ptr, CleanupAction cleanup_action)
+      : ptr_(ptr, cleanup_action) {}
+
+  virtual ~SwappableInstanceEntry() {}
+
+  virtual SwappableRef<T> Get(const Injector* injector,
+                              const LocalContext* local_context) const {
+    return ptr_.Get();
+  }
+
+  virtual void Swap(T* ptr) {
+    ptr_.Replace(ptr);
+  }
+
+  virtual typename TableEntryBase::BindType GetBindType() const {
+    return TableEntryBase::BIND_TO_SWAPPABLE_INSTANCE;
+  }
+
+ private:
+  SwappablePointer<T, CleanupAction> ptr_;
+
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(SwappableInstanceEntry);
+};
+
 // Supports Binder::BindToValue(). Returns the value provided to the
 // constructor on every call to Get().
 template <typename T>
@@ -166,6 +213,9 @@ class BindToProviderEntry: public TableEntry<T> {
     return TableEntryBase::BIND_TO_PROVIDER;
   }
 
+ protected:
+  ProviderType* provider() const { return provider_; }
+
  private:
   ProviderType* provider_;
   CleanupAction cleanup_action_;
@@ -173,6 +223,350 @@ class BindToProviderEntry: public TableEntry<T> {
   GUICPP_DISALLOW_COPY_AND_ASSIGN_(BindToProviderEntry);
 };
 
+// Supports Binder::BindToScopeProvider(). Same as BindToProviderEntry, but
+// asks the provider of the scope whether its instances are stable (see
+// ScopeProviderBase::HasStableInstances()).
+template <typename T, typename ProviderType, typename CleanupAction>
+class ScopeProviderEntry:
+      public BindToProviderEntry<T, ProviderType, CleanupAction> {
+ public:
+  ScopeProviderEntry(ProviderType* provider, CleanupAction cleanup_action)
+      : BindToProviderEntry<T, ProviderType, CleanupAction>(
+            provider, cleanup_action) {}
+
+  virtual bool HasStableInstances(const Injector* injector) const {
+    return this->provider()->HasStableInstances();
+  }
+
+ private:
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(ScopeProviderEntry);
+};
+
+// Supports Binder::BindToAsyncProvider(). Same as BindToProviderEntry, but
+// waits for Start() of the provider (see async_provider.h) to complete, or
+// calls it, before calling Get().
+template <typename T, typename ProviderType, typename CleanupAction>
+class AsyncProviderEntry:
+      public BindToProviderEntry<T, ProviderType, CleanupAction> {
+ public:
+  AsyncProviderEntry(ProviderType* provider, CleanupAction cleanup_action)
+      : BindToProviderEntry<T, ProviderType, CleanupAction>(
+            provider, cleanup_action) {}
+
+  virtual T Get(const Injector* injector,
+                const LocalContext* local_context) const {
+    this->provider()->WaitForStart();
+    return BindToProviderEntry<T, ProviderType, CleanupAction>::Get(
+        injector, local_context);
+  }
+
+ private:
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(AsyncProviderEntry);
+};
+
+// Supports Binder::Decorate(). This gets an instance of T* from the
+// decorated entry and returns a new instance of Decorator, created by
+// passing that instance as the assisted argument of type T* to the
+// constructor of Decorator. The decorated entry is set by the bind table
+// (see BindTable::AddDecorator()).
+//
+// If the decorated entry has stable instances (e.g. a singleton), the
+// decorator of each instance is created once and kept until the entry is
+// deleted. If two threads create it at the same time, the one added first
+// is returned to both and the other one is deleted. The decorator added
+// first is also kept in a pointer read without the lock; As most such
+// entries have a single instance, the map is looked up only for the other
+// instances (e.g. the replicas of PerNumaNodeSingleton).
+template <typename T, typename Decorator>
+class DecoratorEntry: public TableEntry<T*>, public DecoratorLink {
+ public:
+  DecoratorEntry()
+      : decorated_(NULL), has_stable_instances_(false),
+        first_decorator_(NULL) {}
+
+  virtual ~DecoratorEntry() {
+    for (typename map<T*, T*>::iterator iter = decorators_.begin();
+         iter != decorators_.end(); ++iter) {
+      delete iter->second;
+    }
+  }
+
+  virtual T* Get(const Injector* injector,
+                 const LocalContext* local_context) const {
+    T* decorated =
+        TableEntryReader<T*>::Get(decorated_, injector, local_context);
+
+    StableCheckArgs args = { this, injector };
+    stable_check_once_.Init(&CheckHasStableInstances, &args);
+    if (!has_stable_instances_) {
+      return NewDecorator(decorated, injector);
+    }
+
+    const DecoratorPair* first_decorator = AcquireLoad(&first_decorator_);
+    if (first_decorator != NULL && first_decorator->first == decorated) {
+      return first_decorator->second;
+    }
+
+    return GetStableDecorator(decorated, injector);
+  }
+
+  virtual typename TableEntryBase::BindType GetBindType() const {
+    return TableEntryBase::BIND_TO_DECORATOR;
+  }
+
+  // The decorators of stable instances are stable too.
+  virtual bool HasStableInstances(const Injector* injector) const {
+    return decorated_->HasStableInstances(injector);
+  }
+
+  // Called only while the injector is created (or a deferred module is
+  // installed), before the entry is looked up.
+  virtual const TableEntryBase* Decorate(
+      const TableEntryBase* decorated) const {
+    decorated_ = decorated;
+    return this;
+  }
+
+ private:
+  typedef typename map<T*, T*>::value_type DecoratorPair;
+
+  struct StableCheckArgs {
+    const DecoratorEntry* entry;
+    const Injector* injector;
+  };
+
+  // Called exactly once, on first call to Get().
+  static void CheckHasStableInstances(StableCheckArgs* args) {
+    const DecoratorEntry* entry = args->entry;
+    entry->has_stable_instances_ =
+        entry->decorated_->HasStableInstances(args->injector);
+  }
+
+  // Returns the decorator of "decorated", creating it the first time.
+  T* GetStableDecorator(T* decorated, const Injector* injector) const {
+    {
+      MutexLock lock(&mu_);
+      typename map<T*, T*>::const_iterator iter = decorators_.find(decorated);
+      if (iter != decorators_.end()) {
+        return iter->second;
+      }
+    }
+
+    // Created outside the lock, as the decorator may inject other types.
+    T* decorator = NewDecorator(decorated, injector);
+
+    MutexLock lock(&mu_);
+    std::pair<typename map<T*, T*>::iterator, bool> inserted =
+        decorators_.insert(make_pair(decorated, decorator));
+    if (!inserted.second) {
+      delete decorator;
+    }
+
+    // Nodes of the map never move, so the pair can be published.
+    if (first_decorator_ == NULL) {
+      ReleaseStore(&first_decorator_,
+                   static_cast<const DecoratorPair*>(&*inserted.first));
+    }
+
+    return inserted.first->second;
+  }
+
+  static T* NewDecorator(T* decorated, const Injector* injector) {
+    FactoryArgumentEntry<T*> entry(decorated);
+
+    const TypeIdArgumentPair argument_list[1] = {
+      { InjectorUtil::GetFactoryArgsBindId<T*>(), &entry },
+    };
+
+    LocalContext decorator_context(argument_list, 1);
+    InjectorUtil inject_util(injector);
+    return inject_util.GetActualType<Annotations<>, Decorator*>(
+        &decorator_context);
+  }
+
+  mutable const TableEntryBase* decorated_;
+
+  // Set once, on first call to Get().
+  mutable GoogleOnceDynamic stable_check_once_;
+  mutable bool has_stable_instances_;
+
+  // The first pair added to decorators_, published using ReleaseStore().
+  mutable const DecoratorPair* first_decorator_;
+
+  // Decorators of the stable instances, by decorated instance.
+  mutable Mutex mu_;  // Guards decorators_.
+  mutable map<T*, T*> decorators_;
+
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(DecoratorEntry);
+};
+
+// Gets the instance of an element added by Binder::AddToSet() or
+// Binder::AddToMap(). Returns true if the instance is owned by the caller,
+// that is unless the binding of the implementation has stable instances
+// (e.g. it is bound to an instance or to a singleton), which keep their
+// ownership. Instances created by the constructor of the implementation, a
+// provider or a factory are owned by the caller.
+template <typename T>
+bool GetMultibindingElement(const TableEntry<T>* element_entry,
+                            const Injector* injector,
+                            const LocalContext* local_context,
+                            T* instance) {
+  *instance = element_entry->Get(injector, local_context);
+  return !element_entry->HasStableInstances(injector);
+}
+
+// Supports Binder::AddToSet(). This binds std::vector<T> (T is a pointer
+// type) to the instances obtained from the element entries. Instances are
+// created exactly once, on first call to Get(), and are stored in a vector;
+// successive calls return reference to the same vector. Instances that are
+// not stable (see GetMultibindingElement()) are owned by this entry.
+template <typename T>
+class SetTableEntry: public TableEntry<const vector<T>&> {
+ public:
+  SetTableEntry() {}
+
+  virtual ~SetTableEntry() {
+    for (typename vector<T>::reverse_iterator riter =
+         owned_elements_.rbegin(); riter != owned_elements_.rend(); ++riter) {
+      delete *riter;
+    }
+  }
+
+  // Returns the bind type without an instance, see GetBindType().
+  static TableEntryBase::BindType StaticBindType() {
+    return TableEntryBase::BIND_TO_SET;
+  }
+
+  // Adds an element to the set. The element entry is owned by the bind
+  // table. Called only while binding.
+  void AddElement(const TableEntry<T>* element_entry) {
+    element_entries_.push_back(element_entry);
+  }
+
+  // Creates the instances on first call and returns the same vector on
+  // every call. The instances are shared by all the requesters, hence they
+  // are not created with the local context of the first one.
+  virtual const vector<T>& Get(const Injector* injector,
+                               const LocalContext* local_context) const {
+    ResolveArgs args = { this, injector };
+    once_.Init(&Resolve, &args);
+    return elements_;
+  }
+
+  virtual typename TableEntryBase::BindType GetBindType() const {
+    return StaticBindType();
+  }
+
+ private:
+  struct ResolveArgs {
+    const SetTableEntry* entry;
+    const Injector* injector;
+  };
+
+  // Called exactly once. Gets an instance from each element entry, in order
+  // of their addition.
+  static void Resolve(ResolveArgs* args) {
+    const SetTableEntry* entry = args->entry;
+    entry->elements_.reserve(entry->element_entries_.size());
+
+    LocalContext local_context;
+    for (size_t i = 0; i < entry->element_entries_.size(); ++i) {
+      T instance;
+      if (GetMultibindingElement(entry->element_entries_[i], args->injector,
+                                 &local_context, &instance)) {
+        entry->owned_elements_.push_back(instance);
+      }
+
+      entry->elements_.push_back(instance);
+    }
+  }
+
+  vector<const TableEntry<T>*> element_entries_;
+
+  mutable GoogleOnceDynamic once_;
+  mutable vector<T> elements_;
+
+  // The elements created by this entry, in order of creation.
+  mutable vector<T> owned_elements_;
+
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(SetTableEntry);
+};
+
+// Supports Binder::AddToMap(). Same as SetTableEntry except that this binds
+// std::map<K, T> and each instance is associated with a key.
+template <typename K, typename T>
+class MapTableEntry: public TableEntry<const map<K, T>&> {
+ public:
+  MapTableEntry() {}
+
+  virtual ~MapTableEntry() {
+    for (typename vector<T>::reverse_iterator riter =
+         owned_elements_.rbegin(); riter != owned_elements_.rend(); ++riter) {
+      delete *riter;
+    }
+  }
+
+  // Returns the bind type without an instance, see GetBindType().
+  static TableEntryBase::BindType StaticBindType() {
+    return TableEntryBase::BIND_TO_MAP;
+  }
+
+  // Adds an element for key to the map. The element entry is owned by the
+  // bind table. Returns false if there is already an element for the key.
+  // Called only while binding.
+  bool AddElement(const K& key, const TableEntry<T>* element_entry) {
+    return element_entries_.insert(make_pair(key, element_entry)).second;
+  }
+
+  // Creates the instances on first call and returns the same map on every
+  // call. As in SetTableEntry, the local context of the caller is not used.
+  virtual const map<K, T>& Get(const Injector* injector,
+                               const LocalContext* local_context) const {
+    ResolveArgs args = { this, injector };
+    once_.Init(&Resolve, &args);
+    return elements_;
+  }
+
+  virtual typename TableEntryBase::BindType GetBindType() const {
+    return StaticBindType();
+  }
+
+ private:
+  struct ResolveArgs {
+    const MapTableEntry* entry;
+    const Injector* injector;
+  };
+
+  // Called exactly once. Gets an instance from each element entry.
+  static void Resolve(ResolveArgs* args) {
+    const MapTableEntry* entry = args->entry;
+
+    LocalContext local_context;
+    for (typename map<K, const TableEntry<T>*>::const_iterator iter =
+         entry->element_entries_.begin();
+         iter != entry->element_entries_.end(); ++iter) {
+      T instance;
+      if (GetMultibindingElement(iter->second, args->injector,
+                                 &local_context, &instance)) {
+        entry->owned_elements_.push_back(instance);
+      }
+
+      entry->elements_.insert(entry->elements_.end(),
+                              make_pair(iter->first, instance));
+    }
+  }
+
+  map<K, const TableEntry<T>*> element_entries_;
+
+  mutable GoogleOnceDynamic once_;
+  mutable map<K, T> elements_;
+
+  // The elements created by this entry, in order of creation.
+  mutable vector<T> owned_elements_;
+
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(MapTableEntry);
+};
+
 // Entry used only for cleanup action. This is never added to BindTable
 template <typename CleanupAction>
 class CleanupEntry: public InvalidEntry {
@@ -56,6 +56,50 @@ class RealFactory {
   GUICPP_DISALLOW_IMPLICIT_CONSTRUCTORS_(RealFactory);
 };
 
+// Tags that select the implementation of a factory interface, named by
+// GuicppFactoryTag typedef of the interface.
+//   NewInstanceFactoryTag : RealFactory, used by guicpp::Factory.
+//   MemoizingFactoryTag : RealMemoizingFactory, used by
+//                         guicpp::MemoizingFactory.
+//   EmplaceFactoryTag : RealEmplaceFactory, used by guicpp::EmplaceFactory.
+struct NewInstanceFactoryTag {};
+struct MemoizingFactoryTag {};
+struct EmplaceFactoryTag {};
+
+// Same as RealFactory, but caches the created objects by factory arguments.
+// Header memoizing_factory_helpers.h has specialized definitions of this
+// class.
+template <typename Annotations, typename FactoryType, typename GetSignature>
+class RealMemoizingFactory {
+ private:
+  GUICPP_DISALLOW_IMPLICIT_CONSTRUCTORS_(RealMemoizingFactory);
+};
+
+// Converts the object injected by RealMemoizingFactory to the value it caches
+// and returns. Defined in memoizing_factory.h.
+template <typename R>
+struct MemoizedValue;
+
+// Base class of EmplaceFactory interface classes. Like FactoryInterface,
+// it has specialized definitions for function prototypes (in
+// emplace_factory_helpers.h) which declare the abstract method "Emplace()".
+template <typename T>
+class EmplaceFactoryInterface: public FactoryBase {
+ public:
+  virtual ~EmplaceFactoryInterface() {}
+
+ private:
+  GUICPP_DISALLOW_IMPLICIT_CONSTRUCTORS_(EmplaceFactoryInterface);
+};
+
+// Implementation of EmplaceFactory. Header emplace_factory_helpers.h has
+// specialized definitions of this class.
+template <typename Annotations, typename FactoryType, typename GetSignature>
+class RealEmplaceFactory {
+ private:
+  GUICPP_DISALLOW_IMPLICIT_CONSTRUCTORS_(RealEmplaceFactory);
+};
+
 // Logging related.
 
 class Logger {
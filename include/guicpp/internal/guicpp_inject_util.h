@@ -57,6 +57,13 @@ class InjectorUtil {
 
   const TableEntryBase* FindEntry(TypeId bindId) const;
 
+  // See BindTable::id(), BindTable::FindSharedEntry() and
+  // BindTable::AddSharedEntry().
+  uint64 GetTableId() const;
+  const TableEntryBase* FindSharedEntry(TypeId tid) const;
+  const TableEntryBase* AddSharedEntry(TypeId tid,
+                                       const TableEntryBase* entry) const;
+
  private:
   const Injector* injector_;
 
@@ -202,6 +209,32 @@ AssistedInjectHandler<Annotations, ActualType> GuicppGetInjectHandler(
 }
 
 
+// Holds an instance of an internal type that is shared by all its
+// injections, see BindTable::AddSharedEntry(). The instance is deleted along
+// with this entry.
+template <typename T>
+class SharedInstanceEntry: public InvalidEntry {
+ public:
+  explicit SharedInstanceEntry(const T* instance): instance_(instance) {}
+  virtual ~SharedInstanceEntry() {
+    delete instance_;
+  }
+
+  const T* instance() const { return instance_; }
+
+ private:
+  const T* const instance_;
+
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(SharedInstanceEntry);
+};
+
+// The shared entry last used by a thread, see
+// InternalTypeInjectHandler::GetFactory(). Table id 0 marks an unused cache.
+struct SharedEntryCache {
+  uint64 table_id;
+  const TableEntryBase* entry;
+};
+
 template <typename Annotations, typename ActualType>
 class InternalTypeInjectHandler {
  private:
@@ -227,10 +260,75 @@ class InternalTypeInjectHandler {
 
   ActualType GetHelper(FactoryBase*, const Injector* injector,
                        const LocalContext* local_context) const {
+    return GetFactory(typename TypeInfo<ActualType>::Category(), injector);
+  }
+
+  // A factory injected as pointer is a new instance owned by the caller.
+  ActualType GetFactory(TypesCategory::IsPointer,
+                        const Injector* injector) const {
+    return NewFactory(typename TypeSpecifier::GuicppFactoryTag(), injector);
+  }
+
+  // A factory injected as const reference is created on the first injection
+  // and is shared by the later injections. It is owned by the bind table.
+  ActualType GetFactory(TypesCategory::IsReference,
+                        const Injector* injector) const {
+    GUICPP_COMPILE_ASSERT_(TypeInfo<ActualType>::IsConst::value,
+                           Shared_factory_must_be_injected_as_const_reference);
+
+    typedef SharedInstanceEntry<TypeSpecifier> EntryType;
+    TypeId tid = TypeIdProvider<
+        LabelHelper<FactoryBase, Annotations, TypeSpecifier> >::GetTypeId();
+
+    // Each thread remembers the entry of the last table it injected this
+    // factory from. Table ids are never reused and the entry lives as long
+    // as its table, hence a later injection from the same table just loads
+    // the entry.
+    static GUICPP_THREAD_LOCAL_ SharedEntryCache cache;
+
+    InjectorUtil inject_util(injector);
+    uint64 table_id = inject_util.GetTableId();
+    if (cache.table_id != table_id) {
+      const TableEntryBase* entry = inject_util.FindSharedEntry(tid);
+      if (entry == NULL) {
+        entry = inject_util.AddSharedEntry(tid, new EntryType(NewFactory(
+            typename TypeSpecifier::GuicppFactoryTag(), injector)));
+      }
+
+      cache.table_id = table_id;
+      cache.entry = entry;
+    }
+
+    // tid identifies EntryType, hence the checked down_cast (a dynamic_cast
+    // in debug builds) is not needed on this per-injection path.
+    return *static_cast<const EntryType*>(cache.entry)->instance();
+  }
+
+  TypeSpecifier* NewFactory(NewInstanceFactoryTag,
+                            const Injector* injector) const {
     return new RealFactory<
         Annotations, TypeSpecifier,
         typename TypeSpecifier::GuicppGetSignature>(injector);
   }
+
+  TypeSpecifier* NewFactory(MemoizingFactoryTag,
+                            const Injector* injector) const {
+    return new RealMemoizingFactory<
+        Annotations, TypeSpecifier,
+        typename TypeSpecifier::GuicppGetSignature>(injector);
+  }
+
+  TypeSpecifier* NewFactory(EmplaceFactoryTag,
+                            const Injector* injector) const {
+    return new RealEmplaceFactory<
+        Annotations, TypeSpecifier,
+        typename TypeSpecifier::GuicppGetSignature>(injector);
+  }
+
+  ActualType GetHelper(LazyBase*, const Injector* injector,
+                       const LocalContext* local_context) const {
+    return new TypeSpecifier(injector);
+  }
 };
 
 template <typename ActualType>
@@ -0,0 +1,227 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// This file declares LruCache, a bounded map used by memoizing factories.
+
+#ifndef GUICPP_LRU_CACHE_H_
+#define GUICPP_LRU_CACHE_H_
+
+#include <stddef.h>
+
+#include <list>
+#include <string>
+#include <utility>
+
+#include "guicpp/internal/guicpp_port.h"
+
+namespace guicpp {
+namespace internal {
+// Counters of a LruCache, returned by MemoizingFactory::stats().
+struct LruCacheStats {
+  LruCacheStats(): num_hits(0), num_misses(0), num_evictions(0) {}
+
+  // Number of lookups that found the key and that did not.
+  int num_hits;
+  int num_misses;
+
+  // Number of values evicted to stay within the capacity.
+  int num_evictions;
+};
+
+// Returns the hash of a cache key, which picks the shard of the key in a
+// LruCache. Integers, pointers, strings and pairs of them are hashed; Keys of
+// other types all hash to 0, hence they share a shard.
+template <typename T>
+inline size_t HashLruCacheKey(const T& /* key */) {
+  return 0;
+}
+
+template <typename T>
+inline size_t HashLruCacheKey(T* key) {
+  return reinterpret_cast<size_t>(key);
+}
+
+#define GUICPP_HASH_INTEGER_LRU_CACHE_KEY_(Type) \
+  inline size_t HashLruCacheKey(Type key) { \
+    return static_cast<size_t>(key); \
+  }
+
+GUICPP_HASH_INTEGER_LRU_CACHE_KEY_(bool)
+GUICPP_HASH_INTEGER_LRU_CACHE_KEY_(char)
+GUICPP_HASH_INTEGER_LRU_CACHE_KEY_(signed char)
+GUICPP_HASH_INTEGER_LRU_CACHE_KEY_(unsigned char)
+GUICPP_HASH_INTEGER_LRU_CACHE_KEY_(short)
+GUICPP_HASH_INTEGER_LRU_CACHE_KEY_(unsigned short)
+GUICPP_HASH_INTEGER_LRU_CACHE_KEY_(int)
+GUICPP_HASH_INTEGER_LRU_CACHE_KEY_(unsigned int)
+GUICPP_HASH_INTEGER_LRU_CACHE_KEY_(long)
+GUICPP_HASH_INTEGER_LRU_CACHE_KEY_(unsigned long)
+GUICPP_HASH_INTEGER_LRU_CACHE_KEY_(long long)
+GUICPP_HASH_INTEGER_LRU_CACHE_KEY_(unsigned long long)
+
+#undef GUICPP_HASH_INTEGER_LRU_CACHE_KEY_
+
+inline size_t HashLruCacheKey(const std::string& key) {
+  size_t hash = 0;
+  for (size_t i = 0; i < key.size(); ++i) {
+    hash = hash * 31 + static_cast<unsigned char>(key[i]);
+  }
+  return hash;
+}
+
+template <typename First, typename Second>
+inline size_t HashLruCacheKey(const std::pair<First, Second>& key) {
+  return HashLruCacheKey(key.first) * 31 + HashLruCacheKey(key.second);
+}
+
+// Map from Key to Value holding at most "capacity" values. When full, the
+// least recently used value is evicted, that is the copy held by the cache
+// is destroyed. The cache never deletes what a value points to, as the
+// callers of Lookup() may still use it; A Value that owns an object must
+// share it with the copies returned to callers (e.g. a ref-counted handle).
+//
+// The keys are split into shards by their hash (see HashLruCacheKey()), each
+// guarded by its own mutex and holding its part of the capacity, hence
+// threads looking up different keys rarely contend. Caches smaller than
+// 2 * kMinShardCapacity have a single shard; In larger caches the least
+// recently used value of the key's shard is evicted.
+//
+// Key and Value must be copyable, Key must be comparable using operator<.
+// Value must also be assignable, see Lookup().
+template <typename Key, typename Value>
+class LruCache {
+ public:
+  // Minimum and maximum number of values in a shard and the maximum number
+  // of shards.
+  static const size_t kMinShardCapacity = 64;
+  static const size_t kMaxShards = 16;
+
+  explicit LruCache(size_t capacity)
+      : num_shards_(GetNumShards(capacity)),
+        shards_(new Shard[num_shards_]) {
+    for (size_t i = 0; i < num_shards_; ++i) {
+      // Spreads the remainder over the first shards.
+      shards_[i].capacity = capacity / num_shards_ +
+                            (i < capacity % num_shards_ ? 1 : 0);
+    }
+  }
+
+  ~LruCache() {
+    delete[] shards_;
+  }
+
+  // Sets *value to the value of key and makes it the most recently used.
+  // Returns false if there is no value for key.
+  bool Lookup(const Key& key, Value* value) {
+    Shard* shard = GetShard(key);
+    MutexLock lock(&shard->mu);
+
+    typename Index::iterator iter = shard->index.find(key);
+    if (iter == shard->index.end()) {
+      ++shard->stats.num_misses;
+      return false;
+    }
+
+    ++shard->stats.num_hits;
+    shard->values.splice(shard->values.begin(), shard->values, iter->second);
+    *value = iter->second->second;
+    return true;
+  }
+
+  // Adds value for key, evicting the least recently used value if the shard
+  // of key is full, and returns the value of key. If key already has a value
+  // (added by another thread after Lookup() failed), "value" is not added
+  // and the existing value is returned; "value" stays with the caller.
+  Value Insert(const Key& key, const Value& value) {
+    Shard* shard = GetShard(key);
+    MutexLock lock(&shard->mu);
+
+    typename Index::iterator iter = shard->index.find(key);
+    if (iter != shard->index.end()) {
+      return iter->second->second;
+    }
+
+    if (shard->values.size() >= shard->capacity && !shard->values.empty()) {
+      shard->index.erase(shard->values.back().first);
+      shard->values.pop_back();
+      ++shard->stats.num_evictions;
+    }
+
+    shard->values.push_front(std::make_pair(key, value));
+    shard->index.insert(std::make_pair(key, shard->values.begin()));
+    return value;
+  }
+
+  // Returns the counters summed over the shards.
+  LruCacheStats stats() const {
+    LruCacheStats stats;
+    for (size_t i = 0; i < num_shards_; ++i) {
+      MutexLock lock(&shards_[i].mu);
+      stats.num_hits += shards_[i].stats.num_hits;
+      stats.num_misses += shards_[i].stats.num_misses;
+      stats.num_evictions += shards_[i].stats.num_evictions;
+    }
+    return stats;
+  }
+
+ private:
+  // Most recently used first.
+  typedef std::list<std::pair<Key, Value> > List;
+  typedef map<Key, typename List::iterator> Index;
+
+  struct Shard {
+    Shard(): capacity(0) {}
+
+    size_t capacity;
+
+    Mutex mu;
+    List values;
+    Index index;
+    LruCacheStats stats;
+
+    // Keeps the shards on different cache lines.
+    char padding[kCacheLineSize];
+  };
+
+  static size_t GetNumShards(size_t capacity) {
+    size_t num_shards = capacity / kMinShardCapacity;
+    if (num_shards > kMaxShards) {
+      return kMaxShards;
+    }
+    return (num_shards > 1) ? num_shards : 1;
+  }
+
+  Shard* GetShard(const Key& key) const {
+    if (num_shards_ == 1) {
+      return &shards_[0];
+    }
+
+    // Mixes the bits of the hash, as hashes of small integers differ only in
+    // their low bits.
+    uint64 hash = static_cast<uint64>(HashLruCacheKey(key)) *
+                  0x9E3779B97F4A7C15ULL;
+    return &shards_[(hash >> 32) % num_shards_];
+  }
+
+  const size_t num_shards_;
+  Shard* const shards_;
+
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(LruCache);
+};
+
+}  // namespace internal
+}  // namespace guicpp
+
+#endif  // GUICPP_LRU_CACHE_H_
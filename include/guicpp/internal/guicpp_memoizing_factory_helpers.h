@@ -0,0 +1,853 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// This file contains specialized definitions of RealMemoizingFactory, the
+// implementation of MemoizingFactory interfaces.
+
+#ifndef GUICPP_MEMOIZING_FACTORY_HELPERS_H_
+#define GUICPP_MEMOIZING_FACTORY_HELPERS_H_
+
+#include "guicpp/internal/guicpp_port.h"
+#include "guicpp/internal/guicpp_factory_types.h"
+#include "guicpp/internal/guicpp_inject_util.h"
+#include "guicpp/internal/guicpp_local_context.h"
+#include "guicpp/internal/guicpp_lru_cache.h"
+#include "guicpp/internal/guicpp_util.h"
+
+namespace guicpp {
+namespace internal {
+// Type in which a factory argument of type T is kept in the cache key.
+template <typename T>
+struct MemoizingKeyType {
+  typedef T Type;
+};
+
+template <typename T>
+struct MemoizingKeyType<const T> {
+  typedef T Type;
+};
+
+template <typename T>
+struct MemoizingKeyType<T&> {
+  typedef T Type;
+};
+
+template <typename T>
+struct MemoizingKeyType<const T&> {
+  typedef T Type;
+};
+
+// R : return type of the function.
+// The cache key is the list of arguments, nested as
+// std::pair<K1, std::pair<K2, ... int> > where Kn is the key type of n-th
+// argument.
+
+template <typename Annotations, typename FactoryType, typename R>
+class RealMemoizingFactory<Annotations, FactoryType, R()>: public FactoryType {
+ public:
+  explicit RealMemoizingFactory(const Injector* injector)
+      : injector_(injector),
+        cache_(FactoryType::kGuicppCapacity) {}
+  virtual ~RealMemoizingFactory() {}
+
+  virtual R Get() const {
+    const Key key(0);
+
+    R result;
+    if (cache_.Lookup(key, &result)) {
+      return result;
+    }
+
+    const TypeIdArgumentPair* argument_list = NULL;
+
+    LocalContext local_context(argument_list, 0);
+    InjectorUtil inject_util(injector_);
+    return cache_.Insert(key, MemoizedValue<R>::Wrap(
+        inject_util.GetActualType<Annotations, InjectedType>(&local_context)));
+  }
+
+  virtual LruCacheStats stats() const {
+    return cache_.stats();
+  }
+
+ private:
+  typedef int Key;
+
+  typedef typename MemoizedValue<R>::InjectedType InjectedType;
+
+  const Injector* injector_;
+  mutable LruCache<Key, R> cache_;
+};
+
+template <typename Annotations, typename FactoryType, typename R, typename A1>
+class RealMemoizingFactory<Annotations, FactoryType,
+    R(A1)>: public FactoryType {
+ public:
+  explicit RealMemoizingFactory(const Injector* injector)
+      : injector_(injector),
+        cache_(FactoryType::kGuicppCapacity) {}
+  virtual ~RealMemoizingFactory() {}
+
+  virtual R Get(typename AtUtil::GetTypes<A1>::ActualType a1) const {
+    const Key key(std::make_pair(a1, 0));
+
+    R result;
+    if (cache_.Lookup(key, &result)) {
+      return result;
+    }
+
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A1>::ActualType> entry1(a1);
+
+    const TypeIdArgumentPair argument_list[1] = {
+      { InjectorUtil::GetFactoryArgsBindId<A1>(), &entry1 },
+    };
+
+    LocalContext local_context(argument_list, 1);
+    InjectorUtil inject_util(injector_);
+    return cache_.Insert(key, MemoizedValue<R>::Wrap(
+        inject_util.GetActualType<Annotations, InjectedType>(&local_context)));
+  }
+
+  virtual LruCacheStats stats() const {
+    return cache_.stats();
+  }
+
+ private:
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A1>::ActualType>::Type K1;
+
+  typedef std::pair<K1, int > Key;
+
+  typedef typename MemoizedValue<R>::InjectedType InjectedType;
+
+  const Injector* injector_;
+  mutable LruCache<Key, R> cache_;
+};
+
+template <typename Annotations, typename FactoryType, typename R, typename A1,
+    typename A2>
+class RealMemoizingFactory<Annotations, FactoryType, R(A1,
+    A2)>: public FactoryType {
+ public:
+  explicit RealMemoizingFactory(const Injector* injector)
+      : injector_(injector),
+        cache_(FactoryType::kGuicppCapacity) {}
+  virtual ~RealMemoizingFactory() {}
+
+  virtual R Get(typename AtUtil::GetTypes<A1>::ActualType a1,
+      typename AtUtil::GetTypes<A2>::ActualType a2) const {
+    const Key key(std::make_pair(a1, std::make_pair(a2, 0)));
+
+    R result;
+    if (cache_.Lookup(key, &result)) {
+      return result;
+    }
+
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A1>::ActualType> entry1(a1);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A2>::ActualType> entry2(a2);
+
+    const TypeIdArgumentPair argument_list[2] = {
+      { InjectorUtil::GetFactoryArgsBindId<A1>(), &entry1 },
+      { InjectorUtil::GetFactoryArgsBindId<A2>(), &entry2 },
+    };
+
+    LocalContext local_context(argument_list, 2);
+    InjectorUtil inject_util(injector_);
+    return cache_.Insert(key, MemoizedValue<R>::Wrap(
+        inject_util.GetActualType<Annotations, InjectedType>(&local_context)));
+  }
+
+  virtual LruCacheStats stats() const {
+    return cache_.stats();
+  }
+
+ private:
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A1>::ActualType>::Type K1;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A2>::ActualType>::Type K2;
+
+  typedef std::pair<K1, std::pair<K2, int > > Key;
+
+  typedef typename MemoizedValue<R>::InjectedType InjectedType;
+
+  const Injector* injector_;
+  mutable LruCache<Key, R> cache_;
+};
+
+template <typename Annotations, typename FactoryType, typename R, typename A1,
+    typename A2, typename A3>
+class RealMemoizingFactory<Annotations, FactoryType, R(A1, A2,
+    A3)>: public FactoryType {
+ public:
+  explicit RealMemoizingFactory(const Injector* injector)
+      : injector_(injector),
+        cache_(FactoryType::kGuicppCapacity) {}
+  virtual ~RealMemoizingFactory() {}
+
+  virtual R Get(typename AtUtil::GetTypes<A1>::ActualType a1,
+      typename AtUtil::GetTypes<A2>::ActualType a2,
+      typename AtUtil::GetTypes<A3>::ActualType a3) const {
+    const Key key(std::make_pair(a1, std::make_pair(a2, std::make_pair(a3,
+        0))));
+
+    R result;
+    if (cache_.Lookup(key, &result)) {
+      return result;
+    }
+
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A1>::ActualType> entry1(a1);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A2>::ActualType> entry2(a2);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A3>::ActualType> entry3(a3);
+
+    const TypeIdArgumentPair argument_list[3] = {
+      { InjectorUtil::GetFactoryArgsBindId<A1>(), &entry1 },
+      { InjectorUtil::GetFactoryArgsBindId<A2>(), &entry2 },
+      { InjectorUtil::GetFactoryArgsBindId<A3>(), &entry3 },
+    };
+
+    LocalContext local_context(argument_list, 3);
+    InjectorUtil inject_util(injector_);
+    return cache_.Insert(key, MemoizedValue<R>::Wrap(
+        inject_util.GetActualType<Annotations, InjectedType>(&local_context)));
+  }
+
+  virtual LruCacheStats stats() const {
+    return cache_.stats();
+  }
+
+ private:
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A1>::ActualType>::Type K1;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A2>::ActualType>::Type K2;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A3>::ActualType>::Type K3;
+
+  typedef std::pair<K1, std::pair<K2, std::pair<K3, int > > > Key;
+
+  typedef typename MemoizedValue<R>::InjectedType InjectedType;
+
+  const Injector* injector_;
+  mutable LruCache<Key, R> cache_;
+};
+
+template <typename Annotations, typename FactoryType, typename R, typename A1,
+    typename A2, typename A3, typename A4>
+class RealMemoizingFactory<Annotations, FactoryType, R(A1, A2, A3,
+    A4)>: public FactoryType {
+ public:
+  explicit RealMemoizingFactory(const Injector* injector)
+      : injector_(injector),
+        cache_(FactoryType::kGuicppCapacity) {}
+  virtual ~RealMemoizingFactory() {}
+
+  virtual R Get(typename AtUtil::GetTypes<A1>::ActualType a1,
+      typename AtUtil::GetTypes<A2>::ActualType a2,
+      typename AtUtil::GetTypes<A3>::ActualType a3,
+      typename AtUtil::GetTypes<A4>::ActualType a4) const {
+    const Key key(std::make_pair(a1, std::make_pair(a2, std::make_pair(a3,
+        std::make_pair(a4, 0)))));
+
+    R result;
+    if (cache_.Lookup(key, &result)) {
+      return result;
+    }
+
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A1>::ActualType> entry1(a1);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A2>::ActualType> entry2(a2);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A3>::ActualType> entry3(a3);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A4>::ActualType> entry4(a4);
+
+    const TypeIdArgumentPair argument_list[4] = {
+      { InjectorUtil::GetFactoryArgsBindId<A1>(), &entry1 },
+      { InjectorUtil::GetFactoryArgsBindId<A2>(), &entry2 },
+      { InjectorUtil::GetFactoryArgsBindId<A3>(), &entry3 },
+      { InjectorUtil::GetFactoryArgsBindId<A4>(), &entry4 },
+    };
+
+    LocalContext local_context(argument_list, 4);
+    InjectorUtil inject_util(injector_);
+    return cache_.Insert(key, MemoizedValue<R>::Wrap(
+        inject_util.GetActualType<Annotations, InjectedType>(&local_context)));
+  }
+
+  virtual LruCacheStats stats() const {
+    return cache_.stats();
+  }
+
+ private:
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A1>::ActualType>::Type K1;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A2>::ActualType>::Type K2;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A3>::ActualType>::Type K3;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A4>::ActualType>::Type K4;
+
+  typedef std::pair<K1, std::pair<K2, std::pair<K3, std::pair<K4,
+      int > > > > Key;
+
+  typedef typename MemoizedValue<R>::InjectedType InjectedType;
+
+  const Injector* injector_;
+  mutable LruCache<Key, R> cache_;
+};
+
+template <typename Annotations, typename FactoryType, typename R, typename A1,
+    typename A2, typename A3, typename A4, typename A5>
+class RealMemoizingFactory<Annotations, FactoryType, R(A1, A2, A3, A4,
+    A5)>: public FactoryType {
+ public:
+  explicit RealMemoizingFactory(const Injector* injector)
+      : injector_(injector),
+        cache_(FactoryType::kGuicppCapacity) {}
+  virtual ~RealMemoizingFactory() {}
+
+  virtual R Get(typename AtUtil::GetTypes<A1>::ActualType a1,
+      typename AtUtil::GetTypes<A2>::ActualType a2,
+      typename AtUtil::GetTypes<A3>::ActualType a3,
+      typename AtUtil::GetTypes<A4>::ActualType a4,
+      typename AtUtil::GetTypes<A5>::ActualType a5) const {
+    const Key key(std::make_pair(a1, std::make_pair(a2, std::make_pair(a3,
+        std::make_pair(a4, std::make_pair(a5, 0))))));
+
+    R result;
+    if (cache_.Lookup(key, &result)) {
+      return result;
+    }
+
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A1>::ActualType> entry1(a1);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A2>::ActualType> entry2(a2);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A3>::ActualType> entry3(a3);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A4>::ActualType> entry4(a4);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A5>::ActualType> entry5(a5);
+
+    const TypeIdArgumentPair argument_list[5] = {
+      { InjectorUtil::GetFactoryArgsBindId<A1>(), &entry1 },
+      { InjectorUtil::GetFactoryArgsBindId<A2>(), &entry2 },
+      { InjectorUtil::GetFactoryArgsBindId<A3>(), &entry3 },
+      { InjectorUtil::GetFactoryArgsBindId<A4>(), &entry4 },
+      { InjectorUtil::GetFactoryArgsBindId<A5>(), &entry5 },
+    };
+
+    LocalContext local_context(argument_list, 5);
+    InjectorUtil inject_util(injector_);
+    return cache_.Insert(key, MemoizedValue<R>::Wrap(
+        inject_util.GetActualType<Annotations, InjectedType>(&local_context)));
+  }
+
+  virtual LruCacheStats stats() const {
+    return cache_.stats();
+  }
+
+ private:
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A1>::ActualType>::Type K1;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A2>::ActualType>::Type K2;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A3>::ActualType>::Type K3;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A4>::ActualType>::Type K4;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A5>::ActualType>::Type K5;
+
+  typedef std::pair<K1, std::pair<K2, std::pair<K3, std::pair<K4, std::pair<K5,
+      int > > > > > Key;
+
+  typedef typename MemoizedValue<R>::InjectedType InjectedType;
+
+  const Injector* injector_;
+  mutable LruCache<Key, R> cache_;
+};
+
+template <typename Annotations, typename FactoryType, typename R, typename A1,
+    typename A2, typename A3, typename A4, typename A5, typename A6>
+class RealMemoizingFactory<Annotations, FactoryType, R(A1, A2, A3, A4, A5,
+    A6)>: public FactoryType {
+ public:
+  explicit RealMemoizingFactory(const Injector* injector)
+      : injector_(injector),
+        cache_(FactoryType::kGuicppCapacity) {}
+  virtual ~RealMemoizingFactory() {}
+
+  virtual R Get(typename AtUtil::GetTypes<A1>::ActualType a1,
+      typename AtUtil::GetTypes<A2>::ActualType a2,
+      typename AtUtil::GetTypes<A3>::ActualType a3,
+      typename AtUtil::GetTypes<A4>::ActualType a4,
+      typename AtUtil::GetTypes<A5>::ActualType a5,
+      typename AtUtil::GetTypes<A6>::ActualType a6) const {
+    const Key key(std::make_pair(a1, std::make_pair(a2, std::make_pair(a3,
+        std::make_pair(a4, std::make_pair(a5, std::make_pair(a6, 0)))))));
+
+    R result;
+    if (cache_.Lookup(key, &result)) {
+      return result;
+    }
+
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A1>::ActualType> entry1(a1);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A2>::ActualType> entry2(a2);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A3>::ActualType> entry3(a3);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A4>::ActualType> entry4(a4);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A5>::ActualType> entry5(a5);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A6>::ActualType> entry6(a6);
+
+    const TypeIdArgumentPair argument_list[6] = {
+      { InjectorUtil::GetFactoryArgsBindId<A1>(), &entry1 },
+      { InjectorUtil::GetFactoryArgsBindId<A2>(), &entry2 },
+      { InjectorUtil::GetFactoryArgsBindId<A3>(), &entry3 },
+      { InjectorUtil::GetFactoryArgsBindId<A4>(), &entry4 },
+      { InjectorUtil::GetFactoryArgsBindId<A5>(), &entry5 },
+      { InjectorUtil::GetFactoryArgsBindId<A6>(), &entry6 },
+    };
+
+    LocalContext local_context(argument_list, 6);
+    InjectorUtil inject_util(injector_);
+    return cache_.Insert(key, MemoizedValue<R>::Wrap(
+        inject_util.GetActualType<Annotations, InjectedType>(&local_context)));
+  }
+
+  virtual LruCacheStats stats() const {
+    return cache_.stats();
+  }
+
+ private:
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A1>::ActualType>::Type K1;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A2>::ActualType>::Type K2;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A3>::ActualType>::Type K3;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A4>::ActualType>::Type K4;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A5>::ActualType>::Type K5;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A6>::ActualType>::Type K6;
+
+  typedef std::pair<K1, std::pair<K2, std::pair<K3, std::pair<K4, std::pair<K5,
+      std::pair<K6, int > > > > > > Key;
+
+  typedef typename MemoizedValue<R>::InjectedType InjectedType;
+
+  const Injector* injector_;
+  mutable LruCache<Key, R> cache_;
+};
+
+template <typename Annotations, typename FactoryType, typename R, typename A1,
+    typename A2, typename A3, typename A4, typename A5, typename A6,
+    typename A7>
+class RealMemoizingFactory<Annotations, FactoryType, R(A1, A2, A3, A4, A5, A6,
+    A7)>: public FactoryType {
+ public:
+  explicit RealMemoizingFactory(const Injector* injector)
+      : injector_(injector),
+        cache_(FactoryType::kGuicppCapacity) {}
+  virtual ~RealMemoizingFactory() {}
+
+  virtual R Get(typename AtUtil::GetTypes<A1>::ActualType a1,
+      typename AtUtil::GetTypes<A2>::ActualType a2,
+      typename AtUtil::GetTypes<A3>::ActualType a3,
+      typename AtUtil::GetTypes<A4>::ActualType a4,
+      typename AtUtil::GetTypes<A5>::ActualType a5,
+      typename AtUtil::GetTypes<A6>::ActualType a6,
+      typename AtUtil::GetTypes<A7>::ActualType a7) const {
+    const Key key(std::make_pair(a1, std::make_pair(a2, std::make_pair(a3,
+        std::make_pair(a4, std::make_pair(a5, std::make_pair(a6,
+        std::make_pair(a7, 0))))))));
+
+    R result;
+    if (cache_.Lookup(key, &result)) {
+      return result;
+    }
+
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A1>::ActualType> entry1(a1);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A2>::ActualType> entry2(a2);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A3>::ActualType> entry3(a3);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A4>::ActualType> entry4(a4);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A5>::ActualType> entry5(a5);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A6>::ActualType> entry6(a6);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A7>::ActualType> entry7(a7);
+
+    const TypeIdArgumentPair argument_list[7] = {
+      { InjectorUtil::GetFactoryArgsBindId<A1>(), &entry1 },
+      { InjectorUtil::GetFactoryArgsBindId<A2>(), &entry2 },
+      { InjectorUtil::GetFactoryArgsBindId<A3>(), &entry3 },
+      { InjectorUtil::GetFactoryArgsBindId<A4>(), &entry4 },
+      { InjectorUtil::GetFactoryArgsBindId<A5>(), &entry5 },
+      { InjectorUtil::GetFactoryArgsBindId<A6>(), &entry6 },
+      { InjectorUtil::GetFactoryArgsBindId<A7>(), &entry7 },
+    };
+
+    LocalContext local_context(argument_list, 7);
+    InjectorUtil inject_util(injector_);
+    return cache_.Insert(key, MemoizedValue<R>::Wrap(
+        inject_util.GetActualType<Annotations, InjectedType>(&local_context)));
+  }
+
+  virtual LruCacheStats stats() const {
+    return cache_.stats();
+  }
+
+ private:
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A1>::ActualType>::Type K1;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A2>::ActualType>::Type K2;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A3>::ActualType>::Type K3;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A4>::ActualType>::Type K4;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A5>::ActualType>::Type K5;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A6>::ActualType>::Type K6;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A7>::ActualType>::Type K7;
+
+  typedef std::pair<K1, std::pair<K2, std::pair<K3, std::pair<K4, std::pair<K5,
+      std::pair<K6, std::pair<K7, int > > > > > > > Key;
+
+  typedef typename MemoizedValue<R>::InjectedType InjectedType;
+
+  const Injector* injector_;
+  mutable LruCache<Key, R> cache_;
+};
+
+template <typename Annotations, typename FactoryType, typename R, typename A1,
+    typename A2, typename A3, typename A4, typename A5, typename A6,
+    typename A7, typename A8>
+class RealMemoizingFactory<Annotations, FactoryType, R(A1, A2, A3, A4, A5, A6,
+    A7, A8)>: public FactoryType {
+ public:
+  explicit RealMemoizingFactory(const Injector* injector)
+      : injector_(injector),
+        cache_(FactoryType::kGuicppCapacity) {}
+  virtual ~RealMemoizingFactory() {}
+
+  virtual R Get(typename AtUtil::GetTypes<A1>::ActualType a1,
+      typename AtUtil::GetTypes<A2>::ActualType a2,
+      typename AtUtil::GetTypes<A3>::ActualType a3,
+      typename AtUtil::GetTypes<A4>::ActualType a4,
+      typename AtUtil::GetTypes<A5>::ActualType a5,
+      typename AtUtil::GetTypes<A6>::ActualType a6,
+      typename AtUtil::GetTypes<A7>::ActualType a7,
+      typename AtUtil::GetTypes<A8>::ActualType a8) const {
+    const Key key(std::make_pair(a1, std::make_pair(a2, std::make_pair(a3,
+        std::make_pair(a4, std::make_pair(a5, std::make_pair(a6,
+        std::make_pair(a7, std::make_pair(a8, 0)))))))));
+
+    R result;
+    if (cache_.Lookup(key, &result)) {
+      return result;
+    }
+
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A1>::ActualType> entry1(a1);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A2>::ActualType> entry2(a2);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A3>::ActualType> entry3(a3);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A4>::ActualType> entry4(a4);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A5>::ActualType> entry5(a5);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A6>::ActualType> entry6(a6);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A7>::ActualType> entry7(a7);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A8>::ActualType> entry8(a8);
+
+    const TypeIdArgumentPair argument_list[8] = {
+      { InjectorUtil::GetFactoryArgsBindId<A1>(), &entry1 },
+      { InjectorUtil::GetFactoryArgsBindId<A2>(), &entry2 },
+      { InjectorUtil::GetFactoryArgsBindId<A3>(), &entry3 },
+      { InjectorUtil::GetFactoryArgsBindId<A4>(), &entry4 },
+      { InjectorUtil::GetFactoryArgsBindId<A5>(), &entry5 },
+      { InjectorUtil::GetFactoryArgsBindId<A6>(), &entry6 },
+      { InjectorUtil::GetFactoryArgsBindId<A7>(), &entry7 },
+      { InjectorUtil::GetFactoryArgsBindId<A8>(), &entry8 },
+    };
+
+    LocalContext local_context(argument_list, 8);
+    InjectorUtil inject_util(injector_);
+    return cache_.Insert(key, MemoizedValue<R>::Wrap(
+        inject_util.GetActualType<Annotations, InjectedType>(&local_context)));
+  }
+
+  virtual LruCacheStats stats() const {
+    return cache_.stats();
+  }
+
+ private:
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A1>::ActualType>::Type K1;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A2>::ActualType>::Type K2;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A3>::ActualType>::Type K3;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A4>::ActualType>::Type K4;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A5>::ActualType>::Type K5;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A6>::ActualType>::Type K6;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A7>::ActualType>::Type K7;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A8>::ActualType>::Type K8;
+
+  typedef std::pair<K1, std::pair<K2, std::pair<K3, std::pair<K4, std::pair<K5,
+      std::pair<K6, std::pair<K7, std::pair<K8, int > > > > > > > > Key;
+
+  typedef typename MemoizedValue<R>::InjectedType InjectedType;
+
+  const Injector* injector_;
+  mutable LruCache<Key, R> cache_;
+};
+
+template <typename Annotations, typename FactoryType, typename R, typename A1,
+    typename A2, typename A3, typename A4, typename A5, typename A6,
+    typename A7, typename A8, typename A9>
+class RealMemoizingFactory<Annotations, FactoryType, R(A1, A2, A3, A4, A5, A6,
+    A7, A8, A9)>: public FactoryType {
+ public:
+  explicit RealMemoizingFactory(const Injector* injector)
+      : injector_(injector),
+        cache_(FactoryType::kGuicppCapacity) {}
+  virtual ~RealMemoizingFactory() {}
+
+  virtual R Get(typename AtUtil::GetTypes<A1>::ActualType a1,
+      typename AtUtil::GetTypes<A2>::ActualType a2,
+      typename AtUtil::GetTypes<A3>::ActualType a3,
+      typename AtUtil::GetTypes<A4>::ActualType a4,
+      typename AtUtil::GetTypes<A5>::ActualType a5,
+      typename AtUtil::GetTypes<A6>::ActualType a6,
+      typename AtUtil::GetTypes<A7>::ActualType a7,
+      typename AtUtil::GetTypes<A8>::ActualType a8,
+      typename AtUtil::GetTypes<A9>::ActualType a9) const {
+    const Key key(std::make_pair(a1, std::make_pair(a2, std::make_pair(a3,
+        std::make_pair(a4, std::make_pair(a5, std::make_pair(a6,
+        std::make_pair(a7, std::make_pair(a8, std::make_pair(a9, 0))))))))));
+
+    R result;
+    if (cache_.Lookup(key, &result)) {
+      return result;
+    }
+
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A1>::ActualType> entry1(a1);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A2>::ActualType> entry2(a2);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A3>::ActualType> entry3(a3);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A4>::ActualType> entry4(a4);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A5>::ActualType> entry5(a5);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A6>::ActualType> entry6(a6);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A7>::ActualType> entry7(a7);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A8>::ActualType> entry8(a8);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A9>::ActualType> entry9(a9);
+
+    const TypeIdArgumentPair argument_list[9] = {
+      { InjectorUtil::GetFactoryArgsBindId<A1>(), &entry1 },
+      { InjectorUtil::GetFactoryArgsBindId<A2>(), &entry2 },
+      { InjectorUtil::GetFactoryArgsBindId<A3>(), &entry3 },
+      { InjectorUtil::GetFactoryArgsBindId<A4>(), &entry4 },
+      { InjectorUtil::GetFactoryArgsBindId<A5>(), &entry5 },
+      { InjectorUtil::GetFactoryArgsBindId<A6>(), &entry6 },
+      { InjectorUtil::GetFactoryArgsBindId<A7>(), &entry7 },
+      { InjectorUtil::GetFactoryArgsBindId<A8>(), &entry8 },
+      { InjectorUtil::GetFactoryArgsBindId<A9>(), &entry9 },
+    };
+
+    LocalContext local_context(argument_list, 9);
+    InjectorUtil inject_util(injector_);
+    return cache_.Insert(key, MemoizedValue<R>::Wrap(
+        inject_util.GetActualType<Annotations, InjectedType>(&local_context)));
+  }
+
+  virtual LruCacheStats stats() const {
+    return cache_.stats();
+  }
+
+ private:
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A1>::ActualType>::Type K1;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A2>::ActualType>::Type K2;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A3>::ActualType>::Type K3;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A4>::ActualType>::Type K4;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A5>::ActualType>::Type K5;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A6>::ActualType>::Type K6;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A7>::ActualType>::Type K7;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A8>::ActualType>::Type K8;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A9>::ActualType>::Type K9;
+
+  typedef std::pair<K1, std::pair<K2, std::pair<K3, std::pair<K4, std::pair<K5,
+      std::pair<K6, std::pair<K7, std::pair<K8, std::pair<K9,
+      int > > > > > > > > > Key;
+
+  typedef typename MemoizedValue<R>::InjectedType InjectedType;
+
+  const Injector* injector_;
+  mutable LruCache<Key, R> cache_;
+};
+
+template <typename Annotations, typename FactoryType, typename R, typename A1,
+    typename A2, typename A3, typename A4, typename A5, typename A6,
+    typename A7, typename A8, typename A9, typename A10>
+class RealMemoizingFactory<Annotations, FactoryType, R(A1, A2, A3, A4, A5, A6,
+    A7, A8, A9, A10)>: public FactoryType {
+ public:
+  explicit RealMemoizingFactory(const Injector* injector)
+      : injector_(injector),
+        cache_(FactoryType::kGuicppCapacity) {}
+  virtual ~RealMemoizingFactory() {}
+
+  virtual R Get(typename AtUtil::GetTypes<A1>::ActualType a1,
+      typename AtUtil::GetTypes<A2>::ActualType a2,
+      typename AtUtil::GetTypes<A3>::ActualType a3,
+      typename AtUtil::GetTypes<A4>::ActualType a4,
+      typename AtUtil::GetTypes<A5>::ActualType a5,
+      typename AtUtil::GetTypes<A6>::ActualType a6,
+      typename AtUtil::GetTypes<A7>::ActualType a7,
+      typename AtUtil::GetTypes<A8>::ActualType a8,
+      typename AtUtil::GetTypes<A9>::ActualType a9,
+      typename AtUtil::GetTypes<A10>::ActualType a10) const {
+    const Key key(std::make_pair(a1, std::make_pair(a2, std::make_pair(a3,
+        std::make_pair(a4, std::make_pair(a5, std::make_pair(a6,
+        std::make_pair(a7, std::make_pair(a8, std::make_pair(a9,
+        std::make_pair(a10, 0)))))))))));
+
+    R result;
+    if (cache_.Lookup(key, &result)) {
+      return result;
+    }
+
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A1>::ActualType> entry1(a1);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A2>::ActualType> entry2(a2);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A3>::ActualType> entry3(a3);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A4>::ActualType> entry4(a4);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A5>::ActualType> entry5(a5);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A6>::ActualType> entry6(a6);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A7>::ActualType> entry7(a7);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A8>::ActualType> entry8(a8);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A9>::ActualType> entry9(a9);
+    FactoryArgumentEntry<typename AtUtil::GetTypes<A10>::ActualType>
+        entry10(a10);
+
+    const TypeIdArgumentPair argument_list[10] = {
+      { InjectorUtil::GetFactoryArgsBindId<A1>(), &entry1 },
+      { InjectorUtil::GetFactoryArgsBindId<A2>(), &entry2 },
+      { InjectorUtil::GetFactoryArgsBindId<A3>(), &entry3 },
+      { InjectorUtil::GetFactoryArgsBindId<A4>(), &entry4 },
+      { InjectorUtil::GetFactoryArgsBindId<A5>(), &entry5 },
+      { InjectorUtil::GetFactoryArgsBindId<A6>(), &entry6 },
+      { InjectorUtil::GetFactoryArgsBindId<A7>(), &entry7 },
+      { InjectorUtil::GetFactoryArgsBindId<A8>(), &entry8 },
+      { InjectorUtil::GetFactoryArgsBindId<A9>(), &entry9 },
+      { InjectorUtil::GetFactoryArgsBindId<A10>(), &entry10 },
+    };
+
+    LocalContext local_context(argument_list, 10);
+    InjectorUtil inject_util(injector_);
+    return cache_.Insert(key, MemoizedValue<R>::Wrap(
+        inject_util.GetActualType<Annotations, InjectedType>(&local_context)));
+  }
+
+  virtual LruCacheStats stats() const {
+    return cache_.stats();
+  }
+
+ private:
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A1>::ActualType>::Type K1;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A2>::ActualType>::Type K2;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A3>::ActualType>::Type K3;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A4>::ActualType>::Type K4;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A5>::ActualType>::Type K5;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A6>::ActualType>::Type K6;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A7>::ActualType>::Type K7;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A8>::ActualType>::Type K8;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A9>::ActualType>::Type K9;
+
+  typedef typename MemoizingKeyType<
+      typename AtUtil::GetTypes<A10>::ActualType>::Type K10;
+
+  typedef std::pair<K1, std::pair<K2, std::pair<K3, std::pair<K4, std::pair<K5,
+      std::pair<K6, std::pair<K7, std::pair<K8, std::pair<K9, std::pair<K10,
+      int > > > > > > > > > > Key;
+
+  typedef typename MemoizedValue<R>::InjectedType InjectedType;
+
+  const Injector* injector_;
+  mutable LruCache<Key, R> cache_;
+};
+
+}  // namespace internal
+}  // namespace guicpp
+
+#endif  // GUICPP_MEMOIZING_FACTORY_HELPERS_H_
@@ -18,9 +18,12 @@
 #define GUICPP_PORT_H_
 
 #include <stdlib.h>   // For abort
+#include <time.h>     // For clock_gettime
 
 #include <map>
 #include <iostream>
+#include <sstream>
+#include <string>
 #include <vector>
 
 namespace guicpp {
@@ -47,8 +50,17 @@ using std::make_pair;
 template <bool>
 struct CompileAssert {};
 
+// Marks a variable or typedef that may be unused, as the ones defined by
+// GUICPP_COMPILE_ASSERT_ in a function body.
+#if defined(__GNUC__)
+#define GUICPP_ATTRIBUTE_UNUSED_ __attribute__ ((unused))
+#else
+#define GUICPP_ATTRIBUTE_UNUSED_
+#endif
+
 #define GUICPP_COMPILE_ASSERT_(expr, msg) \
-  typedef guicpp::internal::CompileAssert<(bool(expr))> msg[bool(expr) ? 1 : -1]
+  typedef guicpp::internal::CompileAssert<(bool(expr))> \
+      msg[bool(expr) ? 1 : -1] GUICPP_ATTRIBUTE_UNUSED_
 
 // Implementation details of GUICPP_COMPILE_ASSERT_:
 //
@@ -258,6 +270,30 @@ template <class T> struct is_class_or_union {
   static const bool value = sizeof(tester<T>(0)) == sizeof(small_);
 };
 
+// AlignOf<T>::value is the alignment of T, computed from the offset of T
+// when it follows a char in a struct.
+template <class T> struct AlignOf {
+  struct Helper {
+    char c;
+    T t;
+  };
+  static const size_t value = sizeof(Helper) - sizeof(T);
+};
+
+template <class T> const size_t AlignOf<T>::value;
+
+// Size of a cache line on the platforms Guic++ is used on. Used to keep data
+// that is written by different threads on separate cache lines.
+const size_t kCacheLineSize = 64;
+
+// A type whose alignment is at least that of any scalar type.
+union MaxAlignType {
+  long double long_double;
+  long long long_long;
+  void* pointer;
+  void (*function_pointer)();
+};
+
 
 // Used to supress warning on constant expression.
 // TODO(bnmouli): Do I need to make it non-inline?
@@ -271,9 +307,81 @@ enum GuicppLogSeverity {
   GUICPP_FATAL
 };
 
+// Log messages below this severity are compiled out; FATAL messages are
+// never compiled out. Define GUICPP_MIN_LOG_LEVEL to one of the
+// GuicppLogSeverity values (0 for INFO to 3 for FATAL) to change it.
+#ifndef GUICPP_MIN_LOG_LEVEL
+#define GUICPP_MIN_LOG_LEVEL GUICPP_INFO
+#endif
+
+// Returns true if messages of "severity" are logged. This is a compile time
+// constant for a given severity, hence the messages that are not logged are
+// removed by the compiler.
+inline bool IsLogged(GuicppLogSeverity severity) {
+  return severity == GUICPP_FATAL || severity >= GUICPP_MIN_LOG_LEVEL;
+}
+
+// Receives the formatted log messages. See SetLogSink().
+class LogSink {
+ public:
+  virtual ~LogSink() {}
+
+  // Called once per message. "message" is the complete message including
+  // its location and the trailing newline.
+  virtual void Send(GuicppLogSeverity severity,
+                    const ::std::string& message) = 0;
+
+  // Writes out the messages that are buffered by the sink, if any. This is
+  // called before the program is aborted on a FATAL message.
+  virtual void Flush() = 0;
+
+ protected:
+  LogSink() {}
+
+ private:
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(LogSink);
+};
+
+// The default sink, writes each message to stderr with a single write.
+class StderrLogSink: public LogSink {
+ public:
+  StderrLogSink() {}
+
+  virtual void Send(GuicppLogSeverity /* severity */,
+                    const ::std::string& message) {
+    ::std::cerr.write(message.data(), message.size());
+  }
+
+  virtual void Flush() {
+    ::std::cerr.flush();
+  }
+};
+
+// Returns the sink that writes to stderr.
+inline LogSink* GetStderrLogSink() {
+  static StderrLogSink sink;
+  return &sink;
+}
+
+// Returns the storage of the sink that receives the log messages.
+inline LogSink*& CurrentLogSink() {
+  static LogSink* sink = GetStderrLogSink();
+  return sink;
+}
+
+// Makes "sink" receive the log messages and returns the previous sink. If
+// "sink" is NULL, messages are written to stderr. The sink is not owned and
+// must outlive its use. This must be called before any thread logs.
+inline LogSink* SetLogSink(LogSink* sink) {
+  LogSink* previous_sink = CurrentLogSink();
+  CurrentLogSink() = (sink != NULL) ? sink : GetStderrLogSink();
+  return previous_sink;
+}
+
 // Formats log entry severity, provides a stream object for streaming the
 // log message, and terminates the message with a newline when going out of
-// scope.
+// scope. The message is formatted in a buffer and handed over to the log sink
+// as a whole, hence messages logged by different threads do not interleave.
 class GuicppLog {
  public:
   GuicppLog(GuicppLogSeverity severity, const char* file, int line)
@@ -281,29 +389,30 @@ class GuicppLog {
     GetStream() << "Location [" << file << "@" << line << "]\n";
   }
 
-  // Flushes the buffers and, if severity is GUICPP_FATAL, aborts the program.
+  // Sends the message to the log sink and, if severity is GUICPP_FATAL,
+  // flushes the sink and aborts the program.
   ~GuicppLog() {
-    GetStream() << std::endl;
+    GetStream() << '\n';
+
+    LogSink* sink = CurrentLogSink();
+    sink->Send(severity_, stream_.str());
     if (severity_ == GUICPP_FATAL) {
-      GetStream().flush();
+      sink->Flush();
       abort();
     }
   }
 
-  ::std::ostream& GetStream() { return ::std::cerr; }
+  ::std::ostream& GetStream() { return stream_; }
 
  private:
   const GuicppLogSeverity severity_;
   const char *file_;
   int line_;
+  ::std::ostringstream stream_;
 
   GUICPP_DISALLOW_COPY_AND_ASSIGN_(GuicppLog);
 };
 
-#define GUICPP_LOG_(severity) \
-    ::guicpp::internal::GuicppLog(::guicpp::internal::GUICPP_##severity, \
-                                  __FILE__, __LINE__).GetStream()
-
 // The GNU compiler emits a warning if nested "if" statements are followed by
 // an "else" statement and braces are not used to explicitly disambiguate the
 // "else" binding.  This leads to problems with code like:
@@ -318,6 +427,14 @@ class GuicppLog {
 #define GUICPP_AMBIGUOUS_ELSE_BLOCKER_ switch (0) case 0: default:
 #endif
 
+#define GUICPP_LOG_(severity) \
+    GUICPP_AMBIGUOUS_ELSE_BLOCKER_ \
+    if (!::guicpp::internal::IsLogged(::guicpp::internal::GUICPP_##severity)) \
+      ; \
+    else \
+      ::guicpp::internal::GuicppLog(::guicpp::internal::GUICPP_##severity, \
+                                    __FILE__, __LINE__).GetStream()
+
 #define GUICPP_CHECK_(condition) \
     GUICPP_AMBIGUOUS_ELSE_BLOCKER_ \
     if (::guicpp::internal::IsTrue(condition)) \
@@ -328,8 +445,20 @@ class GuicppLog {
 #define GUICPP_CHECK_EQ_(lhs, rhs) \
     GUICPP_CHECK_((lhs) == (rhs))
 
+// Debug checks guard internal invariants, such as type of a bind table entry
+// matching the requested type, which hold for any binding that is accepted
+// when the injector is created. Hence they are compiled out of release builds
+// (NDEBUG defined), unless GUICPP_HARDENED is defined. The condition is still
+// compiled but never evaluated.
+#if defined(NDEBUG) && !defined(GUICPP_HARDENED)
+#define GUICPP_DCHECK_(condition) \
+    while (false) GUICPP_CHECK_(condition)
+#else
 #define GUICPP_DCHECK_ GUICPP_CHECK_
-#define GUICPP_DCHECK_EQ_ GUICPP_CHECK_EQ_
+#endif  // defined(NDEBUG) && !defined(GUICPP_HARDENED)
+
+#define GUICPP_DCHECK_EQ_(lhs, rhs) \
+    GUICPP_DCHECK_((lhs) == (rhs))
 
 // This MUST be ported
 class Mutex {
@@ -369,6 +498,11 @@ class MutexLock {
 typedef MutexLock WriterMutexLock;
 typedef MutexLock ReaderMutexLock;
 
+// Storage class of thread local variables. This is used only for POD types
+// that are zero initialized.
+// This MUST be ported for compilers other than gcc and clang.
+#define GUICPP_THREAD_LOCAL_ __thread
+
 }  // namespace internal
 
 // INTERNAL IMPLEMENTATION - DO NOT USE IN USER CODE.
@@ -486,6 +620,88 @@ inline To down_cast(From* f) {  // so we only accept pointers
 
 typedef long int32;
 typedef unsigned long uint32;
+typedef unsigned long long uint64;
+
+// Increments a statistics counter, which may be incremented concurrently by
+// other threads, and loads it. The increment need not be ordered with other
+// memory operations (relaxed).
+//
+// The atomic operations below use the builtins of gcc and clang.
+// This MUST be ported for other compilers.
+inline void IncrementCounter(uint64* counter) {
+#if defined(__GNUC__)
+  __atomic_fetch_add(counter, 1, __ATOMIC_RELAXED);
+#else
+  ++*counter;
+#endif
+}
+
+inline uint64 LoadCounter(const uint64* counter) {
+#if defined(__GNUC__)
+  return __atomic_load_n(counter, __ATOMIC_RELAXED);
+#else
+  return *counter;
+#endif
+}
+
+// Adds "increment" to "*count" and returns the new value, as one atomic
+// operation ordered with the memory operations around it. Used for
+// reference counts.
+inline int32 AtomicIncrement(int32* count, int32 increment) {
+#if defined(__GNUC__)
+  return __atomic_add_fetch(count, increment, __ATOMIC_ACQ_REL);
+#else
+  *count += increment;
+  return *count;
+#endif
+}
+
+// Loads "*flag" with acquire semantics and stores it with release semantics.
+// A flag stored by ReleaseStore() publishes the writes made before it to the
+// threads that see it set using AcquireLoad().
+inline bool AcquireLoad(const bool* flag) {
+#if defined(__GNUC__)
+  return __atomic_load_n(flag, __ATOMIC_ACQUIRE);
+#else
+  return *flag;
+#endif
+}
+
+inline void ReleaseStore(bool* flag, bool value) {
+#if defined(__GNUC__)
+  __atomic_store_n(flag, value, __ATOMIC_RELEASE);
+#else
+  *flag = value;
+#endif
+}
+
+// Same as above for a pointer, which publishes the object it points to.
+template <typename T>
+inline T* AcquireLoad(T* const* pointer) {
+#if defined(__GNUC__)
+  return __atomic_load_n(pointer, __ATOMIC_ACQUIRE);
+#else
+  return *pointer;
+#endif
+}
+
+template <typename T>
+inline void ReleaseStore(T** pointer, T* value) {
+#if defined(__GNUC__)
+  __atomic_store_n(pointer, value, __ATOMIC_RELEASE);
+#else
+  *pointer = value;
+#endif
+}
+
+// Returns the time in nanoseconds since an arbitrary point, which is not
+// affected by changes to the system time. Used to measure durations.
+// This MUST be ported for platforms without clock_gettime().
+inline uint64 GetMonotonicNanos() {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return static_cast<uint64>(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
 
 // TODO(bnmouli): PORT This
 class GoogleOnceDynamic {
@@ -52,7 +52,7 @@ class ProviderGet<R()>: public ProviderBase {
   }
 
   template <typename T>
-  friend class AbstractProvider;
+  friend class guicpp::AbstractProvider;
 
   GUICPP_DISALLOW_COPY_AND_ASSIGN_(ProviderGet);
 };
@@ -80,7 +80,7 @@ class ProviderGet<R(A1)>: public ProviderBase {
   }
 
   template <typename T>
-  friend class AbstractProvider;
+  friend class guicpp::AbstractProvider;
 
   GUICPP_DISALLOW_COPY_AND_ASSIGN_(ProviderGet);
 };
@@ -111,7 +111,7 @@ class ProviderGet<R(A1, A2)>: public ProviderBase {
   }
 
   template <typename T>
-  friend class AbstractProvider;
+  friend class guicpp::AbstractProvider;
 
   GUICPP_DISALLOW_COPY_AND_ASSIGN_(ProviderGet);
 };
@@ -145,7 +145,7 @@ class ProviderGet<R(A1, A2, A3)>: public ProviderBase {
   }
 
   template <typename T>
-  friend class AbstractProvider;
+  friend class guicpp::AbstractProvider;
 
   GUICPP_DISALLOW_COPY_AND_ASSIGN_(ProviderGet);
 };
@@ -182,7 +182,7 @@ class ProviderGet<R(A1, A2, A3, A4)>: public ProviderBase {
   }
 
   template <typename T>
-  friend class AbstractProvider;
+  friend class guicpp::AbstractProvider;
 
   GUICPP_DISALLOW_COPY_AND_ASSIGN_(ProviderGet);
 };
@@ -223,7 +223,7 @@ class ProviderGet<R(A1, A2, A3, A4, A5)>: public ProviderBase {
   }
 
   template <typename T>
-  friend class AbstractProvider;
+  friend class guicpp::AbstractProvider;
 
   GUICPP_DISALLOW_COPY_AND_ASSIGN_(ProviderGet);
 };
@@ -267,7 +267,7 @@ class ProviderGet<R(A1, A2, A3, A4, A5, A6)>: public ProviderBase {
   }
 
   template <typename T>
-  friend class AbstractProvider;
+  friend class guicpp::AbstractProvider;
 
   GUICPP_DISALLOW_COPY_AND_ASSIGN_(ProviderGet);
 };
@@ -314,7 +314,7 @@ class ProviderGet<R(A1, A2, A3, A4, A5, A6, A7)>: public ProviderBase {
   }
 
   template <typename T>
-  friend class AbstractProvider;
+  friend class guicpp::AbstractProvider;
 
   GUICPP_DISALLOW_COPY_AND_ASSIGN_(ProviderGet);
 };
@@ -364,7 +364,7 @@ class ProviderGet<R(A1, A2, A3, A4, A5, A6, A7, A8)>: public ProviderBase {
   }
 
   template <typename T>
-  friend class AbstractProvider;
+  friend class guicpp::AbstractProvider;
 
   GUICPP_DISALLOW_COPY_AND_ASSIGN_(ProviderGet);
 };
@@ -417,7 +417,7 @@ class ProviderGet<R(A1, A2, A3, A4, A5, A6, A7, A8, A9)>: public ProviderBase {
   }
 
   template <typename T>
-  friend class AbstractProvider;
+  friend class guicpp::AbstractProvider;
 
   GUICPP_DISALLOW_COPY_AND_ASSIGN_(ProviderGet);
 };
@@ -475,7 +475,7 @@ class ProviderGet<R(A1, A2, A3, A4, A5, A6, A7, A8, A9,
   }
 
   template <typename T>
-  friend class AbstractProvider;
+  friend class guicpp::AbstractProvider;
 
   GUICPP_DISALLOW_COPY_AND_ASSIGN_(ProviderGet);
 };
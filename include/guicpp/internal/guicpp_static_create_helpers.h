@@ -0,0 +1,162 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+
+// Helper functions used by StaticInjector for creating an instance of user
+// defined class.
+
+#ifndef GUICPP_STATIC_CREATE_HELPERS_H_
+#define GUICPP_STATIC_CREATE_HELPERS_H_
+
+#include "guicpp/internal/guicpp_port.h"
+#include "guicpp/internal/guicpp_types.h"
+
+namespace guicpp {
+namespace internal {
+
+// These helper functions invoke the appropriate constructor after getting
+// all of the target object's dependencies from StaticInjectorType (an
+// instance of StaticInjector template). Unlike CreateHelpers, no bind table
+// or local context is involved and the calls can be inlined completely.
+template <typename StaticInjectorType>
+class StaticCreateHelpers {
+ public:
+  template <typename T>
+  static T* Create(TypeKey<T* (*)()> fp) {
+    return new T();
+  }
+
+  template <typename T, typename A1>
+  static T* Create(TypeKey<T* (*)(A1)> fp) {
+    return new T(
+      StaticInjectorType::template Get<A1>());
+  }
+
+  template <typename T, typename A1, typename A2>
+  static T* Create(TypeKey<T* (*)(A1, A2)> fp) {
+    return new T(
+      StaticInjectorType::template Get<A1>(),
+      StaticInjectorType::template Get<A2>());
+  }
+
+  template <typename T, typename A1, typename A2, typename A3>
+  static T* Create(TypeKey<T* (*)(A1, A2, A3)> fp) {
+    return new T(
+      StaticInjectorType::template Get<A1>(),
+      StaticInjectorType::template Get<A2>(),
+      StaticInjectorType::template Get<A3>());
+  }
+
+  template <typename T, typename A1, typename A2, typename A3, typename A4>
+  static T* Create(TypeKey<T* (*)(A1, A2, A3, A4)> fp) {
+    return new T(
+      StaticInjectorType::template Get<A1>(),
+      StaticInjectorType::template Get<A2>(),
+      StaticInjectorType::template Get<A3>(),
+      StaticInjectorType::template Get<A4>());
+  }
+
+  template <typename T, typename A1, typename A2, typename A3, typename A4,
+      typename A5>
+  static T* Create(TypeKey<T* (*)(A1, A2, A3, A4, A5)> fp) {
+    return new T(
+      StaticInjectorType::template Get<A1>(),
+      StaticInjectorType::template Get<A2>(),
+      StaticInjectorType::template Get<A3>(),
+      StaticInjectorType::template Get<A4>(),
+      StaticInjectorType::template Get<A5>());
+  }
+
+  template <typename T, typename A1, typename A2, typename A3, typename A4,
+      typename A5, typename A6>
+  static T* Create(TypeKey<T* (*)(A1, A2, A3, A4, A5, A6)> fp) {
+    return new T(
+      StaticInjectorType::template Get<A1>(),
+      StaticInjectorType::template Get<A2>(),
+      StaticInjectorType::template Get<A3>(),
+      StaticInjectorType::template Get<A4>(),
+      StaticInjectorType::template Get<A5>(),
+      StaticInjectorType::template Get<A6>());
+  }
+
+  template <typename T, typename A1, typename A2, typename A3, typename A4,
+      typename A5, typename A6, typename A7>
+  static T* Create(TypeKey<T* (*)(A1, A2, A3, A4, A5, A6, A7)> fp) {
+    return new T(
+      StaticInjectorType::template Get<A1>(),
+      StaticInjectorType::template Get<A2>(),
+      StaticInjectorType::template Get<A3>(),
+      StaticInjectorType::template Get<A4>(),
+      StaticInjectorType::template Get<A5>(),
+      StaticInjectorType::template Get<A6>(),
+      StaticInjectorType::template Get<A7>());
+  }
+
+  template <typename T, typename A1, typename A2, typename A3, typename A4,
+      typename A5, typename A6, typename A7, typename A8>
+  static T* Create(TypeKey<T* (*)(A1, A2, A3, A4, A5, A6, A7, A8)> fp) {
+    return new T(
+      StaticInjectorType::template Get<A1>(),
+      StaticInjectorType::template Get<A2>(),
+      StaticInjectorType::template Get<A3>(),
+      StaticInjectorType::template Get<A4>(),
+      StaticInjectorType::template Get<A5>(),
+      StaticInjectorType::template Get<A6>(),
+      StaticInjectorType::template Get<A7>(),
+      StaticInjectorType::template Get<A8>());
+  }
+
+  template <typename T, typename A1, typename A2, typename A3, typename A4,
+      typename A5, typename A6, typename A7, typename A8, typename A9>
+  static T* Create(TypeKey<T* (*)(A1, A2, A3, A4, A5, A6, A7, A8, A9)> fp) {
+    return new T(
+      StaticInjectorType::template Get<A1>(),
+      StaticInjectorType::template Get<A2>(),
+      StaticInjectorType::template Get<A3>(),
+      StaticInjectorType::template Get<A4>(),
+      StaticInjectorType::template Get<A5>(),
+      StaticInjectorType::template Get<A6>(),
+      StaticInjectorType::template Get<A7>(),
+      StaticInjectorType::template Get<A8>(),
+      StaticInjectorType::template Get<A9>());
+  }
+
+  template <typename T, typename A1, typename A2, typename A3, typename A4,
+      typename A5, typename A6, typename A7, typename A8, typename A9,
+      typename A10>
+  static T* Create(TypeKey<T* (*)(A1, A2, A3, A4, A5, A6, A7, A8, A9,
+        A10)> fp) {
+    return new T(
+      StaticInjectorType::template Get<A1>(),
+      StaticInjectorType::template Get<A2>(),
+      StaticInjectorType::template Get<A3>(),
+      StaticInjectorType::template Get<A4>(),
+      StaticInjectorType::template Get<A5>(),
+      StaticInjectorType::template Get<A6>(),
+      StaticInjectorType::template Get<A7>(),
+      StaticInjectorType::template Get<A8>(),
+      StaticInjectorType::template Get<A9>(),
+      StaticInjectorType::template Get<A10>());
+  }
+
+ private:
+  GUICPP_DISALLOW_IMPLICIT_CONSTRUCTORS_(StaticCreateHelpers);
+};
+
+}  // namespace internal
+}  // namespace guicpp
+
+#endif  // GUICPP_STATIC_CREATE_HELPERS_H_
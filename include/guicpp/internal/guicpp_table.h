@@ -18,7 +18,13 @@
 #ifndef GUICPP_TABLE_H_
 #define GUICPP_TABLE_H_
 
+#include <stddef.h>
+
+#include <new>
+#include <utility>
+
 #include "guicpp/internal/guicpp_port.h"
+#include "guicpp/internal/guicpp_arena.h"
 #include "guicpp/internal/guicpp_types.h"
 #include "guicpp/internal/guicpp_util.h"
 
@@ -65,6 +71,22 @@ class TableEntryBase {
     // called by injecting all the argument required by factory.
     BIND_TO_PROVIDER,
 
+    // Binds std::vector<T*> to the set of instances added using
+    // Binder::AddToSet(). The instances are created on first request.
+    BIND_TO_SET,
+
+    // Binds std::map<K, T*> to the instances added using Binder::AddToMap().
+    // The instances are created on first request.
+    BIND_TO_MAP,
+
+    // Binds a pointer type to an instance that can be replaced after the
+    // injector is created (see Binder::BindToSwappableInstance()).
+    BIND_TO_SWAPPABLE_INSTANCE,
+
+    // Wraps the instance of the entry it decorates in a decorator (see
+    // Binder::Decorate()).
+    BIND_TO_DECORATOR,
+
     // Used for factory arguments.
     // This binds type of argument to the value passed to the factory. The
     // values are picked from local_context filled by factory's Get() method.
@@ -89,6 +111,13 @@ class TableEntryBase {
   // Returns type of binding.
   virtual BindType GetBindType() const = 0;
 
+  // Returns true if the entry returns one of a fixed set of instances, owned
+  // by the injector and never replaced (e.g. a singleton or an instance),
+  // rather than a new instance owned by the caller.
+  virtual bool HasStableInstances(const Injector* /* injector */) const {
+    return false;
+  }
+
  protected:
   TableEntryBase() {}
 };
@@ -149,6 +178,99 @@ class InvalidEntry: public TableEntryBase {
   }
 };
 
+class BindTable;
+
+// Installs a module whose installation is deferred until one of the types it
+// binds is looked up, see Binder::InstallDeferred(). Like CleanupEntry, this
+// is never added to the bind table but is owned through its cleanup list.
+class DeferredInstaller: public InvalidEntry {
+ public:
+  virtual ~DeferredInstaller() {}
+
+  // Adds the bindings of the module to bind_table. Called at most once.
+  virtual void Install(BindTable* bind_table) const = 0;
+
+ protected:
+  DeferredInstaller() {}
+};
+
+// Links a decorator added using Binder::Decorate() to the entry it
+// decorates. Implemented by the entry of the decorator.
+class DecoratorLink {
+ public:
+  virtual ~DecoratorLink() {}
+
+  // Makes this decorator wrap the instances of "decorated", and returns the
+  // entry that replaces "decorated" in the bind table.
+  virtual const TableEntryBase* Decorate(
+      const TableEntryBase* decorated) const = 0;
+
+ protected:
+  DecoratorLink() {}
+};
+
+// Memory used by the entries of a bind table, returned by
+// Injector::MemoryStats(). Only the entries created using
+// BindTable::NewEntry() are counted, which includes all the entries
+// created by Binder.
+struct BindTableMemoryStats {
+  BindTableMemoryStats();
+
+  // Number of entries and the bytes used by them, indexed by the BindType.
+  // Cleanup actions are counted as INVALID_BIND.
+  int num_entries[TableEntryBase::INVALID_BIND + 1];
+  size_t entry_bytes[TableEntryBase::INVALID_BIND + 1];
+
+  // Total size of the arena holding the entries. This is more than sum of
+  // entry_bytes because of alignment and unused space in the last block.
+  size_t arena_bytes;
+};
+
+// Usage of a binding, see BindTableUsageReport.
+struct BindingUsage {
+  BindingUsage(TypeId bind_id, TableEntryBase::BindType bind_type,
+               uint64 num_lookups, size_t entry_bytes);
+
+  // bindId of the binding. The binding of (annotated) type T can be
+  // identified by comparing it with InjectorUtil::GetBindId().
+  TypeId bind_id;
+  TableEntryBase::BindType bind_type;
+
+  // Number of times the binding is looked up, that is the number of
+  // instances injected using it.
+  uint64 num_lookups;
+
+  // Bytes of the entry in the arena of the bind table, as counted by
+  // BindTableMemoryStats::entry_bytes. The instance held by the entry (or
+  // created by it) is not counted, as its type may be incomplete. 0 if the
+  // entry is not created using BindTable::NewEntry(), or is created before
+  // the lookup counters are enabled.
+  size_t entry_bytes;
+};
+
+// Usage of the bindings of a bind table, returned by Injector::UsageReport().
+// The report is empty unless lookup counters are enabled using
+// Binder::EnableUsageCounters().
+struct BindTableUsageReport {
+  BindTableUsageReport();
+
+  // True if lookup counters are enabled.
+  bool is_enabled;
+
+  // Bindings that are never looked up, in order of bindId. Bindings of
+  // deferred modules that are not installed are not listed.
+  vector<BindingUsage> unused_bindings;
+
+  // Sum of entry_bytes of unused_bindings.
+  size_t unused_entry_bytes;
+
+  // Bindings that are looked up most, in decreasing order of num_lookups.
+  vector<BindingUsage> hot_bindings;
+};
+
+// Returns name of the bind type, used for reporting.
+const char* GetBindTypeString(TableEntryBase::BindType bind_type);
+
 // The Bind Table, this maps type IDs to TableEntryBase objects.
 // This table is created during creation of injector and referred
 // many times while creating objects.
@@ -159,26 +281,279 @@ class BindTable {
 
   // Finds and returns entry associated with bindId.
   // This return null if no entry found.
+  //
+  // While binding, the entries added since the last merge are found using a
+  // hash index; They are sorted and merged once, by MergeEntries().
+  //
+  // Once the injector is created (see SetShared()) this may be called from
+  // several threads. Lookups read the published snapshot of the sorted
+  // entries without locking. Only a miss on a bindId of a deferred installer
+  // takes a lock: Deferred installs are serialized, and a thread waiting for
+  // another to install the same module finds its entries when it gets the
+  // lock.
+  //
+  // If GUICPP_ENABLE_LOOKUP_CACHE is defined, the result is also kept in a
+  // small per-thread cache that is looked up before the sorted entries. This
+  // helps when the same few types are requested many times.
   const TableEntryBase* FindEntry(TypeId bindId) const;
 
+#ifdef GUICPP_ENABLE_LOOKUP_CACHE
+  // Returns the number of FindEntry() calls of the calling thread that were
+  // served by its lookup cache, for all tables. Used by tests.
+  static uint64 GetNumLookupCacheHits();
+#endif  // GUICPP_ENABLE_LOOKUP_CACHE
+
+  // Returns the entry added for bindId so far, or NULL. Unlike FindEntry(),
+  // this does not apply pending decorators, does not call deferred
+  // installers and does not count the lookup. Used while binding.
+  const TableEntryBase* FindAddedEntry(TypeId bindId) const;
+
   // Adds entry for bindId.
   // If the table already has an entry for bindId, the entry is not added to the
   // bind table. The ownership of the entry is assumed even in error cases, that
   // is entry is added to cleanup list even in error cases.
+  //
+  // Returns false if bindId is found in the sorted entries. Entries added
+  // since the last merge are not checked here; Duplicates among them are
+  // detected (and logged) when they are merged, see MergeEntries().
   bool AddEntry(TypeId bindId, const TableEntryBase* entry);
 
+  // Merges the entries added since the last merge into the sorted entries
+  // using a single sort, and returns the number of duplicate entries found
+  // in all merges so far plus the number of decorators whose bindId is not
+  // bound. Injector::Create() calls this once the module is configured.
+  // Merge also happens after a deferred installer is called, and when
+  // FindEntry() looks up a bindId having a pending decorator.
+  int MergeEntries();
+
+  // Called by Injector::Create() once the bindings are merged. From then on
+  // the table may be looked up by several threads: The sorted entries are
+  // never modified in place, entries added by deferred installers are
+  // published as a new snapshot and the replaced snapshots are kept until the
+  // table is deleted, as lookups (and the lookup cache) may still use them.
+  void SetShared() { is_shared_ = true; }
+
+  // Adds "decorator" for bindId. The entry of bindId is replaced by the
+  // entry returned by decorator->Decorate() on the next merge, even if the
+  // entry is already merged; Hence the chain of decorators is resolved once
+  // and FindEntry() returns the outermost decorator. Decorators of a bindId
+  // are applied in order of addition, the last one added is the outermost.
+  //
+  // "entry" is the entry implementing "decorator"; The table assumes its
+  // ownership.
+  void AddDecorator(TypeId bindId, const TableEntryBase* entry,
+                    const DecoratorLink* decorator);
+
+  // Registers "installer" for each of the bind_ids. If FindEntry() does not
+  // find an entry for one of these bindIds, the installer is called (once)
+  // to add the entries and the lookup is retried. The table assumes the
+  // ownership of the installer.
+  //
+  // Returns false if some bindId already has an installer; The installer is
+  // registered for the remaining bindIds.
+  bool AddDeferredInstaller(const vector<TypeId>& bind_ids,
+                            const DeferredInstaller* installer);
+
+  // Returns an id that is not used by any other table, even one that is
+  // deleted. It is never 0.
+  uint64 id() const { return id_; }
+
+  // Returns the entry added for "tid" using AddSharedEntry(), or NULL.
+  //
+  // Shared entries hold instances that are created on the first injection
+  // of a type and are shared by its later injections, such as factories
+  // injected by const reference. They are kept apart from the bindings;
+  // FindEntry() does not return them. This does not lock: The shared entries
+  // are published like the snapshots of the bindings.
+  const TableEntryBase* FindSharedEntry(TypeId tid) const;
+
+  // Adds "entry" for "tid" unless there is an entry for "tid" already, and
+  // returns the entry for "tid". The table assumes the ownership of "entry";
+  // It is deleted right away if it is not added. Unlike AddEntry(), this can
+  // be called after the injector is created and from different threads.
+  const TableEntryBase* AddSharedEntry(TypeId tid,
+                                       const TableEntryBase* entry) const;
+
   // Adds an entry cleanup list.
   // AddEntry() internally calls AddToCleanupList(). This is called only for
   // entries that are not added to bind_map_ but needs to deleted at cleanup
   // time. All entries are deleted in reverse order of addition.
   void AddToCleanupList(const TableEntryBase* entry);
 
+  // Creates an entry of type EntryType in the arena owned by this table,
+  // passing the arguments to its constructor. The entry must be passed to
+  // AddEntry() or AddToCleanupList() which then owns it, as it does for
+  // entries allocated by new.
+  template <typename EntryType>
+  EntryType* NewEntry();
+
+  template <typename EntryType, typename A1>
+  EntryType* NewEntry(const A1& a1);
+
+  template <typename EntryType, typename A1, typename A2>
+  EntryType* NewEntry(const A1& a1, const A2& a2);
+
+  // Returns memory used by the entries created using NewEntry().
+  BindTableMemoryStats MemoryStats() const;
+
+  // Makes FindEntry() count the lookups of each entry. The counters are
+  // kept in the sorted entries and cost one relaxed atomic increment per
+  // lookup. Lookups counted in a snapshot while a deferred installer
+  // replaces it are lost. The bytes of the entries created from then on are
+  // kept for UsageReport().
+  void EnableLookupCounters() { count_lookups_ = true; }
+
+  // Returns the usage of the bindings, listing at most "max_hot_bindings"
+  // bindings as hot bindings.
+  BindTableUsageReport UsageReport(size_t max_hot_bindings) const;
+
  private:
-  map<TypeId, const TableEntryBase*> bind_map_;
+  // A bindId, the entry bound to it and the number of times it is looked up
+  // (counted only if count_lookups_ is set).
+  struct BindEntry {
+    BindEntry(TypeId bind_id, const TableEntryBase* entry)
+        : bind_id(bind_id), entry(entry), num_lookups(0) {}
+
+    TypeId bind_id;
+    const TableEntryBase* entry;
+    mutable uint64 num_lookups;
+  };
+
+  // The entries seen by lookups. A snapshot is not modified once it is
+  // published, except for the lookup counters.
+  struct Snapshot {
+    Snapshot(): generation(0) {}
+
+    // Identifies the snapshot in the lookup cache. A new value, unique
+    // across all tables, is assigned to every snapshot; Hence cached results
+    // of an older snapshot (or of a deleted table) are never returned. Used
+    // only if GUICPP_ENABLE_LOOKUP_CACHE is defined.
+    uint64 generation;
+
+    // Entries sorted by bindId, without duplicates. This is looked up using
+    // binary search.
+    vector<BindEntry> entries;
+
+    // Sorted bindIds having a deferred installer. A miss on other bindIds
+    // returns NULL without locking.
+    vector<TypeId> deferred_bind_ids;
+  };
+
+  // Orders BindEntry by bindId.
+  struct CompareBindId;
+
+  // Looks up the sorted entries without using the lookup cache.
+  const BindEntry* FindEntryUncached(TypeId bindId) const;
+
+  // Looks up the sorted and the pending entries, calling the deferred
+  // installer of bindId on a miss. The caller must be the only one modifying
+  // the table: Either the table is not shared yet, or the caller holds
+  // update_mu_.
+  const BindEntry* FindOrInstall(TypeId bindId) const;
+
+  // Returns the first pending entry added for bindId, or NULL.
+  const BindEntry* FindPendingEntry(TypeId bindId) const;
+
+  // Adds the last entry of pending_entries_ to pending_index_.
+  void IndexLastPendingEntry();
+  void IndexPendingEntry(size_t i);
+
+  // Looks up bindId in "entries".
+  static const BindEntry* FindSortedEntry(TypeId bindId,
+                                          const vector<BindEntry>& entries);
+
+  // Publishes a new snapshot holding the sorted entries and pending_entries_
+  // (dropping duplicates), with the pending decorators of the bound
+  // bindIds applied. Does nothing if the table is not modified since the
+  // last snapshot.
+  void MergePendingEntries() const;
+
+  // Calls the installer registered for bindId, if any, and returns the
+  // entry for bindId added by it. Same requirements as FindOrInstall().
+  const BindEntry* InstallDeferred(TypeId bindId) const;
+
+  // Deletes the entries in reverse order, along with the entries added by
+  // the deferred installers among them.
+  void DeleteEntries(const vector<const TableEntryBase*>& entries);
+
+  // Returns memory for an entry of "size" bytes from arena_.
+  void* AllocateEntry(size_t size);
+
+  // Updates memory_stats_ for entry created using NewEntry().
+  void RecordNewEntry(const TableEntryBase* entry, size_t size);
+
+  // Holds the entries created using NewEntry(). These entries are destroyed
+  // by ~BindTable() in cleanup order and their memory is freed in bulk.
+  Arena arena_;
+
+  BindTableMemoryStats memory_stats_;
+
+  // Bytes of each entry created using NewEntry() once the lookup counters
+  // are enabled, see BindingUsage::entry_bytes.
+  map<const TableEntryBase*, size_t> entry_bytes_;
+
+  // The current snapshot, published using ReleaseStore(). Never NULL.
+  mutable const Snapshot* snapshot_;
+
+  // Snapshots replaced after the table is shared.
+  mutable vector<const Snapshot*> retired_snapshots_;
+
+  // Set by SetShared().
+  bool is_shared_;
+
+  // Serializes the changes made after the table is shared, which are made
+  // only by deferred installers.
+  mutable Mutex update_mu_;
+
+  // Whether the table is modified since snapshot_ was published.
+  mutable bool is_modified_;
+
+  // Entries added since last merge, in order of addition. Adding to a vector
+  // and sorting once is much cheaper than inserting each entry to a map.
+  //
+  // These are mutable as FindEntry() may merge them. Once the injector is
+  // created there are pending entries only while a deferred installer runs.
+  mutable vector<BindEntry> pending_entries_;
+
+  // Open addressing hash table of 2^pending_index_bits_ slots, each holding
+  // 1 + the position of the first pending entry of a bindId, or 0 if the
+  // slot is free. It is kept at most half full. Binder looks up while
+  // binding (e.g. for ScopeSetupContext), and merging on each such lookup
+  // would copy all the sorted entries every time.
+  mutable vector<size_t> pending_index_;
+  int pending_index_bits_;
+
+  // Number of duplicate entries found while merging.
+  mutable int num_duplicates_;
+
+  // Set by EnableLookupCounters().
+  bool count_lookups_;
+
+  // Decorators that are not yet applied, by bindId, in order of addition.
+  mutable map<TypeId, vector<const DecoratorLink*> > pending_decorators_;
+
+  // Installers of deferred modules, by the bindIds they provide. An
+  // installer is removed (for all its bindIds) before it is called.
+  mutable map<TypeId, const DeferredInstaller*> deferred_installers_;
 
   // This vector maintains entries in the order they are added.
   vector<const TableEntryBase*> cleanup_list_;
 
+  const uint64 id_;  // See id().
+
+  // Entries added using AddSharedEntry(), sorted by tid and published using
+  // ReleaseStore(). Each addition publishes a new copy, the replaced ones are
+  // kept until the table is deleted. The entries are deleted before the
+  // entries in cleanup_list_ as the shared instances may use them.
+  mutable Mutex shared_entries_mu_;  // Serializes AddSharedEntry().
+  mutable const vector<BindEntry>* shared_entries_;
+  mutable vector<const vector<BindEntry>*> retired_shared_entries_;
+
+  // Entries added by each deferred installer that is called, in the order
+  // they are added.
+  map<const TableEntryBase*, vector<const TableEntryBase*> >
+      deferred_cleanup_lists_;
+
   GUICPP_DISALLOW_COPY_AND_ASSIGN_(BindTable);
 };
 
@@ -276,6 +651,29 @@ class TableEntryReader {
 
 // -- Implementation --
 
+// Creates an entry in arena_.
+template <typename EntryType>
+EntryType* BindTable::NewEntry() {
+  EntryType* entry = new(AllocateEntry(sizeof(EntryType))) EntryType();
+  RecordNewEntry(entry, sizeof(EntryType));
+  return entry;
+}
+
+template <typename EntryType, typename A1>
+EntryType* BindTable::NewEntry(const A1& a1) {
+  EntryType* entry = new(AllocateEntry(sizeof(EntryType))) EntryType(a1);
+  RecordNewEntry(entry, sizeof(EntryType));
+  return entry;
+}
+
+template <typename EntryType, typename A1, typename A2>
+EntryType* BindTable::NewEntry(const A1& a1, const A2& a2) {
+  EntryType* entry =
+      new(AllocateEntry(sizeof(EntryType))) EntryType(a1, a2);
+  RecordNewEntry(entry, sizeof(EntryType));
+  return entry;
+}
+
 // static
 template <typename T>
 inline T TableEntryReader<T>::Get(const TableEntryBase* entry_base,
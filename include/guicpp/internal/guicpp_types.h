@@ -34,6 +34,9 @@ typedef const void* TypeId;
 // internal type.
 class InternalType {};
 
+// A base class used only to identify if the given type is guicpp::Lazy.
+class LazyBase: public InternalType {};
+
 // Removes parentheses from its arguments.
 // INTERNAL USE ONLY - do not invoke from the user code.
 #define GUICPP_RM_PARENTHESES_(...) __VA_ARGS__
@@ -74,64 +74,30 @@ inline T Invalid() {
 
 typedef Annotations<> EmptyAnnotations;
 
-// This class is used by AtUtil when an attribute is not annotated.
-// This class is similar to "At" class with zero annotations. We do not allow
-// user to use At with zero annotations for readability.
-template <typename T>
-class NotAnnotated {
- public:
-  typedef T ArgType;
-  typedef EmptyAnnotations Annotations;
-
- private:
-  GUICPP_DISALLOW_IMPLICIT_CONSTRUCTORS_(NotAnnotated);
-};
-
 // This utility class lets us deal with arguments which may be annotated.
 class AtUtil {
  public:
+  // Types of an argument that is not annotated. Annotated arguments are
+  // handled by the specialization for "At" below.
   template <typename T>
   class GetTypes {
-   private:
-    // We add "remove_reference" just to avoid compiler error in case T is a
-    // reference. Explicit check for reference will make overall condition
-    // evaluate to false. We could also use is_convertible<T&, AtBaseClass&>
-    // but that will need "T" to be a complete type.
-    typedef typename guicpp::internal::if_<
-        (!guicpp::internal::is_reference<T>::value) &&
-        guicpp::internal::is_convertible<
-            typename guicpp::internal::remove_reference<T>::type*,
-            AtBaseClass*>::value,
-         // true
-            T,
-         // else
-            NotAnnotated<T> >::type AnnotatedType;
-
    public:
-    typedef typename AnnotatedType::ArgType ArgType;
+    typedef T ArgType;
     typedef typename guicpp::internal::remove_cv<ArgType>::type ActualType;
-    typedef typename AnnotatedType::Annotations Annotations;
+    typedef EmptyAnnotations Annotations;
 
    private:
     GUICPP_DISALLOW_IMPLICIT_CONSTRUCTORS_(GetTypes);
   };
 
-  // Gets value of annotation of Lookup type.
-  // Getting it is simple, it is just Entries<Lookup>::type but we need to check
-  // if annotation of Lookup type is specified before to referring to "type"
+  // Gets value of annotation of Lookup type, see Annotations::Select.
   template <typename Annotations,
             typename Lookup,
             typename DefaultValue = typename Lookup::AnnotationDefaultValue>
   class GetAt {
    public:
-    typedef typename guicpp::internal::if_<
-      guicpp::internal::is_convertible<
-          typename Annotations::template Entries<NoArg>*,
-          AtEntryBase<Lookup>*>::value,
-       // true
-          typename Annotations::template Entries<Lookup>,
-       // false
-          identity_<DefaultValue> >::type::type Type;
+    typedef typename Annotations::template Select<
+        Lookup, DefaultValue>::type Type;
 
    private:
     GUICPP_DISALLOW_IMPLICIT_CONSTRUCTORS_(GetAt);
@@ -141,6 +107,19 @@ class AtUtil {
   GUICPP_DISALLOW_IMPLICIT_CONSTRUCTORS_(AtUtil);
 };
 
+// Types of an annotated argument. Matching "At" by partial specialization
+// avoids instantiating an is_convertible test for every argument type.
+template <typename A1, typename A2, typename T>
+class AtUtil::GetTypes<At<A1, A2, T> > {
+ public:
+  typedef typename At<A1, A2, T>::ArgType ArgType;
+  typedef typename guicpp::internal::remove_cv<ArgType>::type ActualType;
+  typedef typename At<A1, A2, T>::Annotations Annotations;
+
+ private:
+  GUICPP_DISALLOW_IMPLICIT_CONSTRUCTORS_(GetTypes);
+};
+
 }  // namespace internal
 }  // namespace guicpp
 
@@ -0,0 +1,85 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// This file defines the methods of Arena class declared in arena.h.
+
+#include "guicpp/internal/guicpp_arena.h"
+
+#include <map>
+#include <utility>
+
+namespace guicpp {
+namespace internal {
+// Definitions of the static constants.
+const size_t Arena::kBlockSize;
+const size_t Arena::kAlignment;
+
+Arena::Arena(): next_(NULL), available_(0), bytes_reserved_(0) {
+}
+
+Arena::~Arena() {
+  for (map<const char*, size_t>::iterator iter = blocks_.begin();
+       iter != blocks_.end(); ++iter) {
+    delete[] iter->first;
+  }
+}
+
+// Returns "size" bytes of memory aligned for any type.
+void* Arena::Allocate(size_t size) {
+  size = (size + kAlignment - 1) & ~(kAlignment - 1);
+
+  if (size > kBlockSize / 4) {
+    // Large allocations do not waste the rest of the current block.
+    return NewBlock(size);
+  }
+
+  if (size > available_) {
+    next_ = NewBlock(kBlockSize);
+    available_ = kBlockSize;
+  }
+
+  char* ptr = next_;
+  next_ += size;
+  available_ -= size;
+  return ptr;
+}
+
+// Returns true if ptr points to memory returned by Allocate().
+bool Arena::Contains(const void* ptr) const {
+  const char* char_ptr = static_cast<const char*>(ptr);
+
+  // Finds the last block that starts at or before ptr.
+  map<const char*, size_t>::const_iterator iter =
+      blocks_.upper_bound(char_ptr);
+  if (iter == blocks_.begin()) {
+    return false;
+  }
+
+  --iter;
+  return char_ptr < iter->first + iter->second;
+}
+
+// Allocates a new block of "size" bytes.
+char* Arena::NewBlock(size_t size) {
+  // Memory returned by new[] is suitably aligned for any type that fits in.
+  char* block = new char[size];
+  blocks_.insert(make_pair(block, size));
+  bytes_reserved_ += size;
+  return block;
+}
+
+}  // namespace internal
+}  // namespace guicpp
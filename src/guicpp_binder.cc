@@ -18,10 +18,38 @@
 #include "guicpp/guicpp_binder.h"
 
 #include "guicpp/internal/guicpp_port.h"
+#include "guicpp/guicpp_deferred_module.h"
 #include "guicpp/guicpp_module.h"
+#include "guicpp/guicpp_scope.h"
+#include "guicpp/guicpp_singleton.h"
 #include "guicpp/internal/guicpp_table.h"
 
 namespace guicpp  {
+// Installer registered by InstallDeferred(). This is called by the bind table
+// when one of the declared types is looked up.
+class Binder::DeferredModuleInstaller: public internal::DeferredInstaller {
+ public:
+  explicit DeferredModuleInstaller(const DeferredModule* module)
+      : module_(module) {}
+
+  // Configures the module with a new binder, as Injector::Create() does.
+  virtual void Install(internal::BindTable* bind_table) const {
+    Binder binder(bind_table);
+    module_->Configure(&binder);
+
+    int num_errors = binder.num_errors() + bind_table->MergeEntries();
+    if (num_errors != 0) {
+      GUICPP_LOG_(FATAL) << "Installation of deferred module failed: "
+                         << "Module had " << num_errors << " errors. ";
+    }
+  }
+
+ private:
+  const DeferredModule* module_;
+
+  GUICPP_DISALLOW_COPY_AND_ASSIGN_(DeferredModuleInstaller);
+};
+
 Binder::Binder(internal::BindTable* bind_table)
     : bind_table_(bind_table), num_errors_(0) {
 }
@@ -43,6 +71,36 @@ void Binder::AddBindEntry(internal::TypeId tid,
   }
 }
 
+// Adds "setup" to the init list of ScopeSetupContext.
+void Binder::AddToScopeInitList(internal::SetupInterface* setup) {
+  internal::ScopeSetupContext* context =
+      GetBoundInstance<internal::ScopeSetupContext>();
+
+  if (context == NULL) {
+    GUICPP_LOG_(FATAL) << "Looks like you are using Injector::Create() to "
+        "create the injector. You must use guicpp::CreateInjector() "
+        "for asynchronous providers to work";
+    return;  // Unreachable
+  }
+
+  context->AddToInitList(setup);
+}
+
+// Attaches "provider" of a custom scope to ScopeSetupContext.
+void Binder::AttachScopeProvider(internal::ScopeProviderBase* provider) {
+  internal::ScopeSetupContext* context =
+      GetBoundInstance<internal::ScopeSetupContext>();
+
+  if (context == NULL) {
+    GUICPP_LOG_(FATAL) << "Looks like you are using Injector::Create() to "
+        "create the injector. You must use guicpp::CreateInjector() "
+        "for scopes to work";
+    return;  // Unreachable
+  }
+
+  provider->AttachToContext(context);
+}
+
 // Include bindings specified in module.
 //
 // Implementation detail:
@@ -55,4 +113,24 @@ void Binder::Install(const Module* module) {
   module->Configure(this);
 }
 
+// Registers module to be installed on first lookup of its declared types.
+void Binder::InstallDeferred(const DeferredModule* module) {
+  DeferredKeys keys;
+  module->DeclareKeys(&keys);
+
+  if (!bind_table_->AddDeferredInstaller(
+          keys.bind_ids(),
+          bind_table_->NewEntry<DeferredModuleInstaller>(module))) {
+    GUICPP_LOG_(ERROR) << "Duplicate Binding: Type is already declared by "
+                          "another deferred module.";
+
+    ++num_errors_;
+  }
+}
+
+// Makes the bind table count lookups of each binding.
+void Binder::EnableUsageCounters() {
+  bind_table_->EnableLookupCounters();
+}
+
 }  // namespace guicpp
@@ -0,0 +1,40 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Defines non-template functions declared in executor.h.
+
+#include "guicpp/guicpp_executor.h"
+
+#include "guicpp/internal/guicpp_inject_util.h"
+#include "guicpp/internal/guicpp_local_context.h"
+#include "guicpp/internal/guicpp_table.h"
+
+namespace guicpp {
+namespace internal {
+
+// Returns the executor bound to bind_id or NULL if there is no such binding.
+Executor* FindBoundExecutor(const Injector* injector, TypeId bind_id) {
+  InjectorUtil inject_util(injector);
+  const TableEntryBase* base_entry = inject_util.FindEntry(bind_id);
+  if (base_entry == NULL) {
+    return NULL;
+  }
+
+  LocalContext local_context;
+  return TableEntryReader<Executor*>::Get(base_entry, injector, &local_context);
+}
+
+}  // namespace internal
+}  // namespace guicpp
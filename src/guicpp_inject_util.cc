@@ -25,5 +25,18 @@ const TableEntryBase* InjectorUtil::FindEntry(TypeId bindId) const {
   return injector_->bind_table_->FindEntry(bindId);
 }
 
+uint64 InjectorUtil::GetTableId() const {
+  return injector_->bind_table_->id();
+}
+
+const TableEntryBase* InjectorUtil::FindSharedEntry(TypeId tid) const {
+  return injector_->bind_table_->FindSharedEntry(tid);
+}
+
+const TableEntryBase* InjectorUtil::AddSharedEntry(
+    TypeId tid, const TableEntryBase* entry) const {
+  return injector_->bind_table_->AddSharedEntry(tid, entry);
+}
+
 }  // namespace internal
 }  // namespace guicpp
@@ -29,6 +29,17 @@ Injector::Injector(internal::BindTable* bind_table)
 
 Injector::~Injector() {}
 
+// Returns memory used by the bindings.
+internal::BindTableMemoryStats Injector::MemoryStats() const {
+  return bind_table_->MemoryStats();
+}
+
+// Returns usage of the bindings.
+internal::BindTableUsageReport Injector::UsageReport(
+    size_t max_hot_bindings) const {
+  return bind_table_->UsageReport(max_hot_bindings);
+}
+
 // This is used to create Injector having all the bindings specified
 // in module. This will call module->Configure().
 // static
@@ -41,11 +52,16 @@ Injector* Injector::Create(const Module* module) {
 
   module->Configure(&binder);  // This will populate the bind_table.
 
-  if (binder.num_errors() != 0) {
+  // Duplicate bindings are detected when the bindings are merged.
+  int num_errors =
+      binder.num_errors() + injector->bind_table_->MergeEntries();
+
+  if (num_errors != 0) {
     GUICPP_LOG_(FATAL) << "Creation of Injector failed: "
-                       << "Module had " << binder.num_errors() << " errors. ";
+                       << "Module had " << num_errors << " errors. ";
   }
 
+  injector->bind_table_->SetShared();
   return injector;
 }
 
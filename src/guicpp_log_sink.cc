@@ -0,0 +1,130 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// Defines methods of AsyncLogSink declared in log_sink.h.
+
+#include "guicpp/guicpp_log_sink.h"
+
+#include <sstream>
+
+namespace guicpp {
+namespace {
+// Number of threads that have been assigned a shard.
+int32 num_sharded_threads = 0;
+
+// Shard index of the calling thread, or -1 if it is not assigned yet. The
+// same index is used for all sinks.
+GUICPP_THREAD_LOCAL_ int thread_shard_index = -1;
+}  // namespace
+
+class AsyncLogSink::FlushClosure: public Closure {
+ public:
+  FlushClosure(AsyncLogSink* sink, Shard* shard): sink_(sink), shard_(shard) {}
+
+  void Run() {
+    sink_->FlushShard(shard_);
+  }
+
+ private:
+  AsyncLogSink* const sink_;
+  Shard* const shard_;
+};
+
+const size_t AsyncLogSink::kDefaultMaxShardBytes;
+
+AsyncLogSink::AsyncLogSink(::std::ostream* stream, Executor* executor,
+                           size_t max_shard_bytes)
+    : stream_(stream), executor_(executor), max_shard_bytes_(max_shard_bytes),
+      num_dropped_(0) {}
+
+AsyncLogSink::~AsyncLogSink() {
+  Flush();
+}
+
+// Threads are assigned the shards in a round-robin order.
+AsyncLogSink::Shard* AsyncLogSink::GetShard() {
+  if (thread_shard_index < 0) {
+    thread_shard_index =
+        AtomicIncrement(&num_sharded_threads, 1) % kNumShards;
+  }
+
+  return &shards_[thread_shard_index];
+}
+
+// Appends the message to the buffer of the calling thread's shard.
+void AsyncLogSink::Send(internal::GuicppLogSeverity severity,
+                        const ::std::string& message) {
+  Shard* shard = GetShard();
+  bool schedule_flush = false;
+  {
+    internal::MutexLock lock(&shard->mu);
+    if (severity != internal::GUICPP_FATAL &&
+        shard->buffer.size() + message.size() > max_shard_bytes_) {
+      // The write scheduled when the shard became non-empty reports it.
+      ++shard->num_dropped;
+      IncrementCounter(&num_dropped_);
+      return;
+    }
+
+    shard->buffer.append(message);
+
+    if (!shard->is_flush_scheduled) {
+      shard->is_flush_scheduled = true;
+      schedule_flush = true;
+    }
+  }
+
+  // Scheduled outside the lock, as the executor may run the closure
+  // immediately.
+  if (schedule_flush) {
+    executor_->Schedule(new FlushClosure(this, shard));
+  }
+}
+
+void AsyncLogSink::Flush() {
+  for (int i = 0; i < kNumShards; ++i) {
+    FlushShard(&shards_[i]);
+  }
+}
+
+// Writes out the buffered messages of the shard.
+void AsyncLogSink::FlushShard(Shard* shard) {
+  internal::MutexLock stream_lock(&stream_mu_);
+
+  ::std::string buffer;
+  uint64 num_dropped;
+  {
+    internal::MutexLock lock(&shard->mu);
+    buffer.swap(shard->buffer);
+    num_dropped = shard->num_dropped;
+    shard->num_dropped = 0;
+    shard->is_flush_scheduled = false;
+  }
+
+  if (num_dropped > 0) {
+    ::std::ostringstream note;
+    note << "AsyncLogSink: " << num_dropped
+         << " messages dropped, the buffer is full\n";
+    buffer.append(note.str());
+  }
+
+  if (!buffer.empty()) {
+    stream_->write(buffer.data(), buffer.size());
+    stream_->flush();
+  }
+}
+
+}  // namespace guicpp
@@ -0,0 +1,75 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Defines non-template functions declared in per_numa_node_singleton.h.
+
+#include "guicpp/guicpp_per_numa_node_singleton.h"
+
+#include "guicpp/internal/guicpp_inject_util.h"
+#include "guicpp/internal/guicpp_local_context.h"
+#include "guicpp/internal/guicpp_table.h"
+
+namespace guicpp {
+void* NumaTopology::AllocateOnNode(size_t size, int /* node */) const {
+  return new char[size];
+}
+
+void NumaTopology::FreeOnNode(void* memory, size_t /* size */,
+                              int /* node */) const {
+  delete[] static_cast<char*>(memory);
+}
+
+namespace internal {
+
+// Same as FindBoundExecutor(), for NumaTopology.
+NumaTopology* FindBoundNumaTopology(const Injector* injector) {
+  InjectorUtil inject_util(injector);
+  const TableEntryBase* base_entry = inject_util.FindEntry(
+      InjectorUtil::GetBindId<Annotations<>, NumaTopology*>());
+  if (base_entry == NULL) {
+    return NULL;
+  }
+
+  LocalContext local_context;
+  return TableEntryReader<NumaTopology*>::Get(
+      base_entry, injector, &local_context);
+}
+
+void* AllocateReplica(const NumaTopology* topology, size_t size, int node) {
+  if (topology == NULL) {
+    return new char[size];
+  }
+
+  return topology->AllocateOnNode(size, node);
+}
+
+void FreeReplica(const NumaTopology* topology, void* memory, size_t size,
+                 int node) {
+  if (topology == NULL) {
+    delete[] static_cast<char*>(memory);
+    return;
+  }
+
+  topology->FreeOnNode(memory, size, node);
+}
+
+// Logged once per binding, as it is detected on a request.
+void LogInvalidNumaNode(const int* node) {
+  GUICPP_LOG_(ERROR) << "NumaTopology::GetCurrentNode() returned invalid "
+      "node " << *node << "; Node 0 is used for such requests";
+}
+
+}  // namespace internal
+}  // namespace guicpp
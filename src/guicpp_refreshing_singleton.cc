@@ -0,0 +1,33 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "guicpp/guicpp_refreshing_singleton.h"
+
+namespace guicpp {
+
+void SingletonRefresher::Refresh() {
+  std::vector<internal::RefreshInterface*> refresh_list = GetRefreshList();
+  for (std::vector<internal::RefreshInterface*>::iterator iter =
+       refresh_list.begin(); iter != refresh_list.end(); ++iter) {
+    (*iter)->Refresh();
+  }
+}
+
+std::vector<internal::RefreshInterface*> SingletonRefresher::GetRefreshList() {
+  internal::MutexLock lock(&mu_);
+  return refresh_list_;
+}
+
+}  // namespace guicpp
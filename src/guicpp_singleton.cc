@@ -14,30 +14,79 @@
 
 
 #include <algorithm>
+#include <new>
 #include "guicpp/guicpp_singleton.h"
 
 namespace guicpp {
 namespace internal {
+using std::copy;
 using std::find;
 
+ScopeSetupContext::~ScopeSetupContext() {
+  // ScopeSlot has a trivial destructor; Only the raw memory is released.
+  for (size_t i = 0; i < slot_blocks_.size(); ++i) {
+    delete[] slot_blocks_[i];
+  }
+}
+
 void ScopeSetupContext::AddToInitList(SetupInterface* init) {
-  // It is an error to add same object more than once to the list.
-  GUICPP_DCHECK_(find(init_list_.begin(), init_list_.end(), init)
-                 == init_list_.end());
-  init_list_.push_back(init);
+  {
+    WriterMutexLock mu(&mu_);
+
+    // It is an error to add same object more than once to the list.
+    GUICPP_DCHECK_(find(init_list_.begin(), init_list_.end(), init)
+                   == init_list_.end());
+    init_list_.push_back(init);
+
+    if (injector_ == NULL) {
+      return;
+    }
+
+    // Added after Init(); The cleanup list is grown to stay as big as the
+    // init list.
+    SetupInterface** cleanup_list = new SetupInterface*[init_list_.size()];
+    copy(cleanup_list_.get(), cleanup_list_.get() + cleanup_list_size_,
+         cleanup_list);
+    cleanup_list_.reset(cleanup_list);
+  }
+
+  // Called outside the lock, as Init() may get instances from the injector.
+  init->Init(injector_);
 }
 
 void ScopeSetupContext::AddToCleanupList(SetupInterface* cleanup) {
   // It is a bug to add a provider to the cleanup list unless it's already in
   // the init list. We derive the max size on cleanup list based on size of
   // init list.
+  WriterMutexLock mu(&mu_);
   GUICPP_DCHECK_(find(init_list_.begin(), init_list_.end(), cleanup)
                  != init_list_.end());
 
-  WriterMutexLock mu(&mu_);
   cleanup_list_[cleanup_list_size_++] = cleanup;
 }
 
+int ScopeSetupContext::AllocateSlot() {
+  const int index = num_slots();
+  const int index_in_block = index % kSlotsPerBlock;
+
+  if (index_in_block == 0) {
+    // One extra cache line is allocated to align the first slot.
+    slot_blocks_.push_back(
+        new char[kSlotsPerBlock * sizeof(ScopeSlot) + kCacheLineSize]);
+  }
+
+  char* block = slot_blocks_.back();
+  const size_t misalignment =
+      reinterpret_cast<size_t>(block) % kCacheLineSize;
+  if (misalignment != 0) {
+    block += kCacheLineSize - misalignment;
+  }
+
+  slots_.push_back(
+      new(block + index_in_block * sizeof(ScopeSlot)) ScopeSlot());
+  return index;
+}
+
 void ScopeSetupContext::Init(const Injector* injector) {
   injector_ = injector;
 
@@ -50,6 +99,20 @@ void ScopeSetupContext::Init(const Injector* injector) {
   }
 }
 
+void ScopeSetupContext::GetCreationStats(
+    vector<SingletonCreationStats>* stats) const {
+  ReaderMutexLock mu(&mu_);
+
+  SingletonCreationStats provider_stats;
+  for (vector<SetupInterface*>::const_iterator iter = init_list_.begin();
+       iter != init_list_.end();
+       ++iter) {
+    if ((*iter)->GetCreationStats(&provider_stats)) {
+      stats->push_back(provider_stats);
+    }
+  }
+}
+
 void ScopeSetupContext::Cleanup() {
   ReaderMutexLock mu(&mu_);  // This read lock may be unnecessary.
 
@@ -59,4 +122,20 @@ void ScopeSetupContext::Cleanup() {
 }
 
 }  // namespace internal
+
+SingletonCreationStats::SingletonCreationStats()
+    : bind_id(NULL),
+      is_created(false),
+      creation_nanos(0),
+      num_waiters(0),
+      wait_nanos(0),
+      num_fallbacks(0) {}
+
+std::vector<SingletonCreationStats> GetSingletonCreationStats(
+    const Injector* injector) {
+  std::vector<SingletonCreationStats> stats;
+  injector->Get<internal::ScopeSetupContext*>()->GetCreationStats(&stats);
+  return stats;
+}
+
 }  // namespace guicpp
@@ -17,44 +17,530 @@
 
 #include "guicpp/internal/guicpp_table.h"
 
-#include <map>
+#include <algorithm>
+#include <functional>
 #include <utility>
 
 #include "guicpp/internal/guicpp_inject_util.h"
 
 namespace guicpp {
 namespace internal {
-BindTable::BindTable() {
+#ifdef GUICPP_ENABLE_LOOKUP_CACHE
+namespace {
+// Number of entries in the per-thread lookup cache, must be a power of 2.
+const size_t kLookupCacheSize = 64;
+
+// An entry of the lookup cache. Generation 0 is never assigned to a snapshot
+// and hence marks an unused entry. The cached entry points into the snapshot
+// of the given generation (NULL if bind_id is not bound), which is kept
+// until the table is deleted.
+struct LookupCacheEntry {
+  uint64 generation;
+  TypeId bind_id;
+  const void* entry;
+};
+
+// Direct mapped cache; An entry is simply overwritten on collision.
+GUICPP_THREAD_LOCAL_ LookupCacheEntry lookup_cache[kLookupCacheSize];
+
+// Number of lookups of this thread served by lookup_cache.
+GUICPP_THREAD_LOCAL_ uint64 num_lookup_cache_hits = 0;
+
+// Returns the lookup cache entry for bind_id. TypeIds are addresses of
+// (at least 4 byte aligned) static variables.
+LookupCacheEntry* GetLookupCacheEntry(TypeId bind_id) {
+  size_t address = reinterpret_cast<size_t>(bind_id);
+  return &lookup_cache[((address >> 3) ^ (address >> 9)) &
+                       (kLookupCacheSize - 1)];
+}
+
+}  // namespace
+#endif  // GUICPP_ENABLE_LOOKUP_CACHE
+
+namespace {
+// Initial number of slots of the index of pending entries, as a power of 2.
+const int kMinPendingIndexBits = 6;
+
+// Returns the slot of bind_id in an index of 2^index_bits slots. The high
+// bits of the product depend on all the bits of bind_id (Fibonacci hashing).
+size_t GetPendingIndexSlot(TypeId bind_id, int index_bits) {
+  uint64 hash = static_cast<uint64>(reinterpret_cast<size_t>(bind_id)) *
+                0x9E3779B97F4A7C15ULL;
+  return static_cast<size_t>(hash >> (64 - index_bits));
+}
+
+Mutex generation_mutex;
+uint64 last_generation = 0;
+
+// Returns a generation that is not used by any other table (or snapshot);
+// Also used for the table ids.
+uint64 NewGeneration() {
+  MutexLock lock(&generation_mutex);
+  return ++last_generation;
+}
+
+// The table whose deferred installer is being called by this thread, if any.
+// Lookups made by the installer must not take update_mu_ again.
+GUICPP_THREAD_LOCAL_ const BindTable* installing_table = NULL;
+
+// Orders BindingUsage by decreasing number of lookups.
+struct MoreLookups {
+  bool operator()(const BindingUsage& lhs, const BindingUsage& rhs) const {
+    return lhs.num_lookups > rhs.num_lookups;
+  }
+};
+
+}  // namespace
+
+// Orders BindEntry by bindId. Also compares BindEntry with a bindId, used
+// for binary search.
+struct BindTable::CompareBindId {
+  bool operator()(const BindEntry& lhs, const BindEntry& rhs) const {
+    return std::less<TypeId>()(lhs.bind_id, rhs.bind_id);
+  }
+
+  bool operator()(const BindEntry& lhs, TypeId rhs) const {
+    return std::less<TypeId>()(lhs.bind_id, rhs);
+  }
+};
+
+BindTable::BindTable()
+    : is_shared_(false), is_modified_(false), pending_index_bits_(0),
+      num_duplicates_(0), count_lookups_(false), id_(NewGeneration()),
+      shared_entries_(new vector<BindEntry>()) {
+  Snapshot* snapshot = new Snapshot();
+#ifdef GUICPP_ENABLE_LOOKUP_CACHE
+  snapshot->generation = NewGeneration();
+#endif
+  snapshot_ = snapshot;
 }
 
 BindTable::~BindTable() {
-  for (vector<const TableEntryBase*>::reverse_iterator riter =
-       cleanup_list_.rbegin(); riter != cleanup_list_.rend(); ++riter) {
-    delete *riter;
+  for (size_t i = 0; i < shared_entries_->size(); ++i) {
+    delete (*shared_entries_)[i].entry;
+  }
+
+  delete shared_entries_;
+  for (size_t i = 0; i < retired_shared_entries_.size(); ++i) {
+    delete retired_shared_entries_[i];
+  }
+
+  DeleteEntries(cleanup_list_);
+
+  delete snapshot_;
+  for (size_t i = 0; i < retired_snapshots_.size(); ++i) {
+    delete retired_snapshots_[i];
+  }
+}
+
+// Deletes the entries in reverse order.
+void BindTable::DeleteEntries(const vector<const TableEntryBase*>& entries) {
+  for (vector<const TableEntryBase*>::const_reverse_iterator riter =
+       entries.rbegin(); riter != entries.rend(); ++riter) {
+    map<const TableEntryBase*, vector<const TableEntryBase*> >::iterator
+        installed = deferred_cleanup_lists_.find(*riter);
+    if (installed != deferred_cleanup_lists_.end()) {
+      DeleteEntries(installed->second);
+    }
+
+    if (arena_.Contains(*riter)) {
+      // Memory is freed along with arena_.
+      (*riter)->~TableEntryBase();
+    } else {
+      delete *riter;
+    }
   }
 }
 
 // Finds and returns entry associated with bindId.
 const TableEntryBase* BindTable::FindEntry(TypeId bindId) const {
-  map<TypeId, const TableEntryBase*>::const_iterator iter =
-      bind_map_.find(bindId);
+#ifdef GUICPP_ENABLE_LOOKUP_CACHE
+  const BindEntry* bind_entry;
+  if (!is_shared_ || installing_table == this) {
+    // Changes made while binding are not in the snapshot until merged.
+    bind_entry = FindEntryUncached(bindId);
+  } else {
+    // If the lookup installs a deferred module, the result is cached for the
+    // replaced snapshot and is not used again.
+    uint64 generation = AcquireLoad(&snapshot_)->generation;
+    LookupCacheEntry* cache_entry = GetLookupCacheEntry(bindId);
+    if (cache_entry->generation == generation &&
+        cache_entry->bind_id == bindId) {
+      bind_entry = static_cast<const BindEntry*>(cache_entry->entry);
+      ++num_lookup_cache_hits;
+    } else {
+      bind_entry = FindEntryUncached(bindId);
+      cache_entry->generation = generation;
+      cache_entry->bind_id = bindId;
+      cache_entry->entry = bind_entry;
+    }
+  }
+#else
+  const BindEntry* bind_entry = FindEntryUncached(bindId);
+#endif  // GUICPP_ENABLE_LOOKUP_CACHE
 
-  if (iter == bind_map_.end()) {
+  if (bind_entry == NULL) {
     return NULL;
   }
 
-  return iter->second;
+  if (count_lookups_) {
+    IncrementCounter(&bind_entry->num_lookups);
+  }
+
+  return bind_entry->entry;
+}
+
+#ifdef GUICPP_ENABLE_LOOKUP_CACHE
+// Returns the number of lookups served by the lookup cache of this thread.
+// static
+uint64 BindTable::GetNumLookupCacheHits() {
+  return num_lookup_cache_hits;
+}
+#endif  // GUICPP_ENABLE_LOOKUP_CACHE
+
+// Looks up the sorted entries without using the lookup cache.
+const BindTable::BindEntry* BindTable::FindEntryUncached(TypeId bindId) const {
+  if (!is_shared_ || installing_table == this) {
+    return FindOrInstall(bindId);
+  }
+
+  const Snapshot* snapshot = AcquireLoad(&snapshot_);
+  const BindEntry* bind_entry = FindSortedEntry(bindId, snapshot->entries);
+  if (bind_entry != NULL) {
+    return bind_entry;
+  }
+
+  // Installers are registered only while binding, and every change is
+  // published before update_mu_ is released; Hence no other bindId can be
+  // installed for this lookup.
+  if (!std::binary_search(snapshot->deferred_bind_ids.begin(),
+                          snapshot->deferred_bind_ids.end(), bindId,
+                          std::less<TypeId>())) {
+    return NULL;
+  }
+
+  // Another thread may have installed the module since snapshot was loaded;
+  // FindOrInstall() looks up the current snapshot again.
+  MutexLock lock(&update_mu_);
+  const BindTable* outer_installing_table = installing_table;
+  installing_table = this;
+  bind_entry = FindOrInstall(bindId);
+  installing_table = outer_installing_table;
+  return bind_entry;
+}
+
+// Looks up the sorted and the pending entries, installing on a miss.
+const BindTable::BindEntry* BindTable::FindOrInstall(TypeId bindId) const {
+  // The entry must be returned decorated; This merges only if a decorator
+  // is added for bindId since the last merge.
+  if (pending_decorators_.find(bindId) != pending_decorators_.end()) {
+    MergePendingEntries();
+  }
+
+  const BindEntry* bind_entry = FindSortedEntry(bindId, snapshot_->entries);
+  if (bind_entry == NULL) {
+    bind_entry = FindPendingEntry(bindId);
+  }
+
+  if (bind_entry == NULL && !deferred_installers_.empty()) {
+    bind_entry = InstallDeferred(bindId);
+  }
+
+  return bind_entry;
+}
+
+// Looks up bindId in pending_entries_ using pending_index_.
+const BindTable::BindEntry* BindTable::FindPendingEntry(TypeId bindId) const {
+  if (pending_index_.empty()) {
+    return NULL;
+  }
+
+  const size_t mask = pending_index_.size() - 1;
+  for (size_t slot = GetPendingIndexSlot(bindId, pending_index_bits_);
+       pending_index_[slot] != 0; slot = (slot + 1) & mask) {
+    const BindEntry& bind_entry = pending_entries_[pending_index_[slot] - 1];
+    if (bind_entry.bind_id == bindId) {
+      return &bind_entry;
+    }
+  }
+
+  return NULL;
+}
+
+// Adds the last pending entry to pending_index_, growing the index if it
+// would be more than half full.
+void BindTable::IndexLastPendingEntry() {
+  if (2 * pending_entries_.size() > pending_index_.size()) {
+    // Duplicates are indexed again in order, hence the first one still wins.
+    pending_index_bits_ = pending_index_.empty() ? kMinPendingIndexBits
+                                                 : pending_index_bits_ + 1;
+    pending_index_.assign(static_cast<size_t>(1) << pending_index_bits_, 0);
+    for (size_t i = 0; i + 1 < pending_entries_.size(); ++i) {
+      IndexPendingEntry(i);
+    }
+  }
+
+  IndexPendingEntry(pending_entries_.size() - 1);
+}
+
+// Adds pending_entries_[i] to pending_index_ unless an earlier entry has the
+// same bindId. The index must have a free slot.
+void BindTable::IndexPendingEntry(size_t i) {
+  const TypeId bindId = pending_entries_[i].bind_id;
+  const size_t mask = pending_index_.size() - 1;
+
+  size_t slot = GetPendingIndexSlot(bindId, pending_index_bits_);
+  for (; pending_index_[slot] != 0; slot = (slot + 1) & mask) {
+    if (pending_entries_[pending_index_[slot] - 1].bind_id == bindId) {
+      return;
+    }
+  }
+
+  pending_index_[slot] = i + 1;
+}
+
+// Looks up bindId in entries.
+// static
+const BindTable::BindEntry* BindTable::FindSortedEntry(
+    TypeId bindId, const vector<BindEntry>& entries) {
+  vector<BindEntry>::const_iterator iter =
+      std::lower_bound(entries.begin(), entries.end(), bindId, CompareBindId());
+
+  if (iter == entries.end() || iter->bind_id != bindId) {
+    return NULL;
+  }
+
+  return &*iter;
+}
+
+// Returns the entry added for bindId so far.
+const TableEntryBase* BindTable::FindAddedEntry(TypeId bindId) const {
+  const BindEntry* bind_entry = FindSortedEntry(bindId, snapshot_->entries);
+  if (bind_entry != NULL) {
+    return bind_entry->entry;
+  }
+
+  // First added entry wins, as in MergePendingEntries().
+  bind_entry = FindPendingEntry(bindId);
+  return bind_entry == NULL ? NULL : bind_entry->entry;
 }
 
 // Adds entry for bindId.
 bool BindTable::AddEntry(TypeId bindId, const TableEntryBase* entry) {
   AddToCleanupList(entry);
 
-  if (bind_map_.insert(make_pair(bindId, entry)).second) {
-    return true;
+  if (FindSortedEntry(bindId, snapshot_->entries) != NULL) {
+    return false;
+  }
+
+  pending_entries_.push_back(BindEntry(bindId, entry));
+  IndexLastPendingEntry();
+  is_modified_ = true;
+  return true;
+}
+
+// Merges pending entries and returns number of errors found so far.
+int BindTable::MergeEntries() {
+  MergePendingEntries();
+
+  // A decorator is applied when its bindId is merged; The remaining ones
+  // decorate types that are bound only by a deferred module, or not at all.
+  int num_unbound = 0;
+  for (map<TypeId, vector<const DecoratorLink*> >::const_iterator iter =
+       pending_decorators_.begin(); iter != pending_decorators_.end();
+       ++iter) {
+    if (deferred_installers_.find(iter->first) == deferred_installers_.end()) {
+      GUICPP_LOG_(ERROR) << "Decorated type is not bound.";
+      ++num_unbound;
+    }
+  }
+
+  return num_duplicates_ + num_unbound;
+}
+
+// Adds decorator for bindId.
+void BindTable::AddDecorator(TypeId bindId, const TableEntryBase* entry,
+                             const DecoratorLink* decorator) {
+  AddToCleanupList(entry);
+  pending_decorators_[bindId].push_back(decorator);
+  is_modified_ = true;
+}
+
+// Publishes a new snapshot holding the sorted and the pending entries.
+void BindTable::MergePendingEntries() const {
+  if (!is_modified_) {
+    return;
+  }
+
+  // Stable sort keeps the first added entry before its duplicates; Hence,
+  // as with the entries that are already sorted, first binding wins.
+  std::stable_sort(pending_entries_.begin(), pending_entries_.end(),
+                   CompareBindId());
+
+  const vector<BindEntry>& sorted_entries = snapshot_->entries;
+  Snapshot* snapshot = new Snapshot();
+  vector<BindEntry>& entries = snapshot->entries;
+  entries.reserve(sorted_entries.size() + pending_entries_.size());
+  entries.insert(entries.end(), sorted_entries.begin(), sorted_entries.end());
+
+  for (size_t i = 0; i < pending_entries_.size(); ++i) {
+    TypeId bindId = pending_entries_[i].bind_id;
+
+    if ((i > 0 && pending_entries_[i - 1].bind_id == bindId) ||
+        FindSortedEntry(bindId, sorted_entries) != NULL) {
+      // TODO(bnmouli): ADDNAME Print name of the type once TableEntryBase
+      // has GetName() method.
+      GUICPP_LOG_(ERROR) << "Duplicate Binding: Type is already bound.";
+      ++num_duplicates_;
+      continue;
+    }
+
+    entries.push_back(pending_entries_[i]);
+  }
+
+  pending_entries_.clear();
+  pending_index_.clear();
+  std::inplace_merge(entries.begin(), entries.begin() + sorted_entries.size(),
+                     entries.end(), CompareBindId());
+
+  // Decorators of the bound bindIds are applied in order of addition; The
+  // remaining ones wait for their bindId to be bound.
+  for (map<TypeId, vector<const DecoratorLink*> >::iterator iter =
+       pending_decorators_.begin(); iter != pending_decorators_.end();) {
+    vector<BindEntry>::iterator bind_entry = std::lower_bound(
+        entries.begin(), entries.end(), iter->first, CompareBindId());
+    if (bind_entry == entries.end() || bind_entry->bind_id != iter->first) {
+      ++iter;
+      continue;
+    }
+
+    const vector<const DecoratorLink*>& decorators = iter->second;
+    for (size_t i = 0; i < decorators.size(); ++i) {
+      bind_entry->entry = decorators[i]->Decorate(bind_entry->entry);
+    }
+
+    pending_decorators_.erase(iter++);
+  }
+
+  // deferred_installers_ is ordered by bindId.
+  for (map<TypeId, const DeferredInstaller*>::const_iterator iter =
+       deferred_installers_.begin(); iter != deferred_installers_.end();
+       ++iter) {
+    snapshot->deferred_bind_ids.push_back(iter->first);
+  }
+
+#ifdef GUICPP_ENABLE_LOOKUP_CACHE
+  snapshot->generation = NewGeneration();
+#endif
+
+  // Once the table is shared, other threads may still be looking up the
+  // replaced snapshot.
+  const Snapshot* replaced = snapshot_;
+  const Snapshot* published = snapshot;
+  ReleaseStore(&snapshot_, published);
+  if (is_shared_) {
+    retired_snapshots_.push_back(replaced);
+  } else {
+    delete replaced;
+  }
+
+  is_modified_ = false;
+}
+
+// Calls the installer registered for bindId, if any.
+const BindTable::BindEntry* BindTable::InstallDeferred(TypeId bindId) const {
+  map<TypeId, const DeferredInstaller*>::iterator iter =
+      deferred_installers_.find(bindId);
+  if (iter == deferred_installers_.end()) {
+    return NULL;
+  }
+
+  // The installer is removed for all its bindIds first, so that it is called
+  // only once even if the module looks up its own types while installing.
+  const DeferredInstaller* installer = iter->second;
+  for (iter = deferred_installers_.begin();
+       iter != deferred_installers_.end();) {
+    if (iter->second == installer) {
+      deferred_installers_.erase(iter++);
+    } else {
+      ++iter;
+    }
   }
+  is_modified_ = true;
+
+  // Installation adds entries to this table; Like the merge of pending
+  // entries, it is a one time change made on lookup.
+  BindTable* self = const_cast<BindTable*>(this);
 
-  return false;
+  // Entries added by the installer are kept aside and deleted just before
+  // the installer. Hence they are deleted in the same order as if the
+  // module was installed without deferring, in particular before cleanup
+  // actions added after Binder::InstallDeferred().
+  vector<const TableEntryBase*> cleanup_list;
+  self->cleanup_list_.swap(cleanup_list);
+  installer->Install(self);
+  self->cleanup_list_.swap(cleanup_list);
+  self->deferred_cleanup_lists_[installer].swap(cleanup_list);
+
+  // Lookups made by the installer find its entries without merging; They are
+  // published here, once.
+  MergePendingEntries();
+  return FindSortedEntry(bindId, snapshot_->entries);
+}
+
+// Registers "installer" for each of the bind_ids.
+bool BindTable::AddDeferredInstaller(const vector<TypeId>& bind_ids,
+                                     const DeferredInstaller* installer) {
+  AddToCleanupList(installer);
+
+  bool is_added = true;
+  for (size_t i = 0; i < bind_ids.size(); ++i) {
+    if (!deferred_installers_.insert(
+            make_pair(bind_ids[i], installer)).second) {
+      is_added = false;
+    }
+  }
+  is_modified_ = true;
+
+  return is_added;
+}
+
+const TableEntryBase* BindTable::FindSharedEntry(TypeId tid) const {
+  const BindEntry* shared_entry =
+      FindSortedEntry(tid, *AcquireLoad(&shared_entries_));
+  return shared_entry == NULL ? NULL : shared_entry->entry;
+}
+
+const TableEntryBase* BindTable::AddSharedEntry(
+    TypeId tid, const TableEntryBase* entry) const {
+  const TableEntryBase* shared_entry;
+  {
+    MutexLock lock(&shared_entries_mu_);
+
+    // Another thread may have added an entry for tid since the caller
+    // looked up.
+    const BindEntry* added = FindSortedEntry(tid, *shared_entries_);
+    if (added != NULL) {
+      shared_entry = added->entry;
+    } else {
+      vector<BindEntry>* entries = new vector<BindEntry>(*shared_entries_);
+      entries->insert(
+          std::lower_bound(entries->begin(), entries->end(), tid,
+                           CompareBindId()),
+          BindEntry(tid, entry));
+
+      retired_shared_entries_.push_back(shared_entries_);
+      const vector<BindEntry>* published = entries;
+      ReleaseStore(&shared_entries_, published);
+      shared_entry = entry;
+    }
+  }
+
+  if (shared_entry != entry) {
+    delete entry;
+  }
+
+  return shared_entry;
 }
 
 // Adds an entry cleanup list.
@@ -62,6 +548,117 @@ void BindTable::AddToCleanupList(const TableEntryBase* entry) {
   cleanup_list_.push_back(entry);
 }
 
+// Returns memory used by the entries created using NewEntry().
+BindTableMemoryStats BindTable::MemoryStats() const {
+  BindTableMemoryStats memory_stats = memory_stats_;
+  memory_stats.arena_bytes = arena_.bytes_reserved();
+  return memory_stats;
+}
+
+// Returns the usage of the bindings.
+BindTableUsageReport BindTable::UsageReport(size_t max_hot_bindings) const {
+  BindTableUsageReport report;
+  if (!count_lookups_) {
+    return report;
+  }
+
+  report.is_enabled = true;
+
+  // Deferred installers add to entry_bytes_ while holding update_mu_.
+  MutexLock lock(&update_mu_);
+  const vector<BindEntry>& entries = AcquireLoad(&snapshot_)->entries;
+
+  vector<BindingUsage> used_bindings;
+  for (size_t i = 0; i < entries.size(); ++i) {
+    const BindEntry& bind_entry = entries[i];
+    map<const TableEntryBase*, size_t>::const_iterator bytes =
+        entry_bytes_.find(bind_entry.entry);
+    BindingUsage usage(bind_entry.bind_id, bind_entry.entry->GetBindType(),
+                       LoadCounter(&bind_entry.num_lookups),
+                       bytes == entry_bytes_.end() ? 0 : bytes->second);
+
+    if (usage.num_lookups == 0) {
+      report.unused_bindings.push_back(usage);
+      report.unused_entry_bytes += usage.entry_bytes;
+    } else {
+      used_bindings.push_back(usage);
+    }
+  }
+
+  // Bindings having the same number of lookups stay in order of bindId.
+  std::stable_sort(used_bindings.begin(), used_bindings.end(), MoreLookups());
+  if (used_bindings.size() > max_hot_bindings) {
+    used_bindings.erase(used_bindings.begin() + max_hot_bindings,
+                        used_bindings.end());
+  }
+
+  report.hot_bindings.swap(used_bindings);
+  return report;
+}
+
+// Returns memory for an entry of "size" bytes from arena_.
+void* BindTable::AllocateEntry(size_t size) {
+  return arena_.Allocate(size);
+}
+
+// Updates memory_stats_ for entry created using NewEntry().
+void BindTable::RecordNewEntry(const TableEntryBase* entry, size_t size) {
+  TableEntryBase::BindType bind_type = entry->GetBindType();
+  ++memory_stats_.num_entries[bind_type];
+  memory_stats_.entry_bytes[bind_type] += size;
+
+  if (count_lookups_) {
+    entry_bytes_[entry] = size;
+  }
+}
+
+BindTableMemoryStats::BindTableMemoryStats(): arena_bytes(0) {
+  for (size_t i = 0; i < arraysize(num_entries); ++i) {
+    num_entries[i] = 0;
+    entry_bytes[i] = 0;
+  }
+}
+
+BindingUsage::BindingUsage(TypeId bind_id, TableEntryBase::BindType bind_type,
+                           uint64 num_lookups, size_t entry_bytes)
+    : bind_id(bind_id), bind_type(bind_type), num_lookups(num_lookups),
+      entry_bytes(entry_bytes) {}
+
+BindTableUsageReport::BindTableUsageReport()
+    : is_enabled(false), unused_entry_bytes(0) {}
+
+// Returns name of the bind type.
+const char* GetBindTypeString(TableEntryBase::BindType bind_type) {
+  switch (bind_type) {
+    case TableEntryBase::BIND_TO_CTOR:
+      return "BIND_TO_CTOR";
+    case TableEntryBase::BIND_TO_TYPE:
+      return "BIND_TO_TYPE";
+    case TableEntryBase::BIND_TO_INSTANCE:
+      return "BIND_TO_INSTANCE";
+    case TableEntryBase::BIND_TO_VALUE:
+      return "BIND_TO_VALUE";
+    case TableEntryBase::BIND_TO_POINTED:
+      return "BIND_TO_POINTED";
+    case TableEntryBase::BIND_TO_PROVIDER:
+      return "BIND_TO_PROVIDER";
+    case TableEntryBase::BIND_TO_SET:
+      return "BIND_TO_SET";
+    case TableEntryBase::BIND_TO_MAP:
+      return "BIND_TO_MAP";
+    case TableEntryBase::BIND_TO_SWAPPABLE_INSTANCE:
+      return "BIND_TO_SWAPPABLE_INSTANCE";
+    case TableEntryBase::BIND_TO_DECORATOR:
+      return "BIND_TO_DECORATOR";
+    case TableEntryBase::BIND_FACTORY_ARGUMENT:
+      return "BIND_FACTORY_ARGUMENT";
+    case TableEntryBase::INVALID_BIND:
+      return "INVALID_BIND";
+  }
+
+  return NULL;
+}
+
 // Returns a string that describes category of the type.
 const char* GetCategoryString(TypesCategory::Enum category, bool is_const) {
   switch (category) {
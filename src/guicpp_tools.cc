@@ -70,7 +70,12 @@ class WrapperModule: public Module {
 // but adds some additional bindings necessary for some Guic++ features such as
 // LazySingleton scopes to work.
 Injector* CreateInjector(const Module* module) {
-  internal::ScopeSetupContext* context = new internal::ScopeSetupContext();
+  return CreateInjector(module, FULL_TEARDOWN);
+}
+
+Injector* CreateInjector(const Module* module, TeardownPolicy policy) {
+  internal::ScopeSetupContext* context =
+      new internal::ScopeSetupContext(policy);
 
   internal::WrapperModule wrapper(module, context);
 
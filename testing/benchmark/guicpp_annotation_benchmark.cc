@@ -0,0 +1,130 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Synthetic module with 500 labelled bindings, used to measure the compile
+// time and the object size of the annotation machinery (At<>, AtUtil::GetAt
+// and AtUtil::GetTypes). Each binding has its own label, a value bound to
+// At<Label, int> and a class whose constructor takes that annotated value.
+//
+// The compile time is what matters here; Measure it along with the size of
+// the object file, for example:
+//   time g++ -g -c guicpp_annotation_benchmark.cc ...
+//   size guicpp_annotation_benchmark.o
+//
+// When run, it measures Injector::Create() of the module and Get() of all
+// the 500 classes.
+
+#include "guicpp/guicpp.h"
+#include "guicpp/guicpp_binder.h"
+#include "guicpp/guicpp_injector.h"
+#include "guicpp/guicpp_module.h"
+#include "benchmark/guicpp_benchmark.h"
+
+// Expands M(n) for the 500 three digit numbers n from 000 to 499. The digits
+// are pasted, hence n is used only in identifiers.
+#define GUICPP_BENCHMARK_DIGITS_1(M, p) \
+    M(p##0) M(p##1) M(p##2) M(p##3) M(p##4) \
+    M(p##5) M(p##6) M(p##7) M(p##8) M(p##9)
+#define GUICPP_BENCHMARK_DIGITS_2(M, p) \
+    GUICPP_BENCHMARK_DIGITS_1(M, p##0) GUICPP_BENCHMARK_DIGITS_1(M, p##1) \
+    GUICPP_BENCHMARK_DIGITS_1(M, p##2) GUICPP_BENCHMARK_DIGITS_1(M, p##3) \
+    GUICPP_BENCHMARK_DIGITS_1(M, p##4) GUICPP_BENCHMARK_DIGITS_1(M, p##5) \
+    GUICPP_BENCHMARK_DIGITS_1(M, p##6) GUICPP_BENCHMARK_DIGITS_1(M, p##7) \
+    GUICPP_BENCHMARK_DIGITS_1(M, p##8) GUICPP_BENCHMARK_DIGITS_1(M, p##9)
+#define GUICPP_BENCHMARK_REPEAT_500(M) \
+    GUICPP_BENCHMARK_DIGITS_2(M, 0) GUICPP_BENCHMARK_DIGITS_2(M, 1) \
+    GUICPP_BENCHMARK_DIGITS_2(M, 2) GUICPP_BENCHMARK_DIGITS_2(M, 3) \
+    GUICPP_BENCHMARK_DIGITS_2(M, 4)
+
+namespace guicpp_benchmark {
+using guicpp::At;
+using guicpp::Binder;
+using guicpp::Injector;
+
+volatile size_t sink = 0;
+
+#define GUICPP_BENCHMARK_DECLARE(n) \
+  class Label##n: public guicpp::Label {}; \
+  \
+  class User##n { \
+   public: \
+    explicit User##n(int value): value_(value) {} \
+    int value() const { return value_; } \
+   private: \
+    int value_; \
+  }; \
+  \
+  GUICPP_INJECT_CTOR(User##n, (At<Label##n, int> value)); \
+  GUICPP_DEFINE(User##n);
+
+GUICPP_BENCHMARK_REPEAT_500(GUICPP_BENCHMARK_DECLARE)
+
+#define GUICPP_BENCHMARK_BIND(n) \
+    binder->BindToValue<At<Label##n, int> >(1);
+
+class LabelledModule: public guicpp::Module {
+ public:
+  void Configure(Binder* binder) const {
+    GUICPP_BENCHMARK_REPEAT_500(GUICPP_BENCHMARK_BIND)
+  }
+};
+
+// Creates the injector of LabelledModule.
+class CreateInjector {
+ public:
+  void operator()() const {
+    LabelledModule module;
+    delete Injector::Create(&module);
+  }
+};
+
+#define GUICPP_BENCHMARK_GET(n) \
+    { \
+      User##n* user = injector_->Get<User##n*>(); \
+      sink += user->value(); \
+      delete user; \
+    }
+
+// Gets an instance of each of the 500 classes.
+class GetAll {
+ public:
+  explicit GetAll(const Injector* injector): injector_(injector) {}
+
+  void operator()() const {
+    GUICPP_BENCHMARK_REPEAT_500(GUICPP_BENCHMARK_GET)
+  }
+
+ private:
+  const Injector* injector_;
+};
+
+}  // namespace guicpp_benchmark
+
+int main(int argc, char** argv) {
+  using guicpp_benchmark::GetAll;
+  using guicpp_benchmark::LabelledModule;
+  using guicpp_benchmark::RunBenchmark;
+
+  RunBenchmark("Injector::Create() with 500 labelled bindings", 1000,
+               guicpp_benchmark::CreateInjector());
+
+  LabelledModule module;
+  guicpp::scoped_ptr<guicpp::Injector> injector(
+      guicpp::Injector::Create(&module));
+  RunBenchmark("Get() of 500 classes with labelled arguments", 1000,
+               GetAll(injector.get()));
+
+  return 0;
+}
@@ -0,0 +1,54 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// This file declares a minimal timing helper used by the Guic++ benchmarks.
+// The benchmarks are plain executables; They are not run as part of tests.
+
+#ifndef GUICPP_BENCHMARK_H_
+#define GUICPP_BENCHMARK_H_
+
+#include <iostream>
+#include <string>
+
+#include "guicpp/internal/guicpp_port.h"
+
+namespace guicpp_benchmark {
+// Used to keep the compiler from optimizing away the benchmarked code.
+extern volatile size_t sink;
+
+// Calls "function" "iterations" times and prints the (wall clock) time per
+// call in nanoseconds. Function must be callable as function().
+template <typename Function>
+void RunBenchmark(const std::string& name, int iterations, Function function) {
+  // Warms up caches (and lazy initializations) before timing.
+  for (int i = 0; i < iterations / 10; ++i) {
+    function();
+  }
+
+  guicpp::uint64 start = guicpp::GetMonotonicNanos();
+  for (int i = 0; i < iterations; ++i) {
+    function();
+  }
+  guicpp::uint64 end = guicpp::GetMonotonicNanos();
+
+  double nanoseconds = static_cast<double>(end - start) / iterations;
+  std::cout << name << ": " << nanoseconds << " ns/iteration ("
+            << iterations << " iterations)\n";
+}
+
+}  // namespace guicpp_benchmark
+
+#endif  // GUICPP_BENCHMARK_H_
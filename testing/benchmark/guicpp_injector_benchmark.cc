@@ -0,0 +1,348 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// Compares the cost of creating an object graph using Injector::Get() with
+// creating the same graph directly, the way a lookup-free generated
+// injector would do.
+//
+// Graph:
+//   NotificationService
+//     +-- EmailSender* (bound to SmtpEmailSender)
+//     |     +-- Transport*
+//     |     +-- At<ServerPort, int> (bound to value)
+//     +-- Logger* (lazy singleton)
+//
+// Also measures Injector::Get() of a value, which is mostly the bind table
+// lookup and TableEntryReader. Comparing release builds with and without
+// GUICPP_HARDENED shows the per-Get cost of debug checks.
+//
+// Also compares injecting a factory by pointer (a new factory owned by the
+// caller) with injecting it by const reference (shared by the injector).
+//
+// StaticInjector (see static_injector.h) injects only pointers, hence it is
+// compared using a variant of the graph whose EmailSender is bound to
+// PushEmailSender, which takes no value. The same graph is also created
+// using Injector::Get() and directly.
+//
+// Finally, compares the two ways of creating synthetic graphs of 10 and 100
+// nodes (see synthetic_graph.h), which shows how the cost of Get() grows
+// with the size of the graph and of the bind table.
+
+#include <sstream>
+
+#include "guicpp/guicpp.h"
+#include "guicpp/guicpp_binder.h"
+#include "guicpp/guicpp_factory.h"
+#include "guicpp/guicpp_injector.h"
+#include "guicpp/guicpp_module.h"
+#include "guicpp/guicpp_singleton.h"
+#include "guicpp/guicpp_static_injector.h"
+#include "guicpp/guicpp_tools.h"
+#include "benchmark/guicpp_benchmark.h"
+#include "benchmark/guicpp_synthetic_graph.h"
+
+namespace guicpp_benchmark {
+using guicpp::At;
+using guicpp::Binder;
+using guicpp::Injector;
+using guicpp::LazySingleton;
+using guicpp::StaticBind;
+using guicpp::StaticInjector;
+using guicpp::StaticModule;
+using guicpp::StaticScope;
+using guicpp::scoped_ptr;
+
+volatile size_t sink = 0;
+
+class ServerPort: public guicpp::Label {};
+
+class Transport {
+ public:
+  Transport() {}
+};
+
+GUICPP_INJECT_CTOR(Transport, ());
+
+class EmailSender {
+ public:
+  virtual ~EmailSender() {}
+};
+
+GUICPP_INJECTABLE(EmailSender);
+
+class SmtpEmailSender: public EmailSender {
+ public:
+  SmtpEmailSender(Transport* transport, int port)
+      : transport_(transport), port_(port) {}
+
+ private:
+  scoped_ptr<Transport> transport_;
+  int port_;
+};
+
+GUICPP_INJECT_CTOR(SmtpEmailSender, (
+    Transport* transport, At<ServerPort, int> port));
+
+// Same as SmtpEmailSender, but takes only pointers.
+class PushEmailSender: public EmailSender {
+ public:
+  explicit PushEmailSender(Transport* transport): transport_(transport) {}
+
+ private:
+  scoped_ptr<Transport> transport_;
+};
+
+GUICPP_INJECT_CTOR(PushEmailSender, (Transport* transport));
+
+class Logger {
+ public:
+  Logger() {}
+};
+
+GUICPP_INJECT_CTOR(Logger, ());
+
+class NotificationService {
+ public:
+  NotificationService(EmailSender* email_sender, Logger* logger)
+      : email_sender_(email_sender), logger_(logger) {}
+
+ private:
+  scoped_ptr<EmailSender> email_sender_;
+  Logger* logger_;  // Not owned.
+};
+
+GUICPP_INJECT_CTOR(NotificationService, (
+    EmailSender* email_sender, Logger* logger));
+
+GUICPP_DEFINE(Transport);
+GUICPP_DEFINE(SmtpEmailSender);
+GUICPP_DEFINE(PushEmailSender);
+GUICPP_DEFINE(Logger);
+GUICPP_DEFINE(NotificationService);
+
+class NotificationServiceFactory:
+    public guicpp::Factory<NotificationService* ()> {};
+
+class NotificationModule: public guicpp::Module {
+ public:
+  void Configure(Binder* binder) const {
+    binder->Bind<EmailSender, SmtpEmailSender>();
+    binder->BindToValue<At<ServerPort, int> >(25);
+    binder->BindToScope<Logger, LazySingleton>();
+  }
+};
+
+// Same as NotificationModule, with EmailSender bound to PushEmailSender.
+class PushNotificationModule: public guicpp::Module {
+ public:
+  void Configure(Binder* binder) const {
+    binder->Bind<EmailSender, PushEmailSender>();
+    binder->BindToScope<Logger, LazySingleton>();
+  }
+};
+
+// The bindings of PushNotificationModule, for StaticInjector.
+typedef StaticModule<
+    StaticBind<EmailSender, PushEmailSender>,
+    StaticScope<Logger, LazySingleton>
+> StaticPushNotificationModule;
+
+// Creates NotificationService using the runtime injector.
+class InjectorGet {
+ public:
+  explicit InjectorGet(const Injector* injector): injector_(injector) {}
+
+  void operator()() const {
+    NotificationService* service = injector_->Get<NotificationService*>();
+    sink += reinterpret_cast<size_t>(service);
+    delete service;
+  }
+
+ private:
+  const Injector* injector_;
+};
+
+// Gets the port bound to value.
+class InjectorGetValue {
+ public:
+  explicit InjectorGetValue(const Injector* injector): injector_(injector) {}
+
+  void operator()() const {
+    sink += injector_->Get<At<ServerPort, int> >();
+  }
+
+ private:
+  const Injector* injector_;
+};
+
+// Gets a new factory and deletes it.
+class InjectorGetFactory {
+ public:
+  explicit InjectorGetFactory(const Injector* injector)
+      : injector_(injector) {}
+
+  void operator()() const {
+    NotificationServiceFactory* factory =
+        injector_->Get<NotificationServiceFactory*>();
+    sink += reinterpret_cast<size_t>(factory);
+    delete factory;
+  }
+
+ private:
+  const Injector* injector_;
+};
+
+// Gets the factory shared by the injector.
+class InjectorGetSharedFactory {
+ public:
+  explicit InjectorGetSharedFactory(const Injector* injector)
+      : injector_(injector) {}
+
+  void operator()() const {
+    const NotificationServiceFactory& factory =
+        injector_->Get<const NotificationServiceFactory&>();
+    sink += reinterpret_cast<size_t>(&factory);
+  }
+
+ private:
+  const Injector* injector_;
+};
+
+// Creates NotificationService the way generated code would: constructors
+// calling constructors with the singleton in a static slot.
+class DirectCreate {
+ public:
+  void operator()() const {
+    static Logger* logger = new Logger();
+    NotificationService* service = new NotificationService(
+        new SmtpEmailSender(new Transport(), 25), logger);
+    sink += reinterpret_cast<size_t>(service);
+    delete service;
+  }
+};
+
+// Creates NotificationService using StaticInjector.
+class StaticInjectorGet {
+ public:
+  void operator()() const {
+    NotificationService* service = StaticInjector<
+        StaticPushNotificationModule>::Get<NotificationService*>();
+    sink += reinterpret_cast<size_t>(service);
+    delete service;
+  }
+};
+
+// Same as DirectCreate, with PushEmailSender.
+class DirectCreatePush {
+ public:
+  void operator()() const {
+    static Logger* logger = new Logger();
+    NotificationService* service = new NotificationService(
+        new PushEmailSender(new Transport()), logger);
+    sink += reinterpret_cast<size_t>(service);
+    delete service;
+  }
+};
+
+// Creates the root of SyntheticGraph<N> using the runtime injector.
+template <int N>
+class InjectorGetSyntheticGraph {
+ public:
+  explicit InjectorGetSyntheticGraph(const Injector* injector)
+      : injector_(injector) {}
+
+  void operator()() const {
+    typename SyntheticGraph<N>::Root* root =
+        injector_->Get<typename SyntheticGraph<N>::Root*>();
+    sink += reinterpret_cast<size_t>(root);
+    delete root;
+  }
+
+ private:
+  const Injector* injector_;
+};
+
+// Creates the root of SyntheticGraph<N> directly.
+template <int N>
+class DirectCreateSyntheticGraph {
+ public:
+  void operator()() const {
+    static SyntheticConfig* config = new SyntheticConfig();
+    typename SyntheticGraph<N>::Root* root =
+        SyntheticGraph<N>::CreateDirect(config);
+    sink += reinterpret_cast<size_t>(root);
+    delete root;
+  }
+};
+
+// Runs the benchmarks of SyntheticGraph<N>.
+template <int N>
+void RunSyntheticGraphBenchmarks(int iterations) {
+  typename SyntheticGraph<N>::Module module;
+  scoped_ptr<Injector> injector(guicpp::CreateInjector(&module));
+
+  std::ostringstream name;
+  name << N + 1 << " node graph";
+  RunBenchmark("Injector::Get of " + name.str(), iterations,
+               InjectorGetSyntheticGraph<N>(injector.get()));
+  RunBenchmark("Direct creation of " + name.str(), iterations,
+               DirectCreateSyntheticGraph<N>());
+}
+
+}  // namespace guicpp_benchmark
+
+int main(int argc, char** argv) {
+  using guicpp_benchmark::DirectCreate;
+  using guicpp_benchmark::DirectCreatePush;
+  using guicpp_benchmark::InjectorGet;
+  using guicpp_benchmark::InjectorGetFactory;
+  using guicpp_benchmark::InjectorGetSharedFactory;
+  using guicpp_benchmark::InjectorGetValue;
+  using guicpp_benchmark::NotificationModule;
+  using guicpp_benchmark::PushNotificationModule;
+  using guicpp_benchmark::RunBenchmark;
+  using guicpp_benchmark::StaticInjectorGet;
+
+  const int kIterations = 1000000;
+
+  NotificationModule module;
+  guicpp::scoped_ptr<guicpp::Injector> injector(
+      guicpp::CreateInjector(&module));
+
+  RunBenchmark("Injector::Get", kIterations, InjectorGet(injector.get()));
+  RunBenchmark("Injector::Get of value", kIterations,
+               InjectorGetValue(injector.get()));
+  RunBenchmark("Injector::Get of factory", kIterations,
+               InjectorGetFactory(injector.get()));
+  RunBenchmark("Injector::Get of shared factory", kIterations,
+               InjectorGetSharedFactory(injector.get()));
+  RunBenchmark("Direct creation", kIterations, DirectCreate());
+
+  PushNotificationModule push_module;
+  guicpp::scoped_ptr<guicpp::Injector> push_injector(
+      guicpp::CreateInjector(&push_module));
+
+  RunBenchmark("Injector::Get (pointers only)", kIterations,
+               InjectorGet(push_injector.get()));
+  RunBenchmark("StaticInjector::Get (pointers only)", kIterations,
+               StaticInjectorGet());
+  RunBenchmark("Direct creation (pointers only)", kIterations,
+               DirectCreatePush());
+
+  guicpp_benchmark::RunSyntheticGraphBenchmarks<9>(kIterations / 10);
+  guicpp_benchmark::RunSyntheticGraphBenchmarks<99>(kIterations / 100);
+  return 0;
+}
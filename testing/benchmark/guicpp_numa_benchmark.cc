@@ -0,0 +1,222 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// Compares reading a read-mostly table bound to PerNumaNodeSingleton from
+// the memory of the node of the reading thread (local) with reading the
+// replica of another node (remote). A remote read is what every thread of
+// the other nodes pays when the table is a LazySingleton.
+//
+// Guic++ does not depend on libnuma; By default only the single-node
+// fallback is measured: Injector::Get() of a PerNumaNodeSingleton binding
+// without NumaTopology, compared with a LazySingleton binding. Build with
+// -DGUICPP_BENCHMARK_LIBNUMA and link with -lnuma to measure local and
+// remote reads, on a machine with several NUMA nodes.
+
+#include <iostream>
+
+#ifdef GUICPP_BENCHMARK_LIBNUMA
+#include <numa.h>
+#endif
+
+#include "guicpp/guicpp.h"
+#include "guicpp/guicpp_binder.h"
+#include "guicpp/guicpp_injector.h"
+#include "guicpp/guicpp_module.h"
+#include "guicpp/guicpp_per_numa_node_singleton.h"
+#include "guicpp/guicpp_singleton.h"
+#include "guicpp/guicpp_tools.h"
+#include "benchmark/guicpp_benchmark.h"
+
+namespace guicpp_benchmark {
+using guicpp::At;
+using guicpp::Binder;
+using guicpp::Injector;
+using guicpp::LazySingleton;
+using guicpp::NumaTopology;
+using guicpp::PerNumaNodeSingleton;
+using guicpp::scoped_ptr;
+
+volatile size_t sink = 0;
+
+// Label of the LazySingleton binding of RoutingTable.
+class SharedTable: public guicpp::Label {};
+
+// A read-mostly table, larger than the caches.
+class RoutingTable {
+ public:
+  static const int kNumRoutes = 1 << 20;
+
+  RoutingTable() {
+    for (int i = 0; i < kNumRoutes; ++i) {
+      routes_[i] = i;
+    }
+  }
+
+  size_t Sum() const {
+    size_t sum = 0;
+    for (int i = 0; i < kNumRoutes; ++i) {
+      sum += routes_[i];
+    }
+
+    return sum;
+  }
+
+ private:
+  int routes_[kNumRoutes];
+};
+
+GUICPP_INJECT_CTOR(RoutingTable, ());
+GUICPP_DEFINE(RoutingTable);
+
+// Binds RoutingTable to PerNumaNodeSingleton, and to LazySingleton when
+// annotated with SharedTable. Binds "topology" unless it is NULL.
+class RoutingModule: public guicpp::Module {
+ public:
+  explicit RoutingModule(NumaTopology* topology): topology_(topology) {}
+
+  void Configure(Binder* binder) const {
+    if (topology_ != NULL) {
+      binder->BindToInstance<NumaTopology>(topology_, guicpp::DoNothing());
+    }
+
+    binder->BindToScope<RoutingTable, PerNumaNodeSingleton>();
+    binder->BindToScope<At<SharedTable, RoutingTable>, LazySingleton>();
+  }
+
+ private:
+  NumaTopology* topology_;
+};
+
+// Gets the replica of the current node.
+class InjectorGetReplica {
+ public:
+  explicit InjectorGetReplica(const Injector* injector)
+      : injector_(injector) {}
+
+  void operator()() const {
+    sink += reinterpret_cast<size_t>(injector_->Get<RoutingTable*>());
+  }
+
+ private:
+  const Injector* injector_;
+};
+
+// Gets the LazySingleton instance.
+class InjectorGetSingleton {
+ public:
+  explicit InjectorGetSingleton(const Injector* injector)
+      : injector_(injector) {}
+
+  void operator()() const {
+    sink += reinterpret_cast<size_t>(
+        injector_->Get<At<SharedTable, RoutingTable*> >());
+  }
+
+ private:
+  const Injector* injector_;
+};
+
+// Reads the whole table.
+class ReadTable {
+ public:
+  explicit ReadTable(const RoutingTable* table): table_(table) {}
+
+  void operator()() const {
+    sink += table_->Sum();
+  }
+
+ private:
+  const RoutingTable* table_;
+};
+
+#ifdef GUICPP_BENCHMARK_LIBNUMA
+// NumaTopology using libnuma, except that the current node is set by the
+// benchmark, so that a thread can get the replica of another node.
+class BenchmarkNumaTopology: public NumaTopology {
+ public:
+  BenchmarkNumaTopology(): current_node_(0) {}
+
+  int GetNumNodes() const { return numa_num_configured_nodes(); }
+  int GetCurrentNode() const { return current_node_; }
+
+  void* AllocateOnNode(size_t size, int node) const {
+    return numa_alloc_onnode(size, node);
+  }
+
+  void FreeOnNode(void* memory, size_t size, int node) const {
+    numa_free(memory, size);
+  }
+
+  void set_current_node(int node) { current_node_ = node; }
+
+ private:
+  int current_node_;
+};
+
+// Reads the replica of node 0 (local) and of the last node (remote) from a
+// thread running on node 0.
+void RunLocalAndRemoteBenchmarks(int iterations) {
+  if (numa_available() < 0 || numa_num_configured_nodes() < 2) {
+    std::cout << "Local and remote reads need several NUMA nodes\n";
+    return;
+  }
+
+  BenchmarkNumaTopology topology;
+  RoutingModule module(&topology);
+  scoped_ptr<Injector> injector(guicpp::CreateInjector(&module));
+
+  // Each replica is created by a thread running on its node.
+  const int remote_node = numa_num_configured_nodes() - 1;
+  numa_run_on_node(remote_node);
+  topology.set_current_node(remote_node);
+  const RoutingTable* remote_table = injector->Get<RoutingTable*>();
+
+  numa_run_on_node(0);
+  topology.set_current_node(0);
+  const RoutingTable* local_table = injector->Get<RoutingTable*>();
+
+  RunBenchmark("Read of local replica", iterations, ReadTable(local_table));
+  RunBenchmark("Read of remote replica", iterations, ReadTable(remote_table));
+}
+#endif  // GUICPP_BENCHMARK_LIBNUMA
+
+}  // namespace guicpp_benchmark
+
+int main(int argc, char** argv) {
+  using guicpp_benchmark::InjectorGetReplica;
+  using guicpp_benchmark::InjectorGetSingleton;
+  using guicpp_benchmark::RoutingModule;
+  using guicpp_benchmark::RunBenchmark;
+
+  const int kIterations = 1000000;
+
+  RoutingModule module(NULL);
+  guicpp::scoped_ptr<guicpp::Injector> injector(
+      guicpp::CreateInjector(&module));
+
+  RunBenchmark("Injector::Get of LazySingleton", kIterations,
+               InjectorGetSingleton(injector.get()));
+  RunBenchmark("Injector::Get of PerNumaNodeSingleton (single node)",
+               kIterations, InjectorGetReplica(injector.get()));
+
+#ifdef GUICPP_BENCHMARK_LIBNUMA
+  guicpp_benchmark::RunLocalAndRemoteBenchmarks(kIterations / 10000);
+#else
+  std::cout << "Built without GUICPP_BENCHMARK_LIBNUMA; Local and remote "
+               "reads are not measured\n";
+#endif
+  return 0;
+}
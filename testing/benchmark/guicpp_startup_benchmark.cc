@@ -0,0 +1,103 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// Measures the cost of building a bind table with 1k, 10k and 100k bindings
+// (as done by Injector::Create()) and of looking up all of them once. Also
+// measures the same with a lookup made while binding after each binding,
+// as Binder does for multibindings and scopes.
+// Bindings use synthetic TypeIds as real modules of that size would require
+// as many types.
+
+#include <sstream>
+#include <vector>
+
+#include "guicpp/internal/guicpp_port.h"
+#include "guicpp/internal/guicpp_entries.h"
+#include "guicpp/internal/guicpp_table.h"
+#include "guicpp/internal/guicpp_types.h"
+#include "benchmark/guicpp_benchmark.h"
+
+namespace guicpp_benchmark {
+using guicpp::internal::BindTable;
+using guicpp::internal::TypeId;
+using guicpp::internal::ValueTableEntry;
+
+volatile size_t sink = 0;
+
+// Creates a bind table with "num_bindings" bindings and looks up each of
+// them once.
+// If "lookup_while_binding" is set, each binding is looked up right after
+// it is added.
+class BuildBindTable {
+ public:
+  BuildBindTable(const std::vector<TypeId>* type_ids,
+                 bool lookup_while_binding)
+      : type_ids_(type_ids), lookup_while_binding_(lookup_while_binding) {}
+
+  void operator()() const {
+    BindTable bind_table;
+    for (size_t i = 0; i < type_ids_->size(); ++i) {
+      bind_table.AddEntry((*type_ids_)[i],
+                          bind_table.NewEntry<ValueTableEntry<int> >(i));
+      if (lookup_while_binding_) {
+        sink += reinterpret_cast<size_t>(
+            bind_table.FindEntry((*type_ids_)[i]));
+      }
+    }
+
+    sink += bind_table.MergeEntries();
+
+    for (size_t i = 0; i < type_ids_->size(); ++i) {
+      sink += reinterpret_cast<size_t>(bind_table.FindEntry((*type_ids_)[i]));
+    }
+  }
+
+ private:
+  const std::vector<TypeId>* type_ids_;
+  const bool lookup_while_binding_;
+};
+
+}  // namespace guicpp_benchmark
+
+int main(int argc, char** argv) {
+  using guicpp_benchmark::BuildBindTable;
+  using guicpp_benchmark::RunBenchmark;
+
+  const int kNumSizes = 3;
+  const int kSizes[kNumSizes] = { 1000, 10000, 100000 };
+
+  // Addresses in a large array serve as unique TypeIds. Shuffled, as the
+  // order of TypeIds of real bindings is unrelated to the order of binding.
+  std::vector<char> storage(kSizes[kNumSizes - 1]);
+
+  for (int i = 0; i < kNumSizes; ++i) {
+    std::vector<guicpp::internal::TypeId> type_ids;
+    for (int j = 0; j < kSizes[i]; ++j) {
+      type_ids.push_back(&storage[(j * 7919) % storage.size()]);
+    }
+
+    std::ostringstream name;
+    name << "BindTable with " << kSizes[i] << " bindings";
+    RunBenchmark(name.str(), 1000000 / kSizes[i],
+                 BuildBindTable(&type_ids, false));
+
+    name << ", looked up while binding";
+    RunBenchmark(name.str(), 1000000 / kSizes[i],
+                 BuildBindTable(&type_ids, true));
+  }
+
+  return 0;
+}
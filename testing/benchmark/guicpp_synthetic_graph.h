@@ -0,0 +1,128 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// This file generates synthetic binding graphs of any size for the Guic++
+// benchmarks. Real modules of a few hundred bindings would need as many
+// hand-written types; Here the types are instantiated from templates.
+//
+// SyntheticGraph<N> is a graph of N + 1 nodes:
+//   SyntheticInterface<N>         (bound to SyntheticNode<N>)
+//     +-- SyntheticInterface<N-1> (bound to SyntheticNode<N-1>)
+//     |     +-- ...
+//     |           +-- SyntheticInterface<0> (bound to SyntheticLeaf)
+//     +-- SyntheticConfig*        (lazy singleton, shared by all the nodes)
+//
+// SyntheticGraph<N>::Module binds all of the nodes, so that the graph has
+// N + 2 bindings, and SyntheticGraph<N>::CreateDirect() creates the same
+// graph without the injector, the way a lookup-free generated injector
+// would. N is limited by the template instantiation depth of the compiler
+// (a few hundred).
+
+#ifndef GUICPP_SYNTHETIC_GRAPH_H_
+#define GUICPP_SYNTHETIC_GRAPH_H_
+
+#include "guicpp/guicpp.h"
+#include "guicpp/guicpp_binder.h"
+#include "guicpp/guicpp_module.h"
+#include "guicpp/guicpp_singleton.h"
+
+namespace guicpp_benchmark {
+// Shared by all the nodes of a graph.
+class SyntheticConfig {
+ public:
+  SyntheticConfig() {}
+};
+
+GUICPP_INJECT_INLINE_CTOR(SyntheticConfig, ());
+
+// Node "N" of a graph is injected through this interface.
+template <int N>
+class SyntheticInterface {
+ public:
+  virtual ~SyntheticInterface() {}
+};
+
+template <int N>
+GUICPP_TEMPLATE_INJECTABLE((SyntheticInterface<N>));
+
+// Owns the node it depends on.
+template <int N>
+class SyntheticNode: public SyntheticInterface<N> {
+ public:
+  SyntheticNode(SyntheticInterface<N - 1>* previous, SyntheticConfig* config)
+      : previous_(previous), config_(config) {}
+
+ private:
+  guicpp::scoped_ptr<SyntheticInterface<N - 1> > previous_;
+  SyntheticConfig* config_;  // Not owned.
+};
+
+template <int N>
+GUICPP_TEMPLATE_INJECT_CTOR((SyntheticNode<N>), (
+    SyntheticInterface<N - 1>* previous, SyntheticConfig* config));
+
+// The last node, depends only on the config.
+class SyntheticLeaf: public SyntheticInterface<0> {
+ public:
+  explicit SyntheticLeaf(SyntheticConfig* config): config_(config) {}
+
+ private:
+  SyntheticConfig* config_;  // Not owned.
+};
+
+GUICPP_INJECT_INLINE_CTOR(SyntheticLeaf, (SyntheticConfig* config));
+
+template <int N>
+class SyntheticGraph {
+ public:
+  // Binds the nodes N to 0 and the config.
+  class Module: public guicpp::Module {
+   public:
+    void Configure(guicpp::Binder* binder) const {
+      binder->BindToScope<SyntheticConfig, guicpp::LazySingleton>();
+      SyntheticGraph::BindNodes(binder);
+    }
+  };
+
+  typedef SyntheticInterface<N> Root;
+
+  // Binds the nodes N to 0.
+  static void BindNodes(guicpp::Binder* binder) {
+    binder->Bind<SyntheticInterface<N>, SyntheticNode<N> >();
+    SyntheticGraph<N - 1>::BindNodes(binder);
+  }
+
+  // Creates the nodes N to 0 with direct constructor calls.
+  static SyntheticInterface<N>* CreateDirect(SyntheticConfig* config) {
+    return new SyntheticNode<N>(
+        SyntheticGraph<N - 1>::CreateDirect(config), config);
+  }
+};
+
+template <>
+class SyntheticGraph<0> {
+ public:
+  static void BindNodes(guicpp::Binder* binder) {
+    binder->Bind<SyntheticInterface<0>, SyntheticLeaf>();
+  }
+
+  static SyntheticInterface<0>* CreateDirect(SyntheticConfig* config) {
+    return new SyntheticLeaf(config);
+  }
+};
+
+}  // namespace guicpp_benchmark
+
+#endif  // GUICPP_SYNTHETIC_GRAPH_H_
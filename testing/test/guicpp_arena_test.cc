@@ -0,0 +1,71 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// Tests for Arena declared in arena.h.
+
+#include "guicpp/internal/guicpp_arena.h"
+
+#include "include/gmock/gmock.h"
+#include "include/gtest/gtest.h"
+#include "guicpp/internal/guicpp_port.h"
+
+namespace guicpp {
+namespace internal {
+
+TEST(ArenaTest, Allocate_ReturnsAlignedDistinctMemory) {
+  Arena arena;
+  char* ptr1 = static_cast<char*>(arena.Allocate(1));
+  char* ptr2 = static_cast<char*>(arena.Allocate(24));
+  char* ptr3 = static_cast<char*>(arena.Allocate(8));
+
+  EXPECT_EQ(0, reinterpret_cast<size_t>(ptr1) % sizeof(double));
+  EXPECT_EQ(0, reinterpret_cast<size_t>(ptr2) % sizeof(double));
+  EXPECT_EQ(0, reinterpret_cast<size_t>(ptr3) % sizeof(double));
+
+  EXPECT_LE(ptr1 + 1, ptr2);
+  EXPECT_LE(ptr2 + 24, ptr3);
+}
+
+TEST(ArenaTest, Contains_ReturnsTrueOnlyForArenaMemory) {
+  Arena arena;
+  int on_stack = 0;
+  scoped_ptr<int> on_heap(new int(0));
+  EXPECT_FALSE(arena.Contains(&on_stack));
+
+  char* small = static_cast<char*>(arena.Allocate(16));
+  char* large = static_cast<char*>(arena.Allocate(100000));
+
+  EXPECT_TRUE(arena.Contains(small));
+  EXPECT_TRUE(arena.Contains(small + 15));
+  EXPECT_TRUE(arena.Contains(large));
+  EXPECT_TRUE(arena.Contains(large + 99999));
+  EXPECT_FALSE(arena.Contains(&on_stack));
+  EXPECT_FALSE(arena.Contains(on_heap.get()));
+}
+
+TEST(ArenaTest, BytesReserved_IncludesAllBlocks) {
+  Arena arena;
+  EXPECT_EQ(0, arena.bytes_reserved());
+
+  for (int i = 0; i < 1000; ++i) {
+    arena.Allocate(32);
+  }
+
+  EXPECT_LE(1000 * 32, arena.bytes_reserved());
+}
+
+}  // namespace internal
+}  // namespace guicpp
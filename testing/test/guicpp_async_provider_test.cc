@@ -0,0 +1,214 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Tests for AbstractAsyncProvider and Binder::BindToAsyncProvider().
+
+#include "guicpp/guicpp_async_provider.h"
+
+#include <string>
+#include <vector>
+
+#include "include/gmock/gmock.h"
+#include "include/gtest/gtest.h"
+#include "guicpp/internal/guicpp_port.h"
+#include "guicpp/guicpp_binder.h"
+#include "guicpp/guicpp_executor.h"
+#include "guicpp/guicpp_injector.h"
+#include "guicpp/guicpp_module.h"
+#include "include/guicpp_test_helper.h"
+#include "guicpp/guicpp_tools.h"
+
+namespace guicpp {
+using guicpp_test::TestBaseClass;
+using guicpp_test::TestLabelOne;
+using guicpp_test::TestSimpleInjectableClass;
+using testing::InSequence;
+using testing::MockFunction;
+using testing::NotNull;
+
+// Records the calls to Start() and Get() in "calls".
+class TestAsyncProvider: public AbstractAsyncProvider<
+      TestBaseClass* (TestSimpleInjectableClass* simple_object)> {
+ public:
+  TestAsyncProvider(const string& name,
+                    MockFunction<void(string call)>* calls)
+      : name_(name), calls_(calls), is_started_(false) {}
+
+  void Start() {
+    is_started_ = true;
+    calls_->Call(name_ + ".Start");
+  }
+
+  TestBaseClass* Get(TestSimpleInjectableClass* simple_object) {
+    EXPECT_TRUE(is_started_) << "Get() is called before Start()";
+    calls_->Call(name_ + ".Get");
+    return simple_object;
+  }
+
+ private:
+  const string name_;
+  MockFunction<void(string call)>* calls_;
+  bool is_started_;
+};
+
+class TestAsyncProviderModule: public Module {
+ public:
+  explicit TestAsyncProviderModule(MockFunction<void(string call)>* calls)
+      : calls_(calls) {}
+
+  void Configure(Binder* binder) const {
+    binder->BindToAsyncProvider<TestBaseClass>(
+        new TestAsyncProvider("first", calls_), DeletePointer());
+
+    binder->BindToAsyncProvider<At<TestLabelOne, TestBaseClass> >(
+        new TestAsyncProvider("second", calls_), DeletePointer());
+  }
+
+ private:
+  MockFunction<void(string call)>* calls_;
+};
+
+TEST(GuicppAsyncProviderTest, StartIsCalledForAllProvidersBeforeAnyGet) {
+  MockFunction<void(string call)> calls;
+  {
+    InSequence sequence;
+
+    EXPECT_CALL(calls, Call("first.Start"));
+    EXPECT_CALL(calls, Call("second.Start"));
+    EXPECT_CALL(calls, Call("injector created"));
+    EXPECT_CALL(calls, Call("second.Get"));
+    EXPECT_CALL(calls, Call("first.Get"));
+  }
+
+  TestAsyncProviderModule module(&calls);
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+  calls.Call("injector created");
+
+  scoped_ptr<TestBaseClass> second(
+      injector->Get<At<TestLabelOne, TestBaseClass*> >());
+  EXPECT_THAT(second.get(), NotNull());
+
+  scoped_ptr<TestBaseClass> first(injector->Get<TestBaseClass*>());
+  EXPECT_THAT(first.get(), NotNull());
+}
+
+TEST(GuicppAsyncProviderTest, StartIsCalledEvenIfInstanceIsNeverRequested) {
+  MockFunction<void(string call)> calls;
+  EXPECT_CALL(calls, Call("first.Start"));
+  EXPECT_CALL(calls, Call("second.Start"));
+
+  TestAsyncProviderModule module(&calls);
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+}
+
+// Executor that queues the closures until RunAll() is called.
+class TestQueueExecutor: public Executor {
+ public:
+  TestQueueExecutor() {}
+
+  ~TestQueueExecutor() {
+    EXPECT_TRUE(closures_.empty()) << "Closures are never run";
+  }
+
+  void Schedule(Closure* closure) {
+    closures_.push_back(closure);
+  }
+
+  void RunAll() {
+    for (size_t i = 0; i < closures_.size(); ++i) {
+      closures_[i]->Run();
+      delete closures_[i];
+    }
+
+    closures_.clear();
+  }
+
+ private:
+  std::vector<Closure*> closures_;
+};
+
+class TestAsyncProviderWithExecutorModule: public Module {
+ public:
+  TestAsyncProviderWithExecutorModule(MockFunction<void(string call)>* calls,
+                                      TestQueueExecutor* executor)
+      : async_module_(calls), executor_(executor) {}
+
+  void Configure(Binder* binder) const {
+    binder->BindToInstance<At<AsyncStartExecutor, Executor> >(
+        executor_, DoNothing());
+    binder->Install(&async_module_);
+  }
+
+ private:
+  TestAsyncProviderModule async_module_;
+  TestQueueExecutor* executor_;
+};
+
+TEST(GuicppAsyncProviderTest, StartIsScheduledOnBoundExecutor) {
+  MockFunction<void(string call)> calls;
+  {
+    InSequence sequence;
+
+    EXPECT_CALL(calls, Call("injector created"));
+    EXPECT_CALL(calls, Call("first.Start"));
+    EXPECT_CALL(calls, Call("second.Start"));
+    EXPECT_CALL(calls, Call("first.Get"));
+  }
+
+  TestQueueExecutor executor;
+  TestAsyncProviderWithExecutorModule module(&calls, &executor);
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+  calls.Call("injector created");
+
+  // Start() methods are called only when executor runs the closures.
+  executor.RunAll();
+
+  scoped_ptr<TestBaseClass> first(injector->Get<TestBaseClass*>());
+  EXPECT_THAT(first.get(), NotNull());
+}
+
+TEST(GuicppAsyncProviderTest, GetCallsStartIfExecutorHasNotRunIt) {
+  MockFunction<void(string call)> calls;
+  {
+    InSequence sequence;
+
+    EXPECT_CALL(calls, Call("first.Start"));
+    EXPECT_CALL(calls, Call("first.Get"));
+    EXPECT_CALL(calls, Call("second.Start"));
+  }
+
+  TestQueueExecutor executor;
+  TestAsyncProviderWithExecutorModule module(&calls, &executor);
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+
+  scoped_ptr<TestBaseClass> first(injector->Get<TestBaseClass*>());
+  EXPECT_THAT(first.get(), NotNull());
+
+  // Start() of "first" is not called again.
+  executor.RunAll();
+}
+
+TEST(GuicppAsyncProviderTest, ClosureRunAfterInjectorIsDeletedDoesNothing) {
+  MockFunction<void(string call)> calls;
+  EXPECT_CALL(calls, Call(testing::_)).Times(0);
+
+  TestQueueExecutor executor;
+  TestAsyncProviderWithExecutorModule module(&calls, &executor);
+  delete CreateInjector(&module);
+
+  executor.RunAll();
+}
+
+}  // namespace guicpp
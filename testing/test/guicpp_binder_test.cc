@@ -295,6 +295,45 @@ TEST_F(GuicppBinderTest, BindToInstance_ConstTypeCanBeAnnotated) {
   EXPECT_EQ(object, bound_object);
 }
 
+TEST_F(GuicppBinderTest, BindToSwappableInstance_ReturnsHandleToSwap) {
+  TestInjectableSubClass* first = new TestInjectableSubClass();
+  SwappableInstance<TestBaseClass>* handle =
+      binder_->BindToSwappableInstance<At<TestLabelOne, TestBaseClass> >(
+          first, DeletePointer());
+
+  SwappableRef<TestBaseClass> bound_object;
+  ASSERT_NO_FATAL_FAILURE((
+      TestSafeGetInstance<At<TestLabelOne, SwappableRef<TestBaseClass> > >(
+          internal::TableEntryBase::BIND_TO_SWAPPABLE_INSTANCE,
+          &bound_object)));
+  EXPECT_EQ(first, bound_object.get());
+
+  TestInjectableSubClass* second = new TestInjectableSubClass();
+  handle->Swap(second);
+
+  ASSERT_NO_FATAL_FAILURE((
+      TestSafeGetInstance<At<TestLabelOne, SwappableRef<TestBaseClass> > >(
+          internal::TableEntryBase::BIND_TO_SWAPPABLE_INSTANCE,
+          &bound_object)));
+  EXPECT_EQ(second, bound_object.get());
+}
+
+TEST_F(GuicppBinderTest, BindToSwappableInstance_InjectedRefOutlivesSwaps) {
+  SwappableInstance<TestBaseClass>* handle =
+      binder_->BindToSwappableInstance<TestBaseClass>(
+          new TestInjectableSubClass(), DeletePointer());
+
+  SwappableRef<TestBaseClass> injected;
+  ASSERT_NO_FATAL_FAILURE((
+      TestSafeGetInstance<SwappableRef<TestBaseClass> >(
+          internal::TableEntryBase::BIND_TO_SWAPPABLE_INSTANCE, &injected)));
+
+  // The replaced instance is deleted along with "injected".
+  handle->Swap(new TestInjectableSubClass());
+  handle->Swap(new TestInjectableSubClass());
+  EXPECT_EQ("TestInjectableSubClass", injected->GetClassName());
+}
+
 TEST_F(GuicppBinderTest, BindToValue_HoldsValueAndCanBeAnnotated) {
   binder_->BindToValue<int>(100);
   binder_->BindToValue<At<TestLabelOne, int> >(200);
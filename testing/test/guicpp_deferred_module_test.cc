@@ -0,0 +1,168 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// Tests for guicpp::DeferredModule and Binder::InstallDeferred().
+
+#include "guicpp/guicpp_deferred_module.h"
+
+#include <string>
+
+#include "include/gmock/gmock.h"
+#include "include/gtest/gtest.h"
+#include "guicpp/internal/guicpp_port.h"
+#include "guicpp/guicpp_binder.h"
+#include "guicpp/guicpp_injector.h"
+#include "guicpp/guicpp_module.h"
+#include "guicpp/guicpp_singleton.h"
+#include "guicpp/guicpp_strings.h"
+#include "include/guicpp_test_helper.h"
+#include "guicpp/guicpp_tools.h"
+
+namespace guicpp {
+using guicpp_test::TestBaseClass;
+using guicpp_test::TestClassWithDeleteMarker;
+using guicpp_test::TestDeleteMarker;
+using guicpp_test::TestLabelOne;
+using guicpp_test::TestSimpleInjectableClass;
+
+// Counts the calls to Configure().
+class TestDeferredModule: public DeferredModule {
+ public:
+  explicit TestDeferredModule(int* num_configured)
+      : num_configured_(num_configured) {}
+
+  void DeclareKeys(DeferredKeys* keys) const {
+    keys->Add<TestBaseClass*>();
+    keys->Add<At<TestLabelOne, string> >();
+    keys->Add<TestClassWithDeleteMarker*>();
+  }
+
+  void Configure(Binder* binder) const {
+    ++*num_configured_;
+    binder->Bind<TestBaseClass, TestSimpleInjectableClass>();
+    binder->BindToValue<At<TestLabelOne, string> >("deferred");
+    binder->BindToScope<TestClassWithDeleteMarker, LazySingleton>();
+  }
+
+ private:
+  int* num_configured_;
+};
+
+class TestInstallDeferredModule: public Module {
+ public:
+  explicit TestInstallDeferredModule(int* num_configured)
+      : deferred_module_(num_configured) {}
+
+  void Configure(Binder* binder) const {
+    binder->BindToValue<int>(1);
+    binder->InstallDeferred(&deferred_module_);
+  }
+
+ private:
+  TestDeferredModule deferred_module_;
+};
+
+TEST(GuicppDeferredModuleTest, ConfigureIsCalledOnFirstRequestOfDeclaredType) {
+  int num_configured = 0;
+  TestInstallDeferredModule module(&num_configured);
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+
+  EXPECT_EQ(1, injector->Get<int>());
+  EXPECT_EQ(0, num_configured);
+
+  scoped_ptr<TestBaseClass> object(injector->Get<TestBaseClass*>());
+  EXPECT_EQ("TestSimpleInjectableClass", object->GetClassName());
+  EXPECT_EQ(1, num_configured);
+
+  EXPECT_EQ("deferred", (injector->Get<At<TestLabelOne, string> >()));
+  EXPECT_EQ(1, num_configured);
+}
+
+TEST(GuicppDeferredModuleTest, ConfigureIsNeverCalledIfNotRequested) {
+  int num_configured = 0;
+  {
+    TestInstallDeferredModule module(&num_configured);
+    scoped_ptr<Injector> injector(CreateInjector(&module));
+    EXPECT_EQ(1, injector->Get<int>());
+  }
+
+  EXPECT_EQ(0, num_configured);
+}
+
+TEST(GuicppDeferredModuleTest, SingletonOfDeferredModuleIsDeletedWithInjector) {
+  int num_configured = 0;
+  TestInstallDeferredModule module(&num_configured);
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+
+  TestClassWithDeleteMarker* object =
+      injector->Get<TestClassWithDeleteMarker*>();
+  EXPECT_EQ(object, injector->Get<TestClassWithDeleteMarker*>());
+
+  TestDeleteMarker delete_marker;
+  object->SetDeleteMarker(&delete_marker);
+  EXPECT_CALL(delete_marker, Call(object));
+
+  injector.reset();
+}
+
+// Binds At<TestLabelOne, string>, which is also bound by TestDeferredModule.
+class TestConflictingModule: public Module {
+ public:
+  explicit TestConflictingModule(int* num_configured)
+      : deferred_module_(num_configured) {}
+
+  void Configure(Binder* binder) const {
+    binder->BindToValue<At<TestLabelOne, string> >("eager");
+    binder->InstallDeferred(&deferred_module_);
+  }
+
+ private:
+  TestDeferredModule deferred_module_;
+};
+
+TEST(GuicppDeferredModuleDeathTest, DuplicateBindingFailsOnInstallation) {
+  int num_configured = 0;
+  TestConflictingModule module(&num_configured);
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+
+  EXPECT_DEATH(injector->Get<TestBaseClass*>(),
+               "Installation of deferred module failed");
+}
+
+// Installs the same deferred module twice.
+class TestInstallTwiceModule: public Module {
+ public:
+  explicit TestInstallTwiceModule(int* num_configured)
+      : deferred_module_(num_configured) {}
+
+  void Configure(Binder* binder) const {
+    binder->InstallDeferred(&deferred_module_);
+    binder->InstallDeferred(&deferred_module_);
+  }
+
+ private:
+  TestDeferredModule deferred_module_;
+};
+
+TEST(GuicppDeferredModuleDeathTest, DuplicateDeclarationFails) {
+  int num_configured = 0;
+  TestInstallTwiceModule module(&num_configured);
+
+  EXPECT_DEATH(CreateInjector(&module),
+               "Type is already declared by another deferred module");
+}
+
+}  // namespace guicpp
@@ -0,0 +1,126 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Tests for EmplaceFactory and RealEmplaceFactory.
+
+#include "guicpp/guicpp_emplace_factory.h"
+
+#include <string>
+
+#include "include/gmock/gmock.h"
+#include "include/gtest/gtest.h"
+#include "guicpp/internal/guicpp_port.h"
+#include "guicpp/guicpp_binder.h"
+#include "guicpp/guicpp_injector.h"
+#include "guicpp/guicpp_module.h"
+#include "guicpp/guicpp_strings.h"
+#include "include/guicpp_test_helper.h"
+#include "guicpp/guicpp_tools.h"
+
+namespace guicpp {
+using guicpp_test::TestBaseClass;
+using guicpp_test::TestInjectableSubClass;
+using guicpp_test::TestLabelOne;
+
+// Takes a name from the factory and a TestBaseClass from the injector.
+class TestEmplacedClass {
+ public:
+  TestEmplacedClass(const string& name, TestBaseClass* base_object)
+      : name_(name), base_object_(base_object) {
+    ++num_alive;
+  }
+
+  ~TestEmplacedClass() {
+    --num_alive;
+  }
+
+  const string& name() const { return name_; }
+  const TestBaseClass* base_object() const { return base_object_.get(); }
+
+  static int num_alive;
+
+ private:
+  const string name_;
+  scoped_ptr<TestBaseClass> base_object_;
+};
+
+int TestEmplacedClass::num_alive = 0;
+
+GUICPP_INJECT_CTOR(TestEmplacedClass, (
+    At<Assisted, TestLabelOne, const string&> name,
+    TestBaseClass* base_object));
+
+GUICPP_DEFINE(TestEmplacedClass);
+
+class TestEmplacedClassFactory: public EmplaceFactory<
+      TestEmplacedClass (At<TestLabelOne, const string&> name)> {};
+
+class TestEmplaceModule: public Module {
+ public:
+  void Configure(Binder* binder) const {
+    binder->Bind<TestBaseClass, TestInjectableSubClass>();
+  }
+};
+
+class GuicppEmplaceFactoryTest: public testing::Test {
+ protected:
+  void SetUp() {
+    TestEmplacedClass::num_alive = 0;
+    injector_.reset(CreateInjector(&module_));
+  }
+
+  TestEmplaceModule module_;
+  scoped_ptr<Injector> injector_;
+};
+
+TEST_F(GuicppEmplaceFactoryTest, StorageSizeAndAlignmentAreOfObjectType) {
+  EXPECT_EQ(sizeof(TestEmplacedClass), TestEmplacedClassFactory::kObjectSize);
+  EXPECT_EQ(internal::AlignOf<TestEmplacedClass>::value,
+            TestEmplacedClassFactory::kObjectAlignment);
+  EXPECT_LE(sizeof(TestEmplacedClass),
+            sizeof(EmplaceStorage<TestEmplacedClassFactory>));
+}
+
+TEST_F(GuicppEmplaceFactoryTest, ConstructsObjectInGivenStorage) {
+  scoped_ptr<TestEmplacedClassFactory> factory(
+      injector_->Get<TestEmplacedClassFactory*>());
+
+  EmplaceStorage<TestEmplacedClassFactory> storage;
+  TestEmplacedClass* object = factory->Emplace(storage.get(), "first");
+
+  EXPECT_EQ(storage.get(), object);
+  EXPECT_EQ("first", object->name());
+  EXPECT_EQ("TestInjectableSubClass", object->base_object()->GetClassName());
+  EXPECT_EQ(1, TestEmplacedClass::num_alive);
+
+  object->~TestEmplacedClass();
+  EXPECT_EQ(0, TestEmplacedClass::num_alive);
+}
+
+TEST_F(GuicppEmplaceFactoryTest, StorageCanBeReused) {
+  const TestEmplacedClassFactory& factory =
+      injector_->Get<const TestEmplacedClassFactory&>();
+
+  EmplaceStorage<TestEmplacedClassFactory> storage;
+  for (int i = 0; i < 3; ++i) {
+    TestEmplacedClass* object = factory.Emplace(storage.get(), "reused");
+    EXPECT_EQ("reused", object->name());
+    object->~TestEmplacedClass();
+  }
+
+  EXPECT_EQ(0, TestEmplacedClass::num_alive);
+}
+
+}  // namespace guicpp
@@ -104,7 +104,56 @@ TEST(PointerTableEntryTest, ReturnsPointerTakenInCtorAndUsesCleanupAction) {
   delete entry;  // Invokes TestCleanupAction with the object
 }
 
-// Tests for ValueTableEntry
+// Tests for SwappableInstanceEntry
+TEST(SwappableInstanceEntryTest, CleansUpReplacedPointerWithLastRef) {
+  typedef SwappableRef<TestSimpleInjectableClass> Ref;
+  TestSimpleInjectableClass first(1), second(2), third(3);
+
+  MockFunction<void(string description)>  checkpoint;
+  Expectation drop_ref = EXPECT_CALL(checkpoint, Call("drop ref"));
+  Expectation swap_third = EXPECT_CALL(checkpoint, Call("swap third"));
+  Expectation delete_entry = EXPECT_CALL(checkpoint, Call("delete entry"));
+
+  MockCleanupAction<TestSimpleInjectableClass> mock_cleanup;
+  TestCleanupAction<TestSimpleInjectableClass> test_action(&mock_cleanup);
+  EXPECT_CALL(mock_cleanup, Cleanup(&first)).After(drop_ref);
+  EXPECT_CALL(mock_cleanup, Cleanup(&second)).After(swap_third);
+  EXPECT_CALL(mock_cleanup, Cleanup(&third)).After(delete_entry);
+
+  SwappableInstanceEntry<
+      TestSimpleInjectableClass,
+      TestCleanupAction<TestSimpleInjectableClass> >* entry =
+          new SwappableInstanceEntry<
+              TestSimpleInjectableClass,
+              TestCleanupAction<TestSimpleInjectableClass> >(
+                  &first, test_action);
+
+  EXPECT_EQ(TypeIdProvider<Ref>::GetTypeId(), entry->GetTypeId());
+  EXPECT_EQ(TypesCategory::IS_VALUE, entry->GetCategory());
+  EXPECT_EQ(TableEntryBase::BIND_TO_SWAPPABLE_INSTANCE, entry->GetBindType());
+
+  scoped_ptr<Injector> injector(guicpp_test::GetEmptyInjector());
+  internal::LocalContext local_context;
+
+  Ref injected = entry->Get(injector.get(), &local_context);
+  EXPECT_EQ(&first, injected.get());
+
+  // A pointer still referenced is not cleaned up when it is swapped out.
+  entry->Swap(&second);
+  EXPECT_EQ(&second, entry->Get(injector.get(), &local_context).get());
+  EXPECT_EQ(1, injected->value());
+
+  checkpoint.Call("drop ref");
+  injected = Ref();  // Cleans up "first".
+
+  checkpoint.Call("swap third");
+  entry->Swap(&third);  // Cleans up "second", which has no refs.
+  EXPECT_EQ(&third, entry->Get(injector.get(), &local_context).get());
+
+  checkpoint.Call("delete entry");
+  delete entry;  // Cleans up "third".
+}
+
 TEST(ValueTableEntryTest, Get_ReturnsTheValueTakenInCtor) {
   ValueTableEntry<int> entry(100);
 
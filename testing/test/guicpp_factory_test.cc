@@ -85,5 +85,49 @@ TEST(RealFactoryTest,
   EXPECT_EQ(object, top_object->simple_user()->simple_object());
 }
 
+TEST(RealFactoryTest, FactoryInjectedAsConstReferenceIsShared) {
+  TestTopLevelSubClassBindModule module;
+  scoped_ptr<Injector> injector(Injector::Create(&module));
+
+  const TestFactoryInterface& factory1 =
+      injector->Get<const TestFactoryInterface&>();
+  const TestFactoryInterface& factory2 =
+      injector->Get<const TestFactoryInterface&>();
+  EXPECT_EQ(&factory1, &factory2);
+
+  // A factory with a different label is a different instance; It creates
+  // the type bound with the label.
+  const TestFactoryInterface& labelled_factory =
+      injector->Get<At<TestLabelOne, const TestFactoryInterface&> >();
+  EXPECT_NE(&factory1, &labelled_factory);
+
+  TestSimpleInjectableClass* object = new TestSimpleInjectableClass(100);
+  scoped_ptr<TestTopLevelClass> top_object(labelled_factory.Get(object));
+  EXPECT_EQ("TestTopLevelSubClass", top_object->GetClassName());
+}
+
+TEST(RealFactoryTest, EachInjectorSharesItsOwnFactory) {
+  TestTopLevelSubClassBindModule module;
+  scoped_ptr<Injector> injector1(Injector::Create(&module));
+  scoped_ptr<Injector> injector2(Injector::Create(&module));
+
+  const TestFactoryInterface& factory1 =
+      injector1->Get<const TestFactoryInterface&>();
+  const TestFactoryInterface& factory2 =
+      injector2->Get<const TestFactoryInterface&>();
+  EXPECT_NE(&factory1, &factory2);
+  EXPECT_EQ(&factory1, &injector1->Get<const TestFactoryInterface&>());
+  EXPECT_EQ(&factory2, &injector2->Get<const TestFactoryInterface&>());
+
+  // A new injector does not get the factory of a deleted one, even if it is
+  // allocated at the same address.
+  injector1.reset(Injector::Create(&module));
+  const TestFactoryInterface& factory3 =
+      injector1->Get<const TestFactoryInterface&>();
+  TestSimpleInjectableClass* object = new TestSimpleInjectableClass(100);
+  scoped_ptr<TestTopLevelClass> top_object(factory3.Get(object));
+  EXPECT_EQ("TestTopLevelClass", top_object->GetClassName());
+}
+
 }  // namespace internal
 }  // namespace guicpp
@@ -66,6 +66,21 @@ TEST(GuicppInjectorDeathTest, Compile_KeepsTrackOfNumberOfErrors) {
                "Creation of Injector failed: .* 2 errors.*");
 }
 
+// Module decorating a type that is not bound.
+class UnboundDecoratedTypeModule: public Module {
+  void Configure(Binder* binder) const {
+    binder->Bind<TestBaseClass, TestSimpleInjectableClass>();
+    binder->Decorate<At<TestLabelOne, TestBaseClass>,
+                     TestSimpleInjectableClass>();
+  }
+};
+
+TEST(GuicppInjectorDeathTest, Compile_FailsIfDecoratedTypeIsNotBound) {
+  UnboundDecoratedTypeModule module;
+  EXPECT_DEATH(Injector::Create(&module),
+               "Creation of Injector failed: .* 1 errors.*");
+}
+
 // Tests for Injector::Get()
 
 TEST(GuicppInjectorDeathTest, Get_FailsForAbstractClassIfNotBound) {
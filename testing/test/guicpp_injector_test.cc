@@ -258,6 +258,75 @@ TEST(GuicppInjectorTest, Get_CanGetNonPointerType) {
   EXPECT_EQ(300, ip_address_2.value);
 }
 
+TEST(GuicppInjectorTest, MemoryStats_ReportsBindingsOfEachKind) {
+  TestValueBinderClass module;
+  scoped_ptr<Injector> injector(Injector::Create(&module));
+
+  internal::BindTableMemoryStats stats = injector->MemoryStats();
+  EXPECT_EQ(6, stats.num_entries[internal::TableEntryBase::BIND_TO_VALUE]);
+  EXPECT_LT(0, stats.entry_bytes[internal::TableEntryBase::BIND_TO_VALUE]);
+  EXPECT_EQ(0, stats.num_entries[internal::TableEntryBase::BIND_TO_TYPE]);
+  EXPECT_EQ(0, stats.entry_bytes[internal::TableEntryBase::BIND_TO_TYPE]);
+}
+
+class TestUsageCountedModule: public Module {
+ public:
+  void Configure(Binder* binder) const {
+    binder->EnableUsageCounters();
+    binder->BindToValue<uint32>(1000U);
+    binder->BindToInstance<At<TestIpAddressLabel, IpAddress> >(
+        new IpAddress(100), DeletePointer());
+  }
+};
+
+TEST(GuicppInjectorTest, UsageReport_ListsUnusedInstancesAndHotBindings) {
+  TestUsageCountedModule module;
+  scoped_ptr<Injector> injector(Injector::Create(&module));
+
+  EXPECT_EQ(1000U, injector->Get<uint32>());
+  EXPECT_EQ(1000U, injector->Get<uint32>());
+
+  internal::BindTableUsageReport report = injector->UsageReport(10);
+  EXPECT_TRUE(report.is_enabled);
+
+  using internal::InjectorUtil;
+  ASSERT_EQ(1, report.unused_bindings.size());
+  EXPECT_EQ((InjectorUtil::GetBindId<internal::Annotations<TestIpAddressLabel>,
+                                     IpAddress*>()),
+            report.unused_bindings[0].bind_id);
+  EXPECT_EQ((sizeof(internal::PointerTableEntry<IpAddress*, DeletePointer>)),
+            report.unused_bindings[0].entry_bytes);
+  EXPECT_EQ(report.unused_bindings[0].entry_bytes, report.unused_entry_bytes);
+
+  ASSERT_EQ(1, report.hot_bindings.size());
+  EXPECT_EQ((InjectorUtil::GetBindId<internal::Annotations<>, uint32>()),
+            report.hot_bindings[0].bind_id);
+  EXPECT_EQ(2, report.hot_bindings[0].num_lookups);
+}
+
+// Declared only; Binding a pointer to it must not need its definition.
+class TestIncompleteClass;
+
+class TestIncompleteInstanceModule: public Module {
+ public:
+  void Configure(Binder* binder) const {
+    binder->EnableUsageCounters();
+    binder->BindToInstance<TestIncompleteClass>(NULL, DoNothing());
+  }
+};
+
+TEST(GuicppInjectorTest, UsageReport_ListsUnusedInstanceOfIncompleteType) {
+  TestIncompleteInstanceModule module;
+  scoped_ptr<Injector> injector(Injector::Create(&module));
+
+  internal::BindTableUsageReport report = injector->UsageReport(10);
+  ASSERT_EQ(1, report.unused_bindings.size());
+  EXPECT_EQ((internal::InjectorUtil::GetBindId<internal::Annotations<>,
+                                               TestIncompleteClass*>()),
+            report.unused_bindings[0].bind_id);
+  EXPECT_LT(0, report.unused_bindings[0].entry_bytes);
+}
+
 TEST(GuicppInjectorTest, Get_ReturnsThisWhenCalledForInjector) {
   EmptyModule module;
   scoped_ptr<Injector> injector(Injector::Create(&module));
@@ -272,6 +341,87 @@ TEST(GuicppInjectorTest, Get_ReturnsThisWhenCalledForConstInjector) {
   EXPECT_EQ(injector.get(), injector->Get<const Injector*>());
 }
 
+// Decorator that reports the class name of the decorated instance.
+class TestDecoratorClass: public TestBaseClass {
+ public:
+  explicit TestDecoratorClass(TestBaseClass* decorated)
+      : TestBaseClass(decorated->value()), decorated_(decorated) {}
+
+  virtual string GetClassName() const {
+    return "Decorator(" + decorated_->GetClassName() + ")";
+  }
+
+ private:
+  scoped_ptr<TestBaseClass> decorated_;
+};
+
+GUICPP_INJECT_CTOR(TestDecoratorClass,
+                   (At<Assisted, TestBaseClass*> decorated));
+GUICPP_DEFINE(TestDecoratorClass);
+
+// Second decorator, used to test the order of decorators.
+class TestMeterDecoratorClass: public TestBaseClass {
+ public:
+  explicit TestMeterDecoratorClass(TestBaseClass* decorated)
+      : TestBaseClass(decorated->value()), decorated_(decorated) {}
+
+  virtual string GetClassName() const {
+    return "Meter(" + decorated_->GetClassName() + ")";
+  }
+
+ private:
+  scoped_ptr<TestBaseClass> decorated_;
+};
+
+GUICPP_INJECT_CTOR(TestMeterDecoratorClass,
+                   (At<Assisted, TestBaseClass*> decorated));
+GUICPP_DEFINE(TestMeterDecoratorClass);
+
+// Decorates TestBaseClass twice, partly before it is bound.
+class TestDecoratedModule: public Module {
+ public:
+  void Configure(Binder* binder) const {
+    binder->Decorate<TestBaseClass, TestDecoratorClass>();
+    binder->Bind<TestBaseClass, TestSimpleInjectableClass>();
+    binder->Decorate<TestBaseClass, TestMeterDecoratorClass>();
+
+    binder->Bind<At<TestLabelOne, TestBaseClass>, TestSimpleInjectableClass>();
+    binder->Decorate<At<TestLabelOne, TestBaseClass>, TestDecoratorClass>();
+  }
+};
+
+TEST(GuicppInjectorTest, Decorate_DecoratorsStackInOrderOfDecorate) {
+  TestDecoratedModule module;
+  scoped_ptr<Injector> injector(Injector::Create(&module));
+
+  scoped_ptr<TestBaseClass> object(injector->Get<TestBaseClass*>());
+  EXPECT_EQ("Meter(Decorator(TestSimpleInjectableClass))",
+            object->GetClassName());
+
+  scoped_ptr<TestBaseClass> labeled(
+      injector->Get<At<TestLabelOne, TestBaseClass*> >());
+  EXPECT_EQ("Decorator(TestSimpleInjectableClass)", labeled->GetClassName());
+}
+
+TEST(GuicppInjectorTest, Decorate_ChainIsResolvedWhenInjectorIsCreated) {
+  TestDecoratedModule module;
+  scoped_ptr<Injector> injector(Injector::Create(&module));
+
+  // Lookup returns the outermost decorator; The decorated entries are not
+  // looked up on injection.
+  using internal::InjectorUtil;
+  InjectorUtil inject_util(injector.get());
+  const internal::TableEntryBase* entry = inject_util.FindEntry(
+      InjectorUtil::GetBindId<internal::Annotations<>, TestBaseClass*>());
+  ASSERT_TRUE(entry != NULL);
+  EXPECT_EQ(internal::TableEntryBase::BIND_TO_DECORATOR,
+            entry->GetBindType());
+
+  internal::BindTableMemoryStats stats = injector->MemoryStats();
+  EXPECT_EQ(3,
+            stats.num_entries[internal::TableEntryBase::BIND_TO_DECORATOR]);
+}
+
 // Tests for Injector::Create()
 
 TEST(GuicppInjectorTest, Compile_CreatesInjector) {
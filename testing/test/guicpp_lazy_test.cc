@@ -0,0 +1,137 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// Tests for guicpp::Lazy.
+
+#include "guicpp/guicpp_lazy.h"
+
+#include <string>
+
+#include "include/gmock/gmock.h"
+#include "include/gtest/gtest.h"
+#include "guicpp/internal/guicpp_port.h"
+#include "guicpp/guicpp_binder.h"
+#include "guicpp/guicpp_injector.h"
+#include "guicpp/guicpp_module.h"
+#include "include/guicpp_test_helper.h"
+#include "guicpp/guicpp_tools.h"
+
+namespace guicpp {
+using guicpp_test::TestBaseClass;
+using guicpp_test::TestInjectableSubClass;
+using guicpp_test::TestLabelOne;
+using guicpp_test::TestSimpleAssistedArgumentUser;
+using guicpp_test::TestSimpleInjectableClass;
+using testing::NotNull;
+
+// Counts the instances created.
+class TestCountedClass {
+ public:
+  TestCountedClass() {
+    ++num_created;
+  }
+
+  static int num_created;
+};
+
+int TestCountedClass::num_created = 0;
+
+GUICPP_INJECT_CTOR(TestCountedClass, ());
+
+GUICPP_DEFINE(TestCountedClass);
+
+// Takes the lazy handles.
+class TestLazyUser {
+ public:
+  TestLazyUser(Lazy<TestCountedClass*>* counted,
+               Lazy<TestBaseClass*>* base,
+               Lazy<At<TestLabelOne, TestBaseClass*> >* labeled)
+      : counted_(counted), base_(base), labeled_(labeled) {}
+
+  Lazy<TestCountedClass*>* counted() const { return counted_.get(); }
+  Lazy<TestBaseClass*>* base() const { return base_.get(); }
+  Lazy<At<TestLabelOne, TestBaseClass*> >* labeled() const {
+    return labeled_.get();
+  }
+
+ private:
+  scoped_ptr<Lazy<TestCountedClass*> > counted_;
+  scoped_ptr<Lazy<TestBaseClass*> > base_;
+  scoped_ptr<Lazy<At<TestLabelOne, TestBaseClass*> > > labeled_;
+};
+
+GUICPP_INJECT_CTOR(TestLazyUser, (
+    Lazy<TestCountedClass*>* counted,
+    Lazy<TestBaseClass*>* base,
+    Lazy<At<TestLabelOne, TestBaseClass*> >* labeled));
+
+GUICPP_DEFINE(TestLazyUser);
+
+class TestLazyModule: public Module {
+ public:
+  void Configure(Binder* binder) const {
+    binder->Bind<TestBaseClass, TestSimpleInjectableClass>();
+    binder->Bind<At<TestLabelOne, TestBaseClass>, TestInjectableSubClass>();
+  }
+};
+
+TEST(GuicppLazyTest, InstanceIsCreatedOnFirstGet) {
+  TestLazyModule module;
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+
+  TestCountedClass::num_created = 0;
+  scoped_ptr<TestLazyUser> user(injector->Get<TestLazyUser*>());
+  EXPECT_EQ(0, TestCountedClass::num_created);
+
+  scoped_ptr<TestCountedClass> counted(user->counted()->Get());
+  EXPECT_THAT(counted.get(), NotNull());
+  EXPECT_EQ(1, TestCountedClass::num_created);
+}
+
+TEST(GuicppLazyTest, GetReturnsSameInstance) {
+  TestLazyModule module;
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+
+  TestCountedClass::num_created = 0;
+  scoped_ptr<TestLazyUser> user(injector->Get<TestLazyUser*>());
+
+  scoped_ptr<TestCountedClass> counted(user->counted()->Get());
+  EXPECT_EQ(counted.get(), user->counted()->Get());
+  EXPECT_EQ(1, TestCountedClass::num_created);
+}
+
+TEST(GuicppLazyTest, UsesBindingOfAnnotatedType) {
+  TestLazyModule module;
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+  scoped_ptr<TestLazyUser> user(injector->Get<TestLazyUser*>());
+
+  scoped_ptr<TestBaseClass> base(user->base()->Get());
+  EXPECT_EQ("TestSimpleInjectableClass", base->GetClassName());
+
+  scoped_ptr<TestBaseClass> labeled(user->labeled()->Get());
+  EXPECT_EQ("TestInjectableSubClass", labeled->GetClassName());
+}
+
+TEST(GuicppLazyDeathTest, AssistedArgumentIsAnError) {
+  TestLazyModule module;
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+  scoped_ptr<Lazy<TestSimpleAssistedArgumentUser*> > lazy(
+      injector->Get<Lazy<TestSimpleAssistedArgumentUser*>*>());
+
+  EXPECT_DEATH(lazy->Get(), "Expected assisted argument");
+}
+
+}  // namespace guicpp
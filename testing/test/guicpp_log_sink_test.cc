@@ -0,0 +1,174 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// Tests for log sinks and AsyncLogSink.
+
+#include "guicpp/guicpp_log_sink.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "include/gmock/gmock.h"
+#include "include/gtest/gtest.h"
+#include "guicpp/internal/guicpp_port.h"
+#include "guicpp/guicpp_executor.h"
+
+namespace guicpp {
+using internal::GuicppLogSeverity;
+using testing::EndsWith;
+using testing::HasSubstr;
+
+// Records the messages.
+class TestLogSink: public LogSink {
+ public:
+  TestLogSink(): num_flushes_(0) {}
+
+  void Send(GuicppLogSeverity severity, const std::string& message) {
+    messages_.push_back(message);
+  }
+
+  void Flush() {
+    ++num_flushes_;
+  }
+
+  const std::vector<std::string>& messages() const { return messages_; }
+
+ private:
+  std::vector<std::string> messages_;
+  int num_flushes_;
+};
+
+TEST(GuicppLogSinkTest, MessageIsSentToSink) {
+  TestLogSink log_sink;
+  LogSink* previous_sink = SetLogSink(&log_sink);
+  GUICPP_LOG_(ERROR) << "Test message " << 1;
+  SetLogSink(previous_sink);
+
+  ASSERT_EQ(1, log_sink.messages().size());
+  EXPECT_THAT(log_sink.messages()[0], HasSubstr("Test message 1"));
+  EXPECT_THAT(log_sink.messages()[0], EndsWith("\n"));
+}
+
+// Executor that queues the closures until RunAll() is called.
+class TestQueueExecutor: public Executor {
+ public:
+  TestQueueExecutor() {}
+
+  ~TestQueueExecutor() {
+    RunAll();
+  }
+
+  void Schedule(Closure* closure) {
+    closures_.push_back(closure);
+  }
+
+  void RunAll() {
+    for (size_t i = 0; i < closures_.size(); ++i) {
+      closures_[i]->Run();
+      delete closures_[i];
+    }
+
+    closures_.clear();
+  }
+
+  size_t num_closures() const { return closures_.size(); }
+
+ private:
+  std::vector<Closure*> closures_;
+};
+
+TEST(GuicppAsyncLogSinkTest, MessagesAreWrittenOnExecutor) {
+  std::ostringstream stream;
+  TestQueueExecutor executor;
+  AsyncLogSink log_sink(&stream, &executor);
+
+  log_sink.Send(internal::GUICPP_INFO, "first\n");
+  log_sink.Send(internal::GUICPP_INFO, "second\n");
+  EXPECT_EQ("", stream.str());
+  EXPECT_EQ(1, executor.num_closures());
+
+  executor.RunAll();
+  EXPECT_EQ("first\nsecond\n", stream.str());
+
+  log_sink.Send(internal::GUICPP_INFO, "third\n");
+  EXPECT_EQ(1, executor.num_closures());
+  executor.RunAll();
+  EXPECT_EQ("first\nsecond\nthird\n", stream.str());
+}
+
+TEST(GuicppAsyncLogSinkTest, FlushWritesOnCallingThread) {
+  std::ostringstream stream;
+  TestQueueExecutor executor;
+  AsyncLogSink log_sink(&stream, &executor);
+
+  log_sink.Send(internal::GUICPP_INFO, "message\n");
+  log_sink.Flush();
+  EXPECT_EQ("message\n", stream.str());
+
+  // The scheduled closure finds nothing to write.
+  executor.RunAll();
+  EXPECT_EQ("message\n", stream.str());
+}
+
+TEST(GuicppAsyncLogSinkTest, MessagesAreDroppedWhenShardIsFull) {
+  std::ostringstream stream;
+  TestQueueExecutor executor;
+  AsyncLogSink log_sink(&stream, &executor, 16);
+
+  log_sink.Send(internal::GUICPP_INFO, "first\n");
+  log_sink.Send(internal::GUICPP_INFO, "second\n");
+  log_sink.Send(internal::GUICPP_INFO, "third\n");
+  log_sink.Send(internal::GUICPP_INFO, "fourth\n");
+  EXPECT_EQ(2, log_sink.num_dropped());
+
+  executor.RunAll();
+  EXPECT_EQ("first\nsecond\n"
+            "AsyncLogSink: 2 messages dropped, the buffer is full\n",
+            stream.str());
+
+  // The shard has room again once it is written out.
+  stream.str("");
+  log_sink.Send(internal::GUICPP_INFO, "fifth\n");
+  executor.RunAll();
+  EXPECT_EQ("fifth\n", stream.str());
+  EXPECT_EQ(2, log_sink.num_dropped());
+}
+
+TEST(GuicppAsyncLogSinkTest, FatalMessageIsNotDropped) {
+  std::ostringstream stream;
+  TestQueueExecutor executor;
+  AsyncLogSink log_sink(&stream, &executor, 8);
+
+  log_sink.Send(internal::GUICPP_INFO, "message\n");
+  log_sink.Send(internal::GUICPP_FATAL, "fatal\n");
+  log_sink.Flush();
+  EXPECT_EQ("message\nfatal\n", stream.str());
+  EXPECT_EQ(0, log_sink.num_dropped());
+}
+
+TEST(GuicppAsyncLogSinkDeathTest, FatalMessageIsWrittenBeforeAbort) {
+  TestQueueExecutor executor;
+  AsyncLogSink log_sink(&std::cerr, &executor);
+
+  EXPECT_DEATH({
+    SetLogSink(&log_sink);
+    GUICPP_LOG_(ERROR) << "Buffered message";
+    GUICPP_LOG_(FATAL) << "Fatal message";
+  }, "Buffered message(.|\n)*Fatal message");
+}
+
+}  // namespace guicpp
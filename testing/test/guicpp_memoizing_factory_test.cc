@@ -0,0 +1,195 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Tests for MemoizingFactory and RealMemoizingFactory.
+
+#include "guicpp/guicpp_memoizing_factory.h"
+
+#include <string>
+
+#include "include/gmock/gmock.h"
+#include "include/gtest/gtest.h"
+#include "guicpp/internal/guicpp_port.h"
+#include "guicpp/guicpp_binder.h"
+#include "guicpp/guicpp_injector.h"
+#include "guicpp/guicpp_module.h"
+#include "guicpp/guicpp_strings.h"
+#include "include/guicpp_test_helper.h"
+#include "guicpp/guicpp_tools.h"
+
+namespace guicpp {
+using guicpp_test::TestLabelOne;
+
+// Counts the instances alive.
+class TestTenantHandler {
+ public:
+  TestTenantHandler(const string& tenant, int shard)
+      : tenant_(tenant), shard_(shard) {
+    ++num_alive;
+  }
+
+  ~TestTenantHandler() {
+    --num_alive;
+  }
+
+  const string& tenant() const { return tenant_; }
+  int shard() const { return shard_; }
+
+  static int num_alive;
+
+ private:
+  const string tenant_;
+  const int shard_;
+};
+
+int TestTenantHandler::num_alive = 0;
+
+GUICPP_INJECT_CTOR(TestTenantHandler, (
+    At<Assisted, const string&> tenant,
+    At<Assisted, TestLabelOne, int> shard));
+
+GUICPP_DEFINE(TestTenantHandler);
+
+typedef MemoizedPtr<TestTenantHandler> TestTenantHandlerRef;
+
+class TestTenantHandlerFactory: public MemoizingFactory<
+      TestTenantHandlerRef (const string& tenant, At<TestLabelOne, int> shard),
+      2> {};
+
+class TestEmptyModule: public Module {
+ public:
+  void Configure(Binder* binder) const {}
+};
+
+class GuicppMemoizingFactoryTest: public testing::Test {
+ protected:
+  void SetUp() {
+    TestTenantHandler::num_alive = 0;
+    injector_.reset(CreateInjector(&module_));
+    factory_.reset(injector_->Get<TestTenantHandlerFactory*>());
+  }
+
+  TestEmptyModule module_;
+  scoped_ptr<Injector> injector_;
+  scoped_ptr<TestTenantHandlerFactory> factory_;
+};
+
+TEST_F(GuicppMemoizingFactoryTest, ReturnsCachedObjectForSameArguments) {
+  TestTenantHandler* handler = factory_->Get("first", 1).get();
+  EXPECT_EQ("first", handler->tenant());
+  EXPECT_EQ(1, handler->shard());
+
+  EXPECT_EQ(handler, factory_->Get("first", 1).get());
+  EXPECT_NE(handler, factory_->Get("first", 2).get());
+  EXPECT_EQ(2, TestTenantHandler::num_alive);
+
+  internal::LruCacheStats stats = factory_->stats();
+  EXPECT_EQ(1, stats.num_hits);
+  EXPECT_EQ(2, stats.num_misses);
+  EXPECT_EQ(0, stats.num_evictions);
+}
+
+TEST_F(GuicppMemoizingFactoryTest, EvictsLeastRecentlyUsedObject) {
+  TestTenantHandler* first = factory_->Get("first", 1).get();
+  factory_->Get("second", 1);
+
+  // "first" is used more recently than "second", hence "second" is evicted
+  // (and deleted, as no caller holds it) to make room for "third".
+  EXPECT_EQ(first, factory_->Get("first", 1).get());
+  factory_->Get("third", 1);
+  EXPECT_EQ(2, TestTenantHandler::num_alive);
+  EXPECT_EQ(1, factory_->stats().num_evictions);
+
+  EXPECT_EQ(first, factory_->Get("first", 1).get());
+}
+
+TEST_F(GuicppMemoizingFactoryTest, EvictedObjectLivesWhileCallerHoldsIt) {
+  TestTenantHandlerRef first = factory_->Get("first", 1);
+  factory_->Get("second", 1);
+  factory_->Get("third", 1);
+  EXPECT_EQ(1, factory_->stats().num_evictions);
+  EXPECT_EQ(3, TestTenantHandler::num_alive);
+  EXPECT_EQ("first", first->tenant());
+
+  // A new object is created for "first" once it is evicted.
+  EXPECT_NE(first.get(), factory_->Get("first", 1).get());
+}
+
+TEST_F(GuicppMemoizingFactoryTest, CachedObjectsAreDeletedWithFactory) {
+  factory_->Get("first", 1);
+  factory_->Get("second", 1);
+  EXPECT_EQ(2, TestTenantHandler::num_alive);
+
+  factory_.reset();
+  EXPECT_EQ(0, TestTenantHandler::num_alive);
+}
+
+TEST_F(GuicppMemoizingFactoryTest, SharedFactoryKeepsOneCache) {
+  const TestTenantHandlerFactory& factory =
+      injector_->Get<const TestTenantHandlerFactory&>();
+  TestTenantHandler* handler = factory.Get("first", 1).get();
+
+  EXPECT_EQ(handler, injector_->Get<const TestTenantHandlerFactory&>().Get(
+      "first", 1).get());
+  EXPECT_EQ(1, factory.stats().num_hits);
+}
+
+// A value inserted for a key that already has one (as after two threads
+// missed the key) is left to the caller, and the cached one is returned.
+TEST(LruCacheTest, Insert_ReturnsExistingValueAndLeavesDuplicateToCaller) {
+  TestTenantHandler::num_alive = 0;
+  {
+    internal::LruCache<int, TestTenantHandlerRef> cache(2);
+    TestTenantHandlerRef cached(new TestTenantHandler("first", 1));
+    TestTenantHandlerRef duplicate(new TestTenantHandler("first", 1));
+    EXPECT_EQ(cached.get(), cache.Insert(1, cached).get());
+
+    EXPECT_EQ(cached.get(), cache.Insert(1, duplicate).get());
+    EXPECT_EQ("first", duplicate->tenant());
+    EXPECT_EQ(2, TestTenantHandler::num_alive);
+  }
+  EXPECT_EQ(0, TestTenantHandler::num_alive);
+}
+
+// A large cache is split into shards, each evicting its own least recently
+// used values, hence the cache holds at most its capacity.
+TEST(LruCacheTest, ShardedCacheStaysWithinCapacity) {
+  const int kCapacity = 1024;
+  internal::LruCache<std::pair<int, int>, int> cache(kCapacity);
+  for (int i = 0; i < 4 * kCapacity; ++i) {
+    EXPECT_EQ(i, cache.Insert(std::make_pair(i, 0), i));
+  }
+
+  int num_cached = 0;
+  for (int i = 0; i < 4 * kCapacity; ++i) {
+    int value = -1;
+    if (cache.Lookup(std::make_pair(i, 0), &value)) {
+      EXPECT_EQ(i, value);
+      ++num_cached;
+    }
+  }
+
+  EXPECT_EQ(kCapacity, num_cached);
+  internal::LruCacheStats stats = cache.stats();
+  EXPECT_EQ(kCapacity, stats.num_hits);
+  EXPECT_EQ(3 * kCapacity, stats.num_misses);
+  EXPECT_EQ(3 * kCapacity, stats.num_evictions);
+
+  // The most recently inserted key of each shard is cached.
+  int value = -1;
+  EXPECT_TRUE(cache.Lookup(std::make_pair(4 * kCapacity - 1, 0), &value));
+}
+
+}  // namespace guicpp
@@ -0,0 +1,282 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// Tests for Binder::AddToSet() and Binder::AddToMap().
+
+#include "guicpp/guicpp_multibinder.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "include/gmock/gmock.h"
+#include "include/gtest/gtest.h"
+#include "guicpp/internal/guicpp_port.h"
+#include "guicpp/guicpp_binder.h"
+#include "guicpp/guicpp_factory.h"
+#include "guicpp/guicpp_injector.h"
+#include "guicpp/guicpp_module.h"
+#include "guicpp/guicpp_singleton.h"
+#include "guicpp/guicpp_strings.h"
+#include "include/guicpp_test_helper.h"
+#include "guicpp/guicpp_tools.h"
+
+namespace guicpp {
+using guicpp_test::TestBaseClass;
+using guicpp_test::TestClassWithDeleteMarker;
+using guicpp_test::TestDeleteMarker;
+using guicpp_test::TestInjectableSubClass;
+using guicpp_test::TestLabelOne;
+using guicpp_test::TestLabelTwo;
+using guicpp_test::TestSimpleAssistedArgumentUser;
+using guicpp_test::TestSimpleInjectableClass;
+using testing::ElementsAre;
+
+typedef std::vector<TestBaseClass*> TestBaseClassSet;
+typedef std::map<string, TestBaseClass*> TestBaseClassMap;
+
+// Takes the set and map of TestBaseClass.
+class TestMultibindingUser {
+ public:
+  TestMultibindingUser(const TestBaseClassSet& objects_set,
+                       const TestBaseClassMap& objects_map)
+      : objects_set_(objects_set), objects_map_(objects_map) {}
+
+  const TestBaseClassSet& objects_set() const { return objects_set_; }
+  const TestBaseClassMap& objects_map() const { return objects_map_; }
+
+ private:
+  const TestBaseClassSet& objects_set_;
+  const TestBaseClassMap& objects_map_;
+};
+
+GUICPP_INJECT_CTOR(TestMultibindingUser, (
+    const TestBaseClassSet& objects_set,
+    const TestBaseClassMap& objects_map));
+
+GUICPP_DEFINE(TestMultibindingUser);
+
+class TestMultibindingModule: public Module {
+ public:
+  void Configure(Binder* binder) const {
+    binder->AddToSet<TestBaseClass, TestSimpleInjectableClass>();
+    binder->AddToSet<TestBaseClass, TestInjectableSubClass>();
+
+    binder->AddToMap<string, TestBaseClass, TestInjectableSubClass>("sub");
+    binder->AddToMap<string, TestBaseClass, TestSimpleInjectableClass>(
+        "simple");
+
+    binder->AddToSet<At<TestLabelOne, TestBaseClass>,
+                     TestInjectableSubClass>();
+  }
+};
+
+// Matches TestBaseClass* whose GetClassName() returns "name".
+MATCHER_P(HasClassName, name, "") {
+  return arg->GetClassName() == name;
+}
+
+TEST(GuicppMultibinderTest, SetHasElementsInOrderOfAddition) {
+  TestMultibindingModule module;
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+
+  const TestBaseClassSet& objects_set =
+      injector->Get<const TestBaseClassSet&>();
+  EXPECT_THAT(objects_set, ElementsAre(
+      HasClassName("TestSimpleInjectableClass"),
+      HasClassName("TestInjectableSubClass")));
+
+  // Successive requests get the same instances.
+  EXPECT_EQ(&objects_set, &injector->Get<const TestBaseClassSet&>());
+}
+
+TEST(GuicppMultibinderTest, AnnotatedSetIsSeparate) {
+  TestMultibindingModule module;
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+
+  const TestBaseClassSet& objects_set =
+      injector->Get<At<TestLabelOne, const TestBaseClassSet&> >();
+  EXPECT_THAT(objects_set, ElementsAre(HasClassName("TestInjectableSubClass")));
+}
+
+TEST(GuicppMultibinderTest, MapHasElementForEachKey) {
+  TestMultibindingModule module;
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+
+  const TestBaseClassMap& objects_map =
+      injector->Get<const TestBaseClassMap&>();
+  ASSERT_EQ(2, objects_map.size());
+  EXPECT_EQ("TestSimpleInjectableClass",
+            objects_map.find("simple")->second->GetClassName());
+  EXPECT_EQ("TestInjectableSubClass",
+            objects_map.find("sub")->second->GetClassName());
+}
+
+TEST(GuicppMultibinderTest, CollectionsAreInjected) {
+  TestMultibindingModule module;
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+
+  scoped_ptr<TestMultibindingUser> user(
+      injector->Get<TestMultibindingUser*>());
+  EXPECT_EQ(&injector->Get<const TestBaseClassSet&>(), &user->objects_set());
+  EXPECT_EQ(&injector->Get<const TestBaseClassMap&>(), &user->objects_map());
+}
+
+class TestBoundElementModule: public Module {
+ public:
+  explicit TestBoundElementModule(TestClassWithDeleteMarker* bound_object)
+      : bound_object_(bound_object) {}
+
+  void Configure(Binder* binder) const {
+    binder->BindToInstance<At<TestLabelOne, TestClassWithDeleteMarker> >(
+        bound_object_, DeletePointer());
+    binder->AddToSet<TestBaseClass, At<TestLabelOne,
+                                       TestClassWithDeleteMarker> >();
+    binder->AddToSet<TestBaseClass, TestClassWithDeleteMarker>();
+  }
+
+ private:
+  TestClassWithDeleteMarker* bound_object_;
+};
+
+TEST(GuicppMultibinderTest, BoundImplementationIsDeletedOnlyByItsBinding) {
+  TestDeleteMarker delete_marker;
+  TestClassWithDeleteMarker* bound_object = new TestClassWithDeleteMarker();
+  bound_object->SetDeleteMarker(&delete_marker);
+  EXPECT_CALL(delete_marker, Call(bound_object)).Times(1);
+
+  TestBoundElementModule module(bound_object);
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+
+  const TestBaseClassSet& objects_set =
+      injector->Get<const TestBaseClassSet&>();
+  ASSERT_EQ(2, objects_set.size());
+  EXPECT_EQ(bound_object, objects_set[0]);
+  EXPECT_NE(bound_object, objects_set[1]);
+
+  // Deletes the bound instance once, and the one created for the set.
+  injector.reset();
+}
+
+class TestTypeBoundElementModule: public Module {
+ public:
+  void Configure(Binder* binder) const {
+    binder->Bind<At<TestLabelOne, TestBaseClass>,
+                 TestClassWithDeleteMarker>();
+    binder->AddToSet<TestBaseClass, At<TestLabelOne, TestBaseClass> >();
+
+    // Bound to a singleton through Bind().
+    binder->BindToScope<At<TestLabelOne, TestClassWithDeleteMarker>,
+                        LazySingleton>();
+    binder->Bind<At<TestLabelTwo, TestBaseClass>,
+                 At<TestLabelOne, TestClassWithDeleteMarker> >();
+    binder->AddToSet<TestBaseClass, At<TestLabelTwo, TestBaseClass> >();
+  }
+};
+
+TEST(GuicppMultibinderTest, TypeBoundImplementationIsDeletedUnlessStable) {
+  TestTypeBoundElementModule module;
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+
+  TestClassWithDeleteMarker* singleton =
+      injector->Get<At<TestLabelOne, TestClassWithDeleteMarker*> >();
+  const TestBaseClassSet& objects_set =
+      injector->Get<const TestBaseClassSet&>();
+  ASSERT_EQ(2, objects_set.size());
+  EXPECT_NE(singleton, objects_set[0]);
+  EXPECT_EQ(singleton, objects_set[1]);
+
+  TestDeleteMarker delete_marker;
+  TestClassWithDeleteMarker* created_object =
+      static_cast<TestClassWithDeleteMarker*>(objects_set[0]);
+  created_object->SetDeleteMarker(&delete_marker);
+  singleton->SetDeleteMarker(&delete_marker);
+  EXPECT_CALL(delete_marker, Call(created_object)).Times(1);
+  EXPECT_CALL(delete_marker, Call(singleton)).Times(1);
+
+  // Deletes the instance created for the set, and the singleton once.
+  injector.reset();
+}
+
+class TestDuplicateKeyModule: public Module {
+ public:
+  void Configure(Binder* binder) const {
+    binder->AddToMap<string, TestBaseClass, TestInjectableSubClass>("key");
+    binder->AddToMap<string, TestBaseClass, TestSimpleInjectableClass>("key");
+  }
+};
+
+TEST(GuicppMultibinderDeathTest, DuplicateKeyIsAnError) {
+  TestDuplicateKeyModule module;
+  EXPECT_DEATH(Injector::Create(&module),
+               "Key is already added to map");
+}
+
+class TestSetAlreadyBoundModule: public Module {
+ public:
+  void Configure(Binder* binder) const {
+    binder->BindToInstance<const TestBaseClassSet>(
+        new TestBaseClassSet(), DeletePointer());
+    binder->AddToSet<TestBaseClass, TestInjectableSubClass>();
+  }
+};
+
+TEST(GuicppMultibinderDeathTest, AddToSetOfBoundTypeIsAnError) {
+  TestSetAlreadyBoundModule module;
+  EXPECT_DEATH(Injector::Create(&module),
+               "not using AddToSet\\(\\)/AddToMap\\(\\)");
+}
+
+typedef std::vector<TestSimpleAssistedArgumentUser*> TestAssistedUserSet;
+
+// Takes a set whose elements need an assisted argument of the same type as
+// its own assisted argument.
+class TestAssistedSetUser {
+ public:
+  TestAssistedSetUser(const TestAssistedUserSet& users,
+                      TestSimpleInjectableClass* simple_object) {}
+};
+
+GUICPP_INJECT_CTOR(TestAssistedSetUser, (
+    const TestAssistedUserSet& users,
+    At<Assisted, TestSimpleInjectableClass*> simple_object));
+
+GUICPP_DEFINE(TestAssistedSetUser);
+
+class TestAssistedSetUserFactory: public Factory<
+      TestAssistedSetUser* (TestSimpleInjectableClass* simple_object)> {};
+
+class TestAssistedElementModule: public Module {
+ public:
+  void Configure(Binder* binder) const {
+    binder->AddToSet<TestSimpleAssistedArgumentUser,
+                     TestSimpleAssistedArgumentUser>();
+  }
+};
+
+TEST(GuicppMultibinderDeathTest, ElementsDoNotSeeArgumentsOfFirstRequester) {
+  TestAssistedElementModule module;
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+  scoped_ptr<TestAssistedSetUserFactory> factory(
+      injector->Get<TestAssistedSetUserFactory*>());
+
+  // The set is shared by all requesters, hence its elements are not created
+  // with the factory arguments of the one that requests it first.
+  TestSimpleInjectableClass simple_object(0);
+  EXPECT_DEATH(factory->Get(&simple_object), "Expected assisted argument");
+}
+
+}  // namespace guicpp
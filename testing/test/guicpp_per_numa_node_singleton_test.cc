@@ -0,0 +1,312 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Tests for PerNumaNodeSingleton scope.
+
+#include "guicpp/guicpp_per_numa_node_singleton.h"
+
+#include <string>
+#include <vector>
+
+#include "include/gmock/gmock.h"
+#include "include/gtest/gtest.h"
+#include "guicpp/internal/guicpp_port.h"
+#include "guicpp/guicpp_annotations.h"
+#include "guicpp/guicpp_at.h"
+#include "guicpp/guicpp_binder.h"
+#include "guicpp/guicpp_injector.h"
+#include "guicpp/guicpp_module.h"
+#include "include/guicpp_test_helper.h"
+#include "guicpp/guicpp_tools.h"
+
+namespace guicpp {
+
+// Counts the instances alive.
+class TestReplicatedClass {
+ public:
+  TestReplicatedClass() {
+    ++num_alive;
+  }
+
+  virtual ~TestReplicatedClass() {
+    --num_alive;
+  }
+
+  static int num_alive;
+};
+
+int TestReplicatedClass::num_alive = 0;
+
+GUICPP_INJECT_CTOR(TestReplicatedClass, ());
+GUICPP_DEFINE(TestReplicatedClass);
+
+// Topology whose current node is set by the test. Counts the allocations
+// of each node and remembers the last one.
+class TestNumaTopology: public NumaTopology {
+ public:
+  explicit TestNumaTopology(int num_nodes)
+      : num_nodes_(num_nodes), current_node_(0),
+        num_allocated_(num_nodes, 0),
+        last_allocated_(num_nodes, static_cast<char*>(NULL)),
+        last_allocated_size_(num_nodes, 0) {}
+
+  int GetNumNodes() const { return num_nodes_; }
+  int GetCurrentNode() const { return current_node_; }
+
+  void* AllocateOnNode(size_t size, int node) const {
+    ++num_allocated_[node];
+    void* memory = NumaTopology::AllocateOnNode(size, node);
+    last_allocated_[node] = static_cast<char*>(memory);
+    last_allocated_size_[node] = size;
+    return memory;
+  }
+
+  void FreeOnNode(void* memory, size_t size, int node) const {
+    --num_allocated_[node];
+    NumaTopology::FreeOnNode(memory, size, node);
+  }
+
+  void set_current_node(int node) { current_node_ = node; }
+
+  // Number of allocations on "node" that are not freed.
+  int num_allocated(int node) const { return num_allocated_[node]; }
+
+  // Returns true if "object" is in the last allocation on "node".
+  template <typename T>
+  bool IsInLastAllocation(const T* object, int node) const {
+    const char* begin = reinterpret_cast<const char*>(object);
+    return begin >= last_allocated_[node] &&
+        begin + sizeof(T) <= last_allocated_[node] + last_allocated_size_[node];
+  }
+
+ private:
+  const int num_nodes_;
+  int current_node_;
+  mutable std::vector<int> num_allocated_;
+  mutable std::vector<char*> last_allocated_;
+  mutable std::vector<size_t> last_allocated_size_;
+};
+
+// Counts the messages logged.
+class TestCountingLogSink: public internal::LogSink {
+ public:
+  TestCountingLogSink(): num_messages_(0) {}
+
+  void Send(internal::GuicppLogSeverity severity,
+            const std::string& message) {
+    ++num_messages_;
+  }
+
+  void Flush() {}
+
+  int num_messages() const { return num_messages_; }
+
+ private:
+  int num_messages_;
+};
+
+class TestPerNumaNodeModule: public Module {
+ public:
+  explicit TestPerNumaNodeModule(TestNumaTopology* topology)
+      : topology_(topology) {}
+
+  void Configure(Binder* binder) const {
+    if (topology_ != NULL) {
+      binder->BindToInstance<NumaTopology>(topology_, DoNothing());
+    }
+
+    binder->BindToScope<TestReplicatedClass, PerNumaNodeSingleton>();
+  }
+
+ private:
+  TestNumaTopology* topology_;
+};
+
+TEST(GuicppPerNumaNodeSingletonTest, WithoutTopologyIsSameAsLazySingleton) {
+  TestReplicatedClass::num_alive = 0;
+  TestPerNumaNodeModule module(NULL);
+  {
+    scoped_ptr<Injector> injector(CreateInjector(&module));
+    EXPECT_EQ(0, TestReplicatedClass::num_alive);
+
+    TestReplicatedClass* first = injector->Get<TestReplicatedClass*>();
+    EXPECT_EQ(first, injector->Get<TestReplicatedClass*>());
+    EXPECT_EQ(1, TestReplicatedClass::num_alive);
+  }
+
+  EXPECT_EQ(0, TestReplicatedClass::num_alive);
+}
+
+TEST(GuicppPerNumaNodeSingletonTest, ReturnsReplicaOfCurrentNode) {
+  TestReplicatedClass::num_alive = 0;
+  TestNumaTopology topology(2);
+  TestPerNumaNodeModule module(&topology);
+  {
+    scoped_ptr<Injector> injector(CreateInjector(&module));
+
+    topology.set_current_node(1);
+    TestReplicatedClass* replica1 = injector->Get<TestReplicatedClass*>();
+    EXPECT_EQ(1, TestReplicatedClass::num_alive);
+
+    topology.set_current_node(0);
+    TestReplicatedClass* replica0 = injector->Get<TestReplicatedClass*>();
+    EXPECT_NE(replica0, replica1);
+    EXPECT_EQ(replica0, injector->Get<TestReplicatedClass*>());
+
+    topology.set_current_node(1);
+    EXPECT_EQ(replica1, injector->Get<TestReplicatedClass*>());
+    EXPECT_EQ(2, TestReplicatedClass::num_alive);
+  }
+
+  EXPECT_EQ(0, TestReplicatedClass::num_alive);
+}
+
+TEST(GuicppPerNumaNodeSingletonTest, ReplicaIsCreatedOnlyForRequestingNodes) {
+  TestReplicatedClass::num_alive = 0;
+  TestNumaTopology topology(4);
+  TestPerNumaNodeModule module(&topology);
+  {
+    scoped_ptr<Injector> injector(CreateInjector(&module));
+
+    topology.set_current_node(3);
+    injector->Get<TestReplicatedClass*>();
+    injector->Get<TestReplicatedClass*>();
+    EXPECT_EQ(1, TestReplicatedClass::num_alive);
+  }
+
+  EXPECT_EQ(0, TestReplicatedClass::num_alive);
+}
+
+TEST(GuicppPerNumaNodeSingletonTest, ReplicasAreAllocatedOnTheirNodes) {
+  TestReplicatedClass::num_alive = 0;
+  TestNumaTopology topology(3);
+  TestPerNumaNodeModule module(&topology);
+  {
+    scoped_ptr<Injector> injector(CreateInjector(&module));
+    EXPECT_EQ(0, topology.num_allocated(0));
+
+    topology.set_current_node(2);
+    injector->Get<TestReplicatedClass*>();
+    for (int node = 0; node < 3; ++node) {
+      EXPECT_EQ(1, topology.num_allocated(node));
+    }
+  }
+
+  for (int node = 0; node < 3; ++node) {
+    EXPECT_EQ(0, topology.num_allocated(node));
+  }
+}
+
+TEST(GuicppPerNumaNodeSingletonTest, InstancesAreInMemoryOfTheirNodes) {
+  TestReplicatedClass::num_alive = 0;
+  TestNumaTopology topology(2);
+  TestPerNumaNodeModule module(&topology);
+  {
+    scoped_ptr<Injector> injector(CreateInjector(&module));
+
+    topology.set_current_node(0);
+    TestReplicatedClass* replica0 = injector->Get<TestReplicatedClass*>();
+    topology.set_current_node(1);
+    TestReplicatedClass* replica1 = injector->Get<TestReplicatedClass*>();
+
+    EXPECT_TRUE(topology.IsInLastAllocation(replica0, 0));
+    EXPECT_TRUE(topology.IsInLastAllocation(replica1, 1));
+    EXPECT_EQ(0, reinterpret_cast<size_t>(replica0) % internal::kCacheLineSize);
+    EXPECT_EQ(2, TestReplicatedClass::num_alive);
+  }
+
+  // Destroyed in place, before their memory is freed.
+  EXPECT_EQ(0, TestReplicatedClass::num_alive);
+  EXPECT_EQ(0, topology.num_allocated(0));
+}
+
+// Decorator of a replica: It does not own the decorated replica.
+class TestReplicaDecorator: public TestReplicatedClass {
+ public:
+  explicit TestReplicaDecorator(TestReplicatedClass* decorated)
+      : decorated_(decorated) {}
+
+  TestReplicatedClass* decorated() const { return decorated_; }
+
+ private:
+  TestReplicatedClass* decorated_;
+};
+
+GUICPP_INJECT_CTOR(TestReplicaDecorator,
+                   (At<Assisted, TestReplicatedClass*> decorated));
+GUICPP_DEFINE(TestReplicaDecorator);
+
+class TestDecoratedPerNumaNodeModule: public TestPerNumaNodeModule {
+ public:
+  explicit TestDecoratedPerNumaNodeModule(TestNumaTopology* topology)
+      : TestPerNumaNodeModule(topology) {}
+
+  void Configure(Binder* binder) const {
+    TestPerNumaNodeModule::Configure(binder);
+    binder->Decorate<TestReplicatedClass, TestReplicaDecorator>();
+  }
+};
+
+TEST(GuicppPerNumaNodeSingletonTest, EachReplicaIsDecoratedOnce) {
+  TestReplicatedClass::num_alive = 0;
+  TestNumaTopology topology(2);
+  TestDecoratedPerNumaNodeModule module(&topology);
+  {
+    scoped_ptr<Injector> injector(CreateInjector(&module));
+
+    topology.set_current_node(0);
+    TestReplicatedClass* decorator0 = injector->Get<TestReplicatedClass*>();
+    EXPECT_EQ(decorator0, injector->Get<TestReplicatedClass*>());
+
+    topology.set_current_node(1);
+    TestReplicatedClass* decorator1 = injector->Get<TestReplicatedClass*>();
+    EXPECT_NE(decorator0, decorator1);
+    EXPECT_EQ(decorator1, injector->Get<TestReplicatedClass*>());
+
+    topology.set_current_node(0);
+    EXPECT_EQ(decorator0, injector->Get<TestReplicatedClass*>());
+
+    EXPECT_TRUE(topology.IsInLastAllocation(
+        static_cast<TestReplicaDecorator*>(decorator0)->decorated(), 0));
+    EXPECT_TRUE(topology.IsInLastAllocation(
+        static_cast<TestReplicaDecorator*>(decorator1)->decorated(), 1));
+
+    // Two replicas and their decorators.
+    EXPECT_EQ(4, TestReplicatedClass::num_alive);
+  }
+
+  EXPECT_EQ(0, TestReplicatedClass::num_alive);
+}
+
+TEST(GuicppPerNumaNodeSingletonTest, InvalidNodeIsLoggedOnce) {
+  TestReplicatedClass::num_alive = 0;
+  TestNumaTopology topology(2);
+  TestPerNumaNodeModule module(&topology);
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+
+  topology.set_current_node(0);
+  TestReplicatedClass* replica0 = injector->Get<TestReplicatedClass*>();
+
+  TestCountingLogSink log_sink;
+  internal::LogSink* previous_sink = internal::SetLogSink(&log_sink);
+  topology.set_current_node(5);
+  EXPECT_EQ(replica0, injector->Get<TestReplicatedClass*>());
+  EXPECT_EQ(replica0, injector->Get<TestReplicatedClass*>());
+  internal::SetLogSink(previous_sink);
+
+  EXPECT_EQ(1, log_sink.num_messages());
+}
+
+}  // namespace guicpp
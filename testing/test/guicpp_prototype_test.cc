@@ -0,0 +1,176 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Tests for Prototype scope.
+
+#include "guicpp/guicpp_prototype.h"
+
+#include "include/gmock/gmock.h"
+#include "include/gtest/gtest.h"
+#include "guicpp/internal/guicpp_port.h"
+#include "guicpp/guicpp_binder.h"
+#include "guicpp/guicpp_injector.h"
+#include "guicpp/guicpp_module.h"
+#include "include/guicpp_test_helper.h"
+#include "guicpp/guicpp_tools.h"
+
+namespace guicpp {
+using guicpp_test::TestLabelOne;
+
+// Counts the instances created using the injected constructor, the copies
+// and the instances alive.
+class TestPrototypeClass {
+ public:
+  TestPrototypeClass(): value_(++num_constructed) {
+    ++num_alive;
+  }
+
+  TestPrototypeClass(const TestPrototypeClass& other): value_(other.value_) {
+    ++num_copied;
+    ++num_alive;
+  }
+
+  ~TestPrototypeClass() {
+    --num_alive;
+  }
+
+  int value() const { return value_; }
+
+  static void ResetCounts() {
+    num_constructed = 0;
+    num_copied = 0;
+    num_alive = 0;
+  }
+
+  static int num_constructed;
+  static int num_copied;
+  static int num_alive;
+
+ private:
+  const int value_;
+};
+
+int TestPrototypeClass::num_constructed = 0;
+int TestPrototypeClass::num_copied = 0;
+int TestPrototypeClass::num_alive = 0;
+
+GUICPP_INJECT_CTOR(TestPrototypeClass, ());
+GUICPP_DEFINE(TestPrototypeClass);
+
+class TestPrototypeInterface {
+ public:
+  virtual ~TestPrototypeInterface() {}
+  virtual string GetClassName() const = 0;
+};
+
+// A concrete class, which a copy of its subclass must not be sliced to.
+class TestPrototypeBase: public TestPrototypeInterface {
+ public:
+  TestPrototypeBase() {}
+  virtual string GetClassName() const { return "TestPrototypeBase"; }
+};
+
+class TestPrototypeImpl: public TestPrototypeBase {
+ public:
+  TestPrototypeImpl() {}
+  virtual string GetClassName() const { return "TestPrototypeImpl"; }
+};
+
+GUICPP_INJECTABLE(TestPrototypeInterface);
+GUICPP_INJECTABLE(TestPrototypeBase);
+GUICPP_INJECT_CTOR(TestPrototypeImpl, ());
+GUICPP_DEFINE(TestPrototypeImpl);
+
+class TestPrototypeModule: public Module {
+ public:
+  void Configure(Binder* binder) const {
+    binder->BindToScope<TestPrototypeClass, Prototype>();
+    binder->BindToScope<At<TestLabelOne, TestPrototypeClass>, Prototype>();
+  }
+};
+
+class TestPrototypeInterfaceModule: public Module {
+ public:
+  void Configure(Binder* binder) const {
+    binder->BindToScope<TestPrototypeInterface,
+                        PrototypeOf<TestPrototypeImpl> >();
+    binder->Bind<TestPrototypeBase, TestPrototypeImpl>();
+    binder->BindToScope<TestPrototypeImpl, Prototype>();
+  }
+};
+
+TEST(GuicppPrototypeTest, GraphIsCreatedOnceAndCopiedOnEveryRequest) {
+  TestPrototypeClass::ResetCounts();
+  TestPrototypeModule module;
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+  EXPECT_EQ(0, TestPrototypeClass::num_constructed);
+
+  scoped_ptr<TestPrototypeClass> first(
+      injector->Get<TestPrototypeClass*>());
+  scoped_ptr<TestPrototypeClass> second(
+      injector->Get<TestPrototypeClass*>());
+
+  EXPECT_NE(first.get(), second.get());
+  EXPECT_EQ(first->value(), second->value());
+  EXPECT_EQ(1, TestPrototypeClass::num_constructed);
+  EXPECT_EQ(2, TestPrototypeClass::num_copied);
+}
+
+TEST(GuicppPrototypeTest, EachLabelHasItsOwnPrototype) {
+  TestPrototypeClass::ResetCounts();
+  TestPrototypeModule module;
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+
+  scoped_ptr<TestPrototypeClass> unlabeled(
+      injector->Get<TestPrototypeClass*>());
+  scoped_ptr<TestPrototypeClass> labeled(
+      injector->Get<At<TestLabelOne, TestPrototypeClass*> >());
+
+  EXPECT_NE(unlabeled->value(), labeled->value());
+  EXPECT_EQ(2, TestPrototypeClass::num_constructed);
+}
+
+TEST(GuicppPrototypeTest, PrototypeIsDeletedWithInjector) {
+  TestPrototypeClass::ResetCounts();
+  TestPrototypeModule module;
+  scoped_ptr<TestPrototypeClass> copy;
+  {
+    scoped_ptr<Injector> injector(CreateInjector(&module));
+    copy.reset(injector->Get<TestPrototypeClass*>());
+    EXPECT_EQ(2, TestPrototypeClass::num_alive);
+  }
+
+  // Only the copy owned by the caller is alive.
+  EXPECT_EQ(1, TestPrototypeClass::num_alive);
+}
+
+TEST(GuicppPrototypeTest, InterfaceIsCopiedAsBoundImplementation) {
+  TestPrototypeInterfaceModule module;
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+
+  scoped_ptr<TestPrototypeInterface> first(
+      injector->Get<TestPrototypeInterface*>());
+  scoped_ptr<TestPrototypeInterface> second(
+      injector->Get<TestPrototypeInterface*>());
+  EXPECT_NE(first.get(), second.get());
+  EXPECT_EQ("TestPrototypeImpl", second->GetClassName());
+
+  // Nor is the copy of the implementation a concrete base class is bound
+  // to.
+  scoped_ptr<TestPrototypeBase> object(injector->Get<TestPrototypeBase*>());
+  EXPECT_EQ("TestPrototypeImpl", object->GetClassName());
+}
+
+}  // namespace guicpp
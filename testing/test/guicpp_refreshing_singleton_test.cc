@@ -0,0 +1,238 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Tests for RefreshingSingleton and SingletonRefresher.
+
+#include "guicpp/guicpp_refreshing_singleton.h"
+
+#include <vector>
+
+#include "include/gmock/gmock.h"
+#include "include/gtest/gtest.h"
+#include "guicpp/internal/guicpp_port.h"
+#include "guicpp/guicpp_binder.h"
+#include "guicpp/guicpp_executor.h"
+#include "guicpp/guicpp_injector.h"
+#include "guicpp/guicpp_module.h"
+#include "guicpp/guicpp_swappable_instance.h"
+#include "include/guicpp_test_helper.h"
+#include "guicpp/guicpp_tools.h"
+
+namespace guicpp {
+
+// Counts the instances created and the instances alive.
+class TestRefreshedClass {
+ public:
+  TestRefreshedClass() {
+    ++num_created;
+    ++num_alive;
+  }
+
+  ~TestRefreshedClass() {
+    --num_alive;
+  }
+
+  static int num_created;
+  static int num_alive;
+};
+
+int TestRefreshedClass::num_created = 0;
+int TestRefreshedClass::num_alive = 0;
+
+GUICPP_INJECT_CTOR(TestRefreshedClass, ());
+GUICPP_DEFINE(TestRefreshedClass);
+
+typedef SwappableRef<TestRefreshedClass> TestRefreshedRef;
+
+class TestRefreshingModule: public Module {
+ public:
+  void Configure(Binder* binder) const {
+    binder->BindToScope<TestRefreshedClass, RefreshingSingleton>();
+  }
+};
+
+class GuicppRefreshingSingletonTest: public testing::Test {
+ protected:
+  void SetUp() {
+    TestRefreshedClass::num_created = 0;
+    TestRefreshedClass::num_alive = 0;
+  }
+};
+
+TEST_F(GuicppRefreshingSingletonTest, ReturnsSameObjectUntilRefresh) {
+  TestRefreshingModule module;
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+
+  TestRefreshedRef first = injector->Get<TestRefreshedRef>();
+  EXPECT_EQ(first.get(), injector->Get<TestRefreshedRef>().get());
+
+  injector->Get<SingletonRefresher*>()->Refresh();
+
+  TestRefreshedRef second = injector->Get<TestRefreshedRef>();
+  EXPECT_NE(first.get(), second.get());
+  EXPECT_EQ(second.get(), injector->Get<TestRefreshedRef>().get());
+  EXPECT_EQ(2, TestRefreshedClass::num_created);
+}
+
+TEST_F(GuicppRefreshingSingletonTest, ReplacedObjectIsDeletedWithLastRef) {
+  TestRefreshingModule module;
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+  SingletonRefresher* refresher = injector->Get<SingletonRefresher*>();
+
+  // Replaced objects that no reader holds are deleted on refresh.
+  injector->Get<TestRefreshedRef>();
+  refresher->Refresh();
+  refresher->Refresh();
+  EXPECT_EQ(3, TestRefreshedClass::num_created);
+  EXPECT_EQ(1, TestRefreshedClass::num_alive);
+
+  injector.reset();
+  EXPECT_EQ(0, TestRefreshedClass::num_alive);
+}
+
+TEST_F(GuicppRefreshingSingletonTest, HeldObjectSurvivesRefreshes) {
+  TestRefreshingModule module;
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+  SingletonRefresher* refresher = injector->Get<SingletonRefresher*>();
+
+  TestRefreshedRef held = injector->Get<TestRefreshedRef>();
+  for (int i = 0; i < 5; ++i) {
+    refresher->Refresh();
+  }
+
+  // Only the held object and the current one are alive.
+  EXPECT_EQ(6, TestRefreshedClass::num_created);
+  EXPECT_EQ(2, TestRefreshedClass::num_alive);
+  EXPECT_NE(held.get(), injector->Get<TestRefreshedRef>().get());
+
+  held = TestRefreshedRef();
+  EXPECT_EQ(1, TestRefreshedClass::num_alive);
+}
+
+TEST_F(GuicppRefreshingSingletonTest, HeldObjectOutlivesInjector) {
+  TestRefreshingModule module;
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+
+  TestRefreshedRef held = injector->Get<TestRefreshedRef>();
+  injector.reset();
+  EXPECT_EQ(1, TestRefreshedClass::num_alive);
+
+  held = TestRefreshedRef();
+  EXPECT_EQ(0, TestRefreshedClass::num_alive);
+}
+
+class TestRefreshingWithPeriodModule: public Module {
+ public:
+  void Configure(Binder* binder) const {
+    binder->BindToScope<TestRefreshedClass,
+                        RefreshingSingletonWithPeriod<3600> >();
+  }
+};
+
+TEST_F(GuicppRefreshingSingletonTest, RefreshSkipsObjectWithinPeriod) {
+  TestRefreshingWithPeriodModule module;
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+
+  TestRefreshedRef first = injector->Get<TestRefreshedRef>();
+  injector->Get<SingletonRefresher*>()->Refresh();
+
+  EXPECT_EQ(first.get(), injector->Get<TestRefreshedRef>().get());
+  EXPECT_EQ(1, TestRefreshedClass::num_created);
+}
+
+TEST_F(GuicppRefreshingSingletonTest, RefreshDoesNotCreateUnrequestedObject) {
+  TestRefreshingModule module;
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+
+  injector->Get<SingletonRefresher*>()->Refresh();
+  EXPECT_EQ(0, TestRefreshedClass::num_created);
+
+  injector->Get<TestRefreshedRef>();
+  EXPECT_EQ(1, TestRefreshedClass::num_created);
+}
+
+// Executor that queues the closures until RunAll() is called.
+class TestQueueExecutor: public Executor {
+ public:
+  TestQueueExecutor() {}
+
+  ~TestQueueExecutor() {
+    EXPECT_TRUE(closures_.empty()) << "Closures are never run";
+  }
+
+  void Schedule(Closure* closure) {
+    closures_.push_back(closure);
+  }
+
+  void RunAll() {
+    for (size_t i = 0; i < closures_.size(); ++i) {
+      closures_[i]->Run();
+      delete closures_[i];
+    }
+
+    closures_.clear();
+  }
+
+ private:
+  std::vector<Closure*> closures_;
+};
+
+class TestRefreshingWithExecutorModule: public Module {
+ public:
+  explicit TestRefreshingWithExecutorModule(TestQueueExecutor* executor)
+      : executor_(executor) {}
+
+  void Configure(Binder* binder) const {
+    binder->BindToInstance<At<RefreshExecutor, Executor> >(
+        executor_, DoNothing());
+    binder->Install(&refreshing_module_);
+  }
+
+ private:
+  TestRefreshingModule refreshing_module_;
+  TestQueueExecutor* executor_;
+};
+
+TEST_F(GuicppRefreshingSingletonTest, RebuildsOnBoundExecutor) {
+  TestQueueExecutor executor;
+  TestRefreshingWithExecutorModule module(&executor);
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+
+  TestRefreshedRef first = injector->Get<TestRefreshedRef>();
+  injector->Get<SingletonRefresher*>()->Refresh();
+
+  // The current object is returned until the executor runs the rebuild.
+  EXPECT_EQ(first.get(), injector->Get<TestRefreshedRef>().get());
+
+  executor.RunAll();
+  EXPECT_NE(first.get(), injector->Get<TestRefreshedRef>().get());
+}
+
+TEST_F(GuicppRefreshingSingletonTest, RebuildAfterDeletionDoesNothing) {
+  TestQueueExecutor executor;
+  TestRefreshingWithExecutorModule module(&executor);
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+
+  injector->Get<TestRefreshedRef>();
+  injector->Get<SingletonRefresher*>()->Refresh();
+  injector.reset();
+  EXPECT_EQ(0, TestRefreshedClass::num_alive);
+
+  executor.RunAll();
+  EXPECT_EQ(1, TestRefreshedClass::num_created);
+  EXPECT_EQ(0, TestRefreshedClass::num_alive);
+}
+
+}  // namespace guicpp
@@ -0,0 +1,216 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Tests for AbstractScopeProvider and Binder::BindToScopeProvider().
+
+#include "guicpp/guicpp_scope.h"
+
+#include <vector>
+
+#include "include/gmock/gmock.h"
+#include "include/gtest/gtest.h"
+#include "guicpp/internal/guicpp_port.h"
+#include "guicpp/guicpp_binder.h"
+#include "guicpp/guicpp_injector.h"
+#include "guicpp/guicpp_module.h"
+#include "include/guicpp_test_helper.h"
+#include "guicpp/guicpp_tools.h"
+
+namespace guicpp {
+using guicpp_test::TestLabelOne;
+
+// Counts the instances alive.
+class TestScopedClass {
+ public:
+  TestScopedClass() {
+    ++num_alive;
+  }
+
+  ~TestScopedClass() {
+    --num_alive;
+  }
+
+  static int num_alive;
+};
+
+int TestScopedClass::num_alive = 0;
+
+GUICPP_INJECT_CTOR(TestScopedClass, ());
+GUICPP_DEFINE(TestScopedClass);
+
+// Scope that keeps one instance per injector in the slot owned by the
+// injector. Records the slots used, to test their layout.
+template <typename T>
+class TestSlotProvider: public AbstractScopeProvider<T> {
+ public:
+  T* Get() {
+    ScopeSlot* slot = this->slot();
+    if (slot->value() == NULL) {
+      slot->set_value(this->CreateUnscoped());
+      this->AddToCleanupList();
+      slots_used.push_back(slot);
+    }
+
+    return static_cast<T*>(slot->value());
+  }
+
+  void Cleanup() {
+    delete static_cast<T*>(this->slot()->value());
+    this->slot()->set_value(NULL);
+  }
+
+  static std::vector<ScopeSlot*> slots_used;
+};
+
+template <typename T>
+std::vector<ScopeSlot*> TestSlotProvider<T>::slots_used;
+
+class TestSlotScope {
+ public:
+  template <typename L, typename T>
+  static void ConfigureScope(Binder* binder) {
+    binder->BindToScopeProvider<At<L, T> >(new TestSlotProvider<T>());
+  }
+};
+
+// Scope that keeps the instances in the current session, a vector indexed by
+// slot index. The instances are owned by the session.
+class TestSession {
+ public:
+  ~TestSession() {
+    for (size_t i = 0; i < instances_.size(); ++i) {
+      delete static_cast<TestScopedClass*>(instances_[i]);
+    }
+  }
+
+  void*& Slot(int index, int num_slots) {
+    if (instances_.size() < static_cast<size_t>(num_slots)) {
+      instances_.resize(num_slots, NULL);
+    }
+
+    return instances_[index];
+  }
+
+  size_t size() const { return instances_.size(); }
+
+  static TestSession* current;
+
+ private:
+  std::vector<void*> instances_;
+};
+
+TestSession* TestSession::current = NULL;
+
+template <typename T>
+class TestPerSessionProvider: public AbstractScopeProvider<T> {
+ public:
+  T* Get() {
+    void*& instance =
+        TestSession::current->Slot(this->slot_index(), this->num_slots());
+    if (instance == NULL) {
+      instance = this->CreateUnscoped();
+    }
+
+    return static_cast<T*>(instance);
+  }
+};
+
+class TestPerSession {
+ public:
+  template <typename L, typename T>
+  static void ConfigureScope(Binder* binder) {
+    binder->BindToScopeProvider<At<L, T> >(new TestPerSessionProvider<T>());
+  }
+};
+
+class TestSlotScopeModule: public Module {
+ public:
+  void Configure(Binder* binder) const {
+    binder->BindToScope<TestScopedClass, TestSlotScope>();
+    binder->BindToScope<At<TestLabelOne, TestScopedClass>, TestSlotScope>();
+  }
+};
+
+TEST(GuicppScopeTest, SlotScopeReturnsSameInstanceUntilInjectorIsDeleted) {
+  TestScopedClass::num_alive = 0;
+  TestSlotScopeModule module;
+  {
+    scoped_ptr<Injector> injector(CreateInjector(&module));
+    TestScopedClass* first = injector->Get<TestScopedClass*>();
+    EXPECT_EQ(first, injector->Get<TestScopedClass*>());
+    EXPECT_NE(first, (injector->Get<At<TestLabelOne, TestScopedClass*> >()));
+    EXPECT_EQ(2, TestScopedClass::num_alive);
+  }
+
+  EXPECT_EQ(0, TestScopedClass::num_alive);
+}
+
+TEST(GuicppScopeTest, SlotsAreOnSeparateCacheLines) {
+  std::vector<ScopeSlot*>& slots =
+      TestSlotProvider<TestScopedClass>::slots_used;
+  slots.clear();
+
+  TestSlotScopeModule module;
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+  injector->Get<TestScopedClass*>();
+  injector->Get<At<TestLabelOne, TestScopedClass*> >();
+
+  ASSERT_EQ(2U, slots.size());
+  for (size_t i = 0; i < slots.size(); ++i) {
+    EXPECT_EQ(0U, reinterpret_cast<size_t>(slots[i]) %
+              internal::kCacheLineSize);
+  }
+
+  // Slots are allocated contiguously, in order of binding.
+  EXPECT_EQ(reinterpret_cast<char*>(slots[0]) + internal::kCacheLineSize,
+            reinterpret_cast<char*>(slots[1]));
+}
+
+class TestPerSessionModule: public Module {
+ public:
+  void Configure(Binder* binder) const {
+    binder->BindToScope<TestScopedClass, TestPerSession>();
+    binder->BindToScope<At<TestLabelOne, TestScopedClass>, TestPerSession>();
+  }
+};
+
+TEST(GuicppScopeTest, PerSessionScopeUsesDenseSlotIndices) {
+  TestScopedClass::num_alive = 0;
+  TestPerSessionModule module;
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+
+  {
+    TestSession first_session;
+    TestSession second_session;
+
+    TestSession::current = &first_session;
+    TestScopedClass* first = injector->Get<TestScopedClass*>();
+    EXPECT_EQ(first, injector->Get<TestScopedClass*>());
+
+    TestSession::current = &second_session;
+    TestScopedClass* second = injector->Get<TestScopedClass*>();
+    EXPECT_NE(first, second);
+    injector->Get<At<TestLabelOne, TestScopedClass*> >();
+
+    // Two bindings use slot indices 0 and 1.
+    EXPECT_EQ(2U, first_session.size());
+    EXPECT_EQ(3, TestScopedClass::num_alive);
+    TestSession::current = NULL;
+  }
+
+  EXPECT_EQ(0, TestScopedClass::num_alive);
+}
+
+}  // namespace guicpp
@@ -18,10 +18,13 @@
 #include "guicpp/guicpp_singleton.h"
 
 #include <string>
+#include <vector>
 
 #include "include/gmock/gmock.h"
 #include "include/gtest/gtest.h"
 #include "guicpp/internal/guicpp_port.h"
+#include "guicpp/guicpp_annotations.h"
+#include "guicpp/guicpp_at.h"
 #include "guicpp/guicpp_binder.h"
 #include "guicpp/guicpp_injector.h"
 #include "guicpp/guicpp_module.h"
@@ -32,6 +35,8 @@ namespace guicpp {
 using guicpp_test::TestBaseClass;
 using guicpp_test::TestClassWithDeleteMarker;
 using guicpp_test::TestDeleteMarker;
+using guicpp_test::TestLabelOne;
+using guicpp_test::TestSimpleInjectableClass;
 using testing::_;
 using testing::InSequence;
 using testing::MockFunction;
@@ -49,7 +54,8 @@ GUICPP_DEFINE(TestUnexpectedCreation);
 
 TEST(GuicppSingletonTest, ObjectNotCreatedUntilItIsRequested) {
   internal::ScopeSetupContext context;
-  internal::LazySingletonProvider<TestUnexpectedCreation> singleton(&context);
+  internal::LazySingletonProvider<TestUnexpectedCreation> singleton;
+  singleton.AttachToContext(&context);
 
   scoped_ptr<Injector> injector(guicpp_test::GetEmptyInjector());
   context.Init(injector.get());
@@ -59,8 +65,8 @@ TEST(GuicppSingletonTest, ObjectNotCreatedUntilItIsRequested) {
 
 TEST(GuicppSingletonTest, ReturnsSameObjectEverytime) {
   internal::ScopeSetupContext context;
-  internal::LazySingletonProvider<TestClassWithDeleteMarker>
-      singleton(&context);
+  internal::LazySingletonProvider<TestClassWithDeleteMarker> singleton;
+  singleton.AttachToContext(&context);
 
   scoped_ptr<Injector> injector(guicpp_test::GetEmptyInjector());
   context.Init(injector.get());
@@ -77,8 +83,8 @@ TEST(GuicppSingletonTest, ReturnsSameObjectEverytime) {
 
 TEST(GuicppSingletonTest, DeletesCreatedObjectOnCleanup) {
   internal::ScopeSetupContext context;
-  internal::LazySingletonProvider<TestClassWithDeleteMarker>
-      singleton(&context);
+  internal::LazySingletonProvider<TestClassWithDeleteMarker> singleton;
+  singleton.AttachToContext(&context);
 
   scoped_ptr<Injector> injector(guicpp_test::GetEmptyInjector());
   context.Init(injector.get());
@@ -234,6 +240,30 @@ TEST(GuicppSingletonTest, BindingToSingletonScopeWillReturnSameObject) {
   EXPECT_EQ(object1, object3);
 }
 
+TEST(GuicppSingletonTest, GetSingletonCreationStats_ReportsEachSingleton) {
+  TestLazySingletonModule module;
+  scoped_ptr<Injector> injector(guicpp::CreateInjector(&module));
+
+  std::vector<SingletonCreationStats> stats =
+      GetSingletonCreationStats(injector.get());
+  ASSERT_EQ(1, stats.size());
+  EXPECT_EQ((internal::InjectorUtil::GetBindId<
+                internal::Annotations<>, TestClassWithDeleteMarker*>()),
+            stats[0].bind_id);
+  EXPECT_FALSE(stats[0].is_created);
+
+  injector->Get<TestClassWithDeleteMarker*>();
+  injector->Get<TestClassWithDeleteMarker*>();
+
+  // The instance is created by the first request; No request waited for it.
+  stats = GetSingletonCreationStats(injector.get());
+  ASSERT_EQ(1, stats.size());
+  EXPECT_TRUE(stats[0].is_created);
+  EXPECT_EQ(0, stats[0].num_waiters);
+  EXPECT_EQ(0, stats[0].wait_nanos);
+  EXPECT_EQ(0, stats[0].num_fallbacks);
+}
+
 TEST(GuicppSingletonTest, SingletonObjectsAreDeletedWithInjector) {
   TestLazySingletonModule module;
   // Note: we must use guicpp::CreateInjector() for binding to
@@ -299,4 +329,137 @@ TEST(GuicppSingletonTest, BindingToSingleton_CanBindConstTypes) {
   EXPECT_EQ(object1, object2);
 }
 
+// Counts the calls to the cleanup action.
+class TestCountCleanup {
+ public:
+  explicit TestCountCleanup(int* count): count_(count) {}
+
+  void operator()() {
+    ++*count_;
+  }
+
+ private:
+  int* count_;
+};
+
+// Binds TestClassWithDeleteMarker to ProcessLifetimeSingleton and the same
+// type annotated with TestLabelOne to LazySingleton.
+class TestProcessLifetimeModule: public Module {
+ public:
+  explicit TestProcessLifetimeModule(int* cleanup_count)
+      : cleanup_count_(cleanup_count) {}
+
+  void Configure(Binder* binder) const {
+    binder->BindToScope<TestClassWithDeleteMarker,
+                        ProcessLifetimeSingleton>();
+    binder->BindToScope<At<TestLabelOne, TestClassWithDeleteMarker>,
+                        LazySingleton>();
+    binder->AddCleanupAction(TestCountCleanup(cleanup_count_));
+  }
+
+ private:
+  int* cleanup_count_;
+};
+
+TEST(GuicppSingletonTest, ProcessLifetimeSingletonIsDeletedOnFullTeardown) {
+  int cleanup_count = 0;
+  TestProcessLifetimeModule module(&cleanup_count);
+  scoped_ptr<Injector> injector(guicpp::CreateInjector(&module));
+
+  TestClassWithDeleteMarker* object =
+      injector->Get<TestClassWithDeleteMarker*>();
+  EXPECT_EQ(object, injector->Get<TestClassWithDeleteMarker*>());
+
+  TestDeleteMarker delete_marker;
+  EXPECT_CALL(delete_marker, Call(object));
+  object->SetDeleteMarker(&delete_marker);
+
+  injector.reset();
+  EXPECT_EQ(1, cleanup_count);
+}
+
+TEST(GuicppSingletonTest, ProcessLifetimeSingletonIsNotDeletedOnFastTeardown) {
+  int cleanup_count = 0;
+  TestProcessLifetimeModule module(&cleanup_count);
+  scoped_ptr<Injector> injector(
+      guicpp::CreateInjector(&module, FAST_TEARDOWN));
+
+  TestClassWithDeleteMarker* leaked =
+      injector->Get<TestClassWithDeleteMarker*>();
+  TestClassWithDeleteMarker* lazy =
+      injector->Get<At<TestLabelOne, TestClassWithDeleteMarker*> >();
+
+  // Only the LazySingleton instance is deleted, and cleanup actions are
+  // still called.
+  TestDeleteMarker delete_marker;
+  EXPECT_CALL(delete_marker, Call(lazy));
+  leaked->SetDeleteMarker(&delete_marker);
+  lazy->SetDeleteMarker(&delete_marker);
+
+  injector.reset();
+  EXPECT_EQ(1, cleanup_count);
+
+  // Done by the process exit in real use.
+  leaked->SetDeleteMarker(NULL);
+  delete leaked;
+}
+
+// Decorator of a singleton: It does not own the decorated instance.
+class TestSingletonDecoratorClass: public TestSimpleInjectableClass {
+ public:
+  explicit TestSingletonDecoratorClass(TestSimpleInjectableClass* decorated)
+      : decorated_(decorated) {}
+
+  ~TestSingletonDecoratorClass() {
+    ++num_deleted;
+  }
+
+  virtual string GetClassName() const {
+    return "Decorator(" + decorated_->GetClassName() + ")";
+  }
+
+  TestSimpleInjectableClass* decorated() const { return decorated_; }
+
+  static int num_deleted;
+
+ private:
+  TestSimpleInjectableClass* decorated_;
+};
+
+int TestSingletonDecoratorClass::num_deleted = 0;
+
+GUICPP_INJECT_CTOR(TestSingletonDecoratorClass,
+                   (At<Assisted, TestSimpleInjectableClass*> decorated));
+GUICPP_DEFINE(TestSingletonDecoratorClass);
+
+class TestDecoratedLazySingletonModule: public Module {
+ public:
+  void Configure(Binder* binder) const {
+    binder->BindToScope<TestSimpleInjectableClass, LazySingleton>();
+    binder->Decorate<TestSimpleInjectableClass,
+                     TestSingletonDecoratorClass>();
+  }
+};
+
+TEST(GuicppSingletonTest, DecoratorOfSingletonIsCreatedOnce) {
+  TestDecoratedLazySingletonModule module;
+  scoped_ptr<Injector> injector(guicpp::CreateInjector(&module));
+  TestSingletonDecoratorClass::num_deleted = 0;
+
+  TestSimpleInjectableClass* object1 =
+      injector->Get<TestSimpleInjectableClass*>();
+  TestSimpleInjectableClass* object2 =
+      injector->Get<TestSimpleInjectableClass*>();
+  EXPECT_EQ(object1, object2);
+  EXPECT_EQ("Decorator(TestSimpleInjectableClass)", object1->GetClassName());
+
+  // The decorator wraps the singleton, and is owned by the injector.
+  TestSimpleInjectableClass* singleton =
+      static_cast<TestSingletonDecoratorClass*>(object1)->decorated();
+  EXPECT_NE(object1, singleton);
+
+  injector.reset();
+  EXPECT_EQ(1, TestSingletonDecoratorClass::num_deleted);
+}
+
 }  // namespace guicpp
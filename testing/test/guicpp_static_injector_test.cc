@@ -0,0 +1,120 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// Tests for StaticInjector.
+
+#include "guicpp/guicpp_static_injector.h"
+
+#include <string>
+
+#include "include/gmock/gmock.h"
+#include "include/gtest/gtest.h"
+#include "guicpp/internal/guicpp_port.h"
+#include "guicpp/guicpp_macros.h"
+#include "guicpp/guicpp_singleton.h"
+#include "include/guicpp_test_helper.h"
+
+namespace guicpp {
+using guicpp_test::TestBaseClass;
+using guicpp_test::TestInjectableSubClass;
+using guicpp_test::TestLabelOne;
+using guicpp_test::TestSimpleClassUser;
+using guicpp_test::TestSimpleInjectableClass;
+using guicpp_test::TestTopLevelClass;
+
+TEST(GuicppStaticInjectorTest, Get_CreatesUnboundTypeUsingCtor) {
+  typedef StaticInjector<StaticModule<> > Injector;
+
+  scoped_ptr<TestSimpleInjectableClass> object(
+      Injector::Get<TestSimpleInjectableClass*>());
+  EXPECT_EQ("TestSimpleInjectableClass", object->GetClassName());
+
+  // Each call creates a new instance.
+  scoped_ptr<TestSimpleInjectableClass> other_object(
+      Injector::Get<TestSimpleInjectableClass*>());
+  EXPECT_NE(object.get(), other_object.get());
+}
+
+TEST(GuicppStaticInjectorTest, Get_InjectsCtorArguments) {
+  typedef StaticInjector<StaticModule<> > Injector;
+
+  scoped_ptr<TestSimpleClassUser> user(Injector::Get<TestSimpleClassUser*>());
+  ASSERT_TRUE(user->simple_object() != NULL);
+  EXPECT_EQ("TestSimpleInjectableClass",
+            user->simple_object()->GetClassName());
+}
+
+typedef StaticModule<
+    StaticBind<TestBaseClass, TestSimpleInjectableClass>,
+    StaticBind<TestSimpleInjectableClass, TestInjectableSubClass>,
+    StaticBind<At<TestLabelOne, TestBaseClass>, TestSimpleInjectableClass>
+> TestStaticBindModule;
+
+TEST(GuicppStaticInjectorTest, Get_FollowsBindings) {
+  typedef StaticInjector<TestStaticBindModule> Injector;
+
+  // TestBaseClass -> TestSimpleInjectableClass -> TestInjectableSubClass
+  scoped_ptr<TestBaseClass> object(Injector::Get<TestBaseClass*>());
+  EXPECT_EQ("TestInjectableSubClass", object->GetClassName());
+
+  scoped_ptr<const TestSimpleInjectableClass> const_object(
+      Injector::Get<const TestSimpleInjectableClass*>());
+  EXPECT_EQ("TestInjectableSubClass", const_object->GetClassName());
+
+  // Constructor arguments use the same bindings.
+  scoped_ptr<TestSimpleClassUser> user(Injector::Get<TestSimpleClassUser*>());
+  EXPECT_EQ("TestInjectableSubClass", user->simple_object()->GetClassName());
+}
+
+TEST(GuicppStaticInjectorTest, Get_AnnotatedTypeUsesAnnotatedBinding) {
+  typedef StaticInjector<StaticModule<
+      StaticBind<At<TestLabelOne, TestBaseClass>, TestInjectableSubClass>
+  > > Injector;
+
+  scoped_ptr<TestBaseClass> object(
+      Injector::Get<At<TestLabelOne, TestBaseClass*> >());
+  EXPECT_EQ("TestInjectableSubClass", object->GetClassName());
+}
+
+typedef StaticModule<
+    StaticBind<TestBaseClass, TestInjectableSubClass>,
+    StaticScope<TestInjectableSubClass, LazySingleton>
+> TestStaticSingletonModule;
+
+TEST(GuicppStaticInjectorTest, Get_ReturnsSameInstanceForSingleton) {
+  typedef StaticInjector<TestStaticSingletonModule> Injector;
+
+  TestBaseClass* object = Injector::Get<TestBaseClass*>();
+  EXPECT_EQ("TestInjectableSubClass", object->GetClassName());
+  EXPECT_EQ(object, Injector::Get<TestBaseClass*>());
+  EXPECT_EQ(object, Injector::Get<TestInjectableSubClass*>());
+}
+
+TEST(GuicppStaticInjectorTest, Get_UsesBindingsOfNestedModule) {
+  typedef StaticInjector<StaticModule<
+      TestStaticSingletonModule,
+      StaticBind<At<TestLabelOne, TestBaseClass>, TestSimpleInjectableClass>
+  > > Injector;
+
+  TestBaseClass* object = Injector::Get<TestBaseClass*>();
+  EXPECT_EQ(object, Injector::Get<TestBaseClass*>());
+
+  scoped_ptr<TestBaseClass> labelled_object(
+      Injector::Get<At<TestLabelOne, TestBaseClass*> >());
+  EXPECT_EQ("TestSimpleInjectableClass", labelled_object->GetClassName());
+}
+
+}  // namespace guicpp
@@ -119,6 +119,227 @@ TEST(BindTableTest, FindEntry_ReturnsEntryForTypeIdAndNullIfNoEntryFound) {
   delete bind_table;
 }
 
+// Repeated lookups may be served by the lookup cache (if enabled); They must
+// still see the entries added after the lookup and must not see entries of
+// other tables.
+TEST(BindTableTest, FindEntry_SeesEntriesAddedAfterLookup) {
+  TestDeleteMarker delete_marker;
+  EXPECT_CALL(delete_marker, Call(_)).Times(3);
+
+  TypeId id1 = TypeIdProvider<TestTypeIdClass_1>::GetTypeId();
+  TypeId id2 = TypeIdProvider<TestTypeIdClass_2>::GetTypeId();
+
+  scoped_ptr<BindTable> bind_table(new BindTable());
+  const TableEntryBase* entry1 = new DeleteCheckerEntry(&delete_marker);
+  bind_table->AddEntry(id1, entry1);
+
+  EXPECT_EQ(entry1, bind_table->FindEntry(id1));
+  EXPECT_EQ(entry1, bind_table->FindEntry(id1));
+  EXPECT_EQ(NULL, bind_table->FindEntry(id2));
+
+  const TableEntryBase* entry2 = new DeleteCheckerEntry(&delete_marker);
+  bind_table->AddEntry(id2, entry2);
+  EXPECT_EQ(entry2, bind_table->FindEntry(id2));
+  EXPECT_EQ(entry1, bind_table->FindEntry(id1));
+
+  scoped_ptr<BindTable> other_table(new BindTable());
+  EXPECT_EQ(NULL, other_table->FindEntry(id1));
+
+  const TableEntryBase* entry3 = new DeleteCheckerEntry(&delete_marker);
+  other_table->AddEntry(id1, entry3);
+  EXPECT_EQ(entry3, other_table->FindEntry(id1));
+  EXPECT_EQ(entry1, bind_table->FindEntry(id1));
+}
+
+// Lookups made while binding do not merge the pending entries; Hence a
+// duplicate of a looked up entry is still detected only by MergeEntries().
+TEST(BindTableTest, FindEntry_WhileBindingFindsPendingEntriesWithoutMerging) {
+  TestDeleteMarker delete_marker;
+  const int kNumEntries = 200;
+  EXPECT_CALL(delete_marker, Call(_)).Times(kNumEntries + 1);
+
+  // Addresses in an array serve as TypeIds; Enough of them to grow the
+  // index of pending entries a few times.
+  char type_ids[kNumEntries];
+  vector<const TableEntryBase*> entries;
+
+  BindTable bind_table;
+  for (int i = 0; i < kNumEntries; ++i) {
+    entries.push_back(new DeleteCheckerEntry(&delete_marker));
+    EXPECT_TRUE(bind_table.AddEntry(&type_ids[i], entries.back()));
+    EXPECT_EQ(entries.back(), bind_table.FindEntry(&type_ids[i]));
+  }
+
+  EXPECT_TRUE(bind_table.AddEntry(
+      &type_ids[0], new DeleteCheckerEntry(&delete_marker)));
+  for (int i = 0; i < kNumEntries; ++i) {
+    EXPECT_EQ(entries[i], bind_table.FindEntry(&type_ids[i]));
+  }
+
+  EXPECT_EQ(1, bind_table.MergeEntries());
+  EXPECT_EQ(entries[0], bind_table.FindEntry(&type_ids[0]));
+}
+
+TEST(BindTableTest, FindAddedEntry_DoesNotMergeOrCountLookups) {
+  TestDeleteMarker delete_marker;
+  EXPECT_CALL(delete_marker, Call(_)).Times(3);
+
+  TypeId id1 = TypeIdProvider<TestTypeIdClass_1>::GetTypeId();
+  TypeId id2 = TypeIdProvider<TestTypeIdClass_2>::GetTypeId();
+  TypeId id3 = TypeIdProvider<TestTypeIdClass_3>::GetTypeId();
+
+  BindTable bind_table;
+  bind_table.EnableLookupCounters();
+  const TableEntryBase* entry1 = new DeleteCheckerEntry(&delete_marker);
+  bind_table.AddEntry(id1, entry1);
+  bind_table.MergeEntries();
+
+  // Pending entry and its duplicate; The first one added is returned.
+  const TableEntryBase* entry2 = new DeleteCheckerEntry(&delete_marker);
+  bind_table.AddEntry(id2, entry2);
+  bind_table.AddEntry(id2, new DeleteCheckerEntry(&delete_marker));
+
+  EXPECT_EQ(entry1, bind_table.FindAddedEntry(id1));
+  EXPECT_EQ(entry2, bind_table.FindAddedEntry(id2));
+  EXPECT_EQ(NULL, bind_table.FindAddedEntry(id3));
+
+  // The duplicate is found only when the entries are merged.
+  EXPECT_EQ(1, bind_table.MergeEntries());
+  EXPECT_EQ(2, bind_table.UsageReport(2).unused_bindings.size());
+}
+
+// Adds "entry" for "bind_id" when installed, and counts the installations.
+class TestDeferredInstaller: public DeferredInstaller {
+ public:
+  TestDeferredInstaller(TypeId bind_id, const TableEntryBase* entry,
+                        int* num_installs)
+      : bind_id_(bind_id), entry_(entry), num_installs_(num_installs) {}
+
+  virtual void Install(BindTable* bind_table) const {
+    ++*num_installs_;
+    bind_table->AddEntry(bind_id_, entry_);
+  }
+
+ private:
+  const TypeId bind_id_;
+  const TableEntryBase* const entry_;
+  int* const num_installs_;
+};
+
+// Once the table is shared, an installation publishes a new snapshot; The
+// entries and lookup counts of the replaced one are carried over.
+TEST(BindTableTest, FindEntry_SharedTableInstallsDeferredModuleOnce) {
+  TestDeleteMarker delete_marker;
+  EXPECT_CALL(delete_marker, Call(_)).Times(2);
+
+  TypeId id1 = TypeIdProvider<TestTypeIdClass_1>::GetTypeId();
+  TypeId id2 = TypeIdProvider<TestTypeIdClass_2>::GetTypeId();
+  TypeId id3 = TypeIdProvider<TestTypeIdClass_3>::GetTypeId();
+
+  BindTable bind_table;
+  bind_table.EnableLookupCounters();
+  const TableEntryBase* entry1 = new DeleteCheckerEntry(&delete_marker);
+  bind_table.AddEntry(id1, entry1);
+
+  int num_installs = 0;
+  const TableEntryBase* entry2 = new DeleteCheckerEntry(&delete_marker);
+  bind_table.AddDeferredInstaller(
+      vector<TypeId>(1, id2),
+      new TestDeferredInstaller(id2, entry2, &num_installs));
+  EXPECT_EQ(0, bind_table.MergeEntries());
+  bind_table.SetShared();
+
+  EXPECT_EQ(entry1, bind_table.FindEntry(id1));
+  EXPECT_EQ(entry1, bind_table.FindEntry(id1));
+  EXPECT_EQ(NULL, bind_table.FindEntry(id3));
+  EXPECT_EQ(0, num_installs);
+
+  EXPECT_EQ(entry2, bind_table.FindEntry(id2));
+  EXPECT_EQ(entry2, bind_table.FindEntry(id2));
+  EXPECT_EQ(1, num_installs);
+
+  EXPECT_EQ(entry1, bind_table.FindEntry(id1));
+  BindTableUsageReport report = bind_table.UsageReport(2);
+  ASSERT_EQ(2, report.hot_bindings.size());
+  EXPECT_EQ(id1, report.hot_bindings[0].bind_id);
+  EXPECT_EQ(3, report.hot_bindings[0].num_lookups);
+  EXPECT_EQ(2, report.hot_bindings[1].num_lookups);
+}
+
+#ifdef GUICPP_ENABLE_LOOKUP_CACHE
+// The lookup cache is used only once the table is shared; Misses are cached
+// too.
+TEST(BindTableTest, FindEntry_SharedTableServesRepeatedLookupsFromCache) {
+  TestDeleteMarker delete_marker;
+  EXPECT_CALL(delete_marker, Call(_)).Times(1);
+
+  TypeId id1 = TypeIdProvider<TestTypeIdClass_1>::GetTypeId();
+  TypeId id2 = TypeIdProvider<TestTypeIdClass_2>::GetTypeId();
+
+  BindTable bind_table;
+  const TableEntryBase* entry1 = new DeleteCheckerEntry(&delete_marker);
+  bind_table.AddEntry(id1, entry1);
+  EXPECT_EQ(0, bind_table.MergeEntries());
+
+  uint64 num_hits = BindTable::GetNumLookupCacheHits();
+  EXPECT_EQ(entry1, bind_table.FindEntry(id1));
+  EXPECT_EQ(entry1, bind_table.FindEntry(id1));
+  EXPECT_EQ(num_hits, BindTable::GetNumLookupCacheHits());
+
+  bind_table.SetShared();
+  EXPECT_EQ(entry1, bind_table.FindEntry(id1));
+  EXPECT_EQ(NULL, bind_table.FindEntry(id2));
+  EXPECT_EQ(num_hits, BindTable::GetNumLookupCacheHits());
+
+  EXPECT_EQ(entry1, bind_table.FindEntry(id1));
+  EXPECT_EQ(NULL, bind_table.FindEntry(id2));
+  EXPECT_EQ(num_hits + 2, BindTable::GetNumLookupCacheHits());
+}
+
+// A deferred install publishes a new snapshot, which changes the generation;
+// Results cached for the replaced snapshot are not used again. Otherwise the
+// lookups would be counted in the replaced snapshot.
+TEST(BindTableTest, FindEntry_DeferredInstallInvalidatesCachedLookups) {
+  TestDeleteMarker delete_marker;
+  EXPECT_CALL(delete_marker, Call(_)).Times(2);
+
+  TypeId id1 = TypeIdProvider<TestTypeIdClass_1>::GetTypeId();
+  TypeId id2 = TypeIdProvider<TestTypeIdClass_2>::GetTypeId();
+
+  BindTable bind_table;
+  bind_table.EnableLookupCounters();
+  const TableEntryBase* entry1 = new DeleteCheckerEntry(&delete_marker);
+  bind_table.AddEntry(id1, entry1);
+
+  int num_installs = 0;
+  const TableEntryBase* entry2 = new DeleteCheckerEntry(&delete_marker);
+  bind_table.AddDeferredInstaller(
+      vector<TypeId>(1, id2),
+      new TestDeferredInstaller(id2, entry2, &num_installs));
+  EXPECT_EQ(0, bind_table.MergeEntries());
+  bind_table.SetShared();
+
+  EXPECT_EQ(entry1, bind_table.FindEntry(id1));
+  uint64 num_hits = BindTable::GetNumLookupCacheHits();
+  EXPECT_EQ(entry1, bind_table.FindEntry(id1));
+  EXPECT_EQ(num_hits + 1, BindTable::GetNumLookupCacheHits());
+
+  EXPECT_EQ(entry2, bind_table.FindEntry(id2));
+  EXPECT_EQ(1, num_installs);
+
+  num_hits = BindTable::GetNumLookupCacheHits();
+  EXPECT_EQ(entry1, bind_table.FindEntry(id1));
+  EXPECT_EQ(num_hits, BindTable::GetNumLookupCacheHits());
+  EXPECT_EQ(entry1, bind_table.FindEntry(id1));
+  EXPECT_EQ(num_hits + 1, BindTable::GetNumLookupCacheHits());
+
+  BindTableUsageReport report = bind_table.UsageReport(1);
+  ASSERT_EQ(1, report.hot_bindings.size());
+  EXPECT_EQ(id1, report.hot_bindings[0].bind_id);
+  EXPECT_EQ(4, report.hot_bindings[0].num_lookups);
+}
+#endif  // GUICPP_ENABLE_LOOKUP_CACHE
+
 TEST(BindTableTest, EntriesAreDeletedInReverseOrderOfAddition) {
   TestDeleteMarker delete_marker;
   EXPECT_CALL(delete_marker, Call(_)).Times(0);
@@ -158,6 +379,137 @@ TEST(BindTableTest, EntriesAreDeletedInReverseOrderOfAddition) {
   delete bind_table;
 }
 
+// Duplicates among the entries added since the last merge are found when
+// the entries are merged; First added entry is kept.
+TEST(BindTableTest, MergeEntries_CountsDuplicateEntries) {
+  TestDeleteMarker delete_marker;
+  EXPECT_CALL(delete_marker, Call(_)).Times(4);
+
+  BindTable bind_table;
+  TypeId id1 = TypeIdProvider<TestTypeIdClass_1>::GetTypeId();
+  TypeId id2 = TypeIdProvider<TestTypeIdClass_2>::GetTypeId();
+
+  const TableEntryBase* entry1 = new DeleteCheckerEntry(&delete_marker);
+  const TableEntryBase* entry2 = new DeleteCheckerEntry(&delete_marker);
+  EXPECT_TRUE(bind_table.AddEntry(id1, entry1));
+  EXPECT_TRUE(bind_table.AddEntry(id2, entry2));
+  EXPECT_TRUE(bind_table.AddEntry(
+      id1, new DeleteCheckerEntry(&delete_marker)));
+  EXPECT_EQ(1, bind_table.MergeEntries());
+
+  // Merged entries are checked by AddEntry() itself.
+  EXPECT_FALSE(bind_table.AddEntry(
+      id2, new DeleteCheckerEntry(&delete_marker)));
+  EXPECT_EQ(1, bind_table.MergeEntries());
+
+  EXPECT_EQ(entry1, bind_table.FindEntry(id1));
+  EXPECT_EQ(entry2, bind_table.FindEntry(id2));
+}
+
+// Entries created in the arena are destroyed in the same order as the
+// entries allocated using new.
+TEST(BindTableTest, NewEntry_EntriesAreDestroyedInReverseOrderOfAddition) {
+  TestDeleteMarker delete_marker;
+  MockFunction<void(string description)>  checkpoint;
+
+  BindTable* bind_table = new BindTable();
+  const TableEntryBase* entry1 =
+      bind_table->NewEntry<DeleteCheckerEntry>(&delete_marker);
+  const TableEntryBase* entry2 = new DeleteCheckerEntry(&delete_marker);
+  const TableEntryBase* entry3 =
+      bind_table->NewEntry<DeleteCheckerEntry>(&delete_marker);
+
+  {
+    InSequence sequence;
+
+    EXPECT_CALL(checkpoint, Call("begin cleanup"));
+    EXPECT_CALL(delete_marker, Call(entry3));
+    EXPECT_CALL(delete_marker, Call(entry2));
+    EXPECT_CALL(delete_marker, Call(entry1));
+  }
+
+  bind_table->AddEntry(TypeIdProvider<TestTypeIdClass_1>::GetTypeId(), entry1);
+  bind_table->AddEntry(TypeIdProvider<TestTypeIdClass_2>::GetTypeId(), entry2);
+  bind_table->AddToCleanupList(entry3);
+
+  checkpoint.Call("begin cleanup");
+  delete bind_table;
+}
+
+TEST(BindTableTest, MemoryStats_CountsEntriesCreatedInArena) {
+  TestDeleteMarker delete_marker;
+  EXPECT_CALL(delete_marker, Call(_)).Times(3);
+
+  BindTable bind_table;
+  bind_table.AddEntry(TypeIdProvider<TestTypeIdClass_1>::GetTypeId(),
+                      bind_table.NewEntry<DeleteCheckerEntry>(&delete_marker));
+  bind_table.AddEntry(TypeIdProvider<TestTypeIdClass_2>::GetTypeId(),
+                      bind_table.NewEntry<DeleteCheckerEntry>(&delete_marker));
+
+  // Entries allocated using new are not counted.
+  bind_table.AddEntry(TypeIdProvider<TestTypeIdClass_3>::GetTypeId(),
+                      new DeleteCheckerEntry(&delete_marker));
+
+  BindTableMemoryStats stats = bind_table.MemoryStats();
+  EXPECT_EQ(2, stats.num_entries[TableEntryBase::BIND_TO_INSTANCE]);
+  EXPECT_EQ(2 * sizeof(DeleteCheckerEntry),
+            stats.entry_bytes[TableEntryBase::BIND_TO_INSTANCE]);
+  EXPECT_EQ(0, stats.num_entries[TableEntryBase::BIND_TO_VALUE]);
+  EXPECT_LE(2 * sizeof(DeleteCheckerEntry), stats.arena_bytes);
+}
+
+TEST(BindTableTest, UsageReport_IsEmptyUnlessLookupCountersAreEnabled) {
+  TestDeleteMarker delete_marker;
+  EXPECT_CALL(delete_marker, Call(_)).Times(1);
+
+  BindTable bind_table;
+  bind_table.AddEntry(TypeIdProvider<TestTypeIdClass_1>::GetTypeId(),
+                      new DeleteCheckerEntry(&delete_marker));
+  bind_table.MergeEntries();
+
+  BindTableUsageReport report = bind_table.UsageReport(10);
+  EXPECT_FALSE(report.is_enabled);
+  EXPECT_TRUE(report.unused_bindings.empty());
+  EXPECT_TRUE(report.hot_bindings.empty());
+}
+
+// Counts are kept when more entries are merged after the lookups.
+TEST(BindTableTest, UsageReport_ListsUnusedAndMostLookedUpBindings) {
+  TestDeleteMarker delete_marker;
+  EXPECT_CALL(delete_marker, Call(_)).Times(3);
+
+  TypeId id1 = TypeIdProvider<TestTypeIdClass_1>::GetTypeId();
+  TypeId id2 = TypeIdProvider<TestTypeIdClass_2>::GetTypeId();
+  TypeId id3 = TypeIdProvider<TestTypeIdClass_3>::GetTypeId();
+
+  BindTable bind_table;
+  bind_table.EnableLookupCounters();
+  bind_table.AddEntry(id1, new DeleteCheckerEntry(&delete_marker));
+  bind_table.AddEntry(id2, new DeleteCheckerEntry(&delete_marker));
+  bind_table.MergeEntries();
+
+  bind_table.FindEntry(id1);
+  bind_table.FindEntry(id2);
+  bind_table.FindEntry(id2);
+
+  bind_table.AddEntry(id3, new DeleteCheckerEntry(&delete_marker));
+  bind_table.MergeEntries();
+  bind_table.FindEntry(id2);
+
+  BindTableUsageReport report = bind_table.UsageReport(1);
+  EXPECT_TRUE(report.is_enabled);
+
+  ASSERT_EQ(1, report.unused_bindings.size());
+  EXPECT_EQ(id3, report.unused_bindings[0].bind_id);
+  EXPECT_EQ(TableEntryBase::BIND_TO_INSTANCE,
+            report.unused_bindings[0].bind_type);
+
+  // Only the most looked up binding is listed.
+  ASSERT_EQ(1, report.hot_bindings.size());
+  EXPECT_EQ(id2, report.hot_bindings[0].bind_id);
+  EXPECT_EQ(3, report.hot_bindings[0].num_lookups);
+}
+
 // Tests for Bind overriding in BindTable.
 TEST(BindTableTest, AddEntry_FailsForDuplicateEntry) {
   TestDeleteMarker delete_marker;
@@ -182,6 +534,7 @@ TEST(BindTableTest, AddEntry_FailsForDuplicateEntry) {
 
   TypeId tid = TypeIdProvider<TestTypeIdClass_1>::GetTypeId();
   bind_table->AddEntry(tid, entry1);
+  bind_table->MergeEntries();
   EXPECT_EQ(entry1, bind_table->FindEntry(tid));
 
   // Attempt to override with override flag set to false will fail.
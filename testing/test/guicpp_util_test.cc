@@ -178,6 +178,23 @@ TEST(AtUtilTest, GetTypes_IdentifiesActualTypeAndAnnotationsCorrectly) {
                EmptyAnnotations>::value));
 }
 
+TEST(AtUtilTest, GetTypes_IdentifiesTypesOfAnnotatedArgument) {
+  EXPECT_TRUE((guicpp::internal::is_same<
+               AtUtil::GetTypes<At<TestAnnotation1, const int*> >::ArgType,
+               const int*>::value));
+  EXPECT_TRUE((guicpp::internal::is_same<
+               AtUtil::GetTypes<At<TestAnnotation1, int* const> >::ActualType,
+               int*>::value));
+
+  EXPECT_TRUE((guicpp::internal::is_same<
+               AtUtil::GetTypes<At<TestAnnotation1, int> >::Annotations,
+               Annotations<TestAnnotation1> >::value));
+  EXPECT_TRUE((guicpp::internal::is_same<
+               AtUtil::GetTypes<
+                   At<TestAnnotation1, TestAnnotation4, int> >::Annotations,
+               Annotations<TestAnnotation1, TestAnnotation4> >::value));
+}
+
 TEST(AtUtilTest, GetAt_GetsAnnotationType) {
   typedef Annotations<TestAnnotation1, TestAnnotation4> TestAnnotations;
 
@@ -0,0 +1,161 @@
+// Copyright 2014 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Tests for WarmUpSingleton and WarmUpHandle.
+
+#include "guicpp/guicpp_warm_up_singleton.h"
+
+#include <vector>
+
+#include "include/gmock/gmock.h"
+#include "include/gtest/gtest.h"
+#include "guicpp/internal/guicpp_port.h"
+#include "guicpp/guicpp_binder.h"
+#include "guicpp/guicpp_executor.h"
+#include "guicpp/guicpp_injector.h"
+#include "guicpp/guicpp_module.h"
+#include "include/guicpp_test_helper.h"
+#include "guicpp/guicpp_tools.h"
+
+namespace guicpp {
+using guicpp_test::TestLabelOne;
+
+// Counts the instances created.
+class TestWarmedUpClass {
+ public:
+  TestWarmedUpClass() {
+    ++num_created;
+  }
+
+  static int num_created;
+};
+
+int TestWarmedUpClass::num_created = 0;
+
+GUICPP_INJECT_CTOR(TestWarmedUpClass, ());
+GUICPP_DEFINE(TestWarmedUpClass);
+
+class TestWarmUpModule: public Module {
+ public:
+  void Configure(Binder* binder) const {
+    binder->BindToScope<At<TestLabelOne, TestWarmedUpClass>,
+                        WarmUpSingleton>();
+  }
+};
+
+// Executor that queues the closures until RunAll() is called.
+class TestQueueExecutor: public Executor {
+ public:
+  TestQueueExecutor() {}
+
+  ~TestQueueExecutor() {
+    EXPECT_TRUE(closures_.empty()) << "Closures are never run";
+  }
+
+  void Schedule(Closure* closure) {
+    closures_.push_back(closure);
+  }
+
+  void RunAll() {
+    for (size_t i = 0; i < closures_.size(); ++i) {
+      closures_[i]->Run();
+      delete closures_[i];
+    }
+
+    closures_.clear();
+  }
+
+ private:
+  std::vector<Closure*> closures_;
+};
+
+class TestWarmUpWithExecutorModule: public Module {
+ public:
+  explicit TestWarmUpWithExecutorModule(TestQueueExecutor* executor)
+      : executor_(executor) {}
+
+  void Configure(Binder* binder) const {
+    binder->BindToInstance<At<WarmUpExecutor, Executor> >(
+        executor_, DoNothing());
+    binder->Install(&warm_up_module_);
+  }
+
+ private:
+  TestWarmUpModule warm_up_module_;
+  TestQueueExecutor* executor_;
+};
+
+class GuicppWarmUpSingletonTest: public testing::Test {
+ protected:
+  void SetUp() {
+    TestWarmedUpClass::num_created = 0;
+  }
+};
+
+TEST_F(GuicppWarmUpSingletonTest, CreatesInstanceOnWarmUpExecutor) {
+  TestQueueExecutor executor;
+  TestWarmUpWithExecutorModule module(&executor);
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+  EXPECT_EQ(0, TestWarmedUpClass::num_created);
+
+  executor.RunAll();
+  EXPECT_EQ(1, TestWarmedUpClass::num_created);
+
+  WarmUpHandle<TestWarmedUpClass>* handle =
+      injector->Get<At<TestLabelOne, WarmUpHandle<TestWarmedUpClass>*> >();
+  typedef At<TestLabelOne, TestWarmedUpClass*> ObjectType;
+  EXPECT_EQ(injector->Get<ObjectType>(), handle->TryGet());
+  EXPECT_EQ(1, TestWarmedUpClass::num_created);
+}
+
+TEST_F(GuicppWarmUpSingletonTest, TryGetFallsBackUntilInstanceIsCreated) {
+  TestQueueExecutor executor;
+  TestWarmUpWithExecutorModule module(&executor);
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+
+  WarmUpHandle<TestWarmedUpClass>* handle =
+      injector->Get<At<TestLabelOne, WarmUpHandle<TestWarmedUpClass>*> >();
+  EXPECT_TRUE(handle->TryGet() == NULL);
+  EXPECT_EQ(0, TestWarmedUpClass::num_created);
+
+  std::vector<SingletonCreationStats> stats =
+      GetSingletonCreationStats(injector.get());
+  ASSERT_EQ(1, stats.size());
+  EXPECT_FALSE(stats[0].is_created);
+  EXPECT_EQ(1, stats[0].num_fallbacks);
+
+  executor.RunAll();
+  EXPECT_TRUE(handle->TryGet() != NULL);
+
+  stats = GetSingletonCreationStats(injector.get());
+  EXPECT_TRUE(stats[0].is_created);
+  EXPECT_EQ(1, stats[0].num_fallbacks);
+}
+
+TEST_F(GuicppWarmUpSingletonTest, TryGetCreatesInstanceWithoutExecutor) {
+  TestWarmUpModule module;
+  scoped_ptr<Injector> injector(CreateInjector(&module));
+  EXPECT_EQ(0, TestWarmedUpClass::num_created);
+
+  WarmUpHandle<TestWarmedUpClass>* handle =
+      injector->Get<At<TestLabelOne, WarmUpHandle<TestWarmedUpClass>*> >();
+  TestWarmedUpClass* object = handle->TryGet();
+  EXPECT_TRUE(object != NULL);
+  typedef At<TestLabelOne, TestWarmedUpClass*> ObjectType;
+  EXPECT_EQ(object, injector->Get<ObjectType>());
+  EXPECT_EQ(1, TestWarmedUpClass::num_created);
+}
+
+}  // namespace guicpp